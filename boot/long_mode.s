@@ -143,14 +143,7 @@ align 64
     db 00000000b ; Flags + Segment limit (bit 16 - 19)
     db 0x00      ; Segment base (bit 24 - 31)
 
-.seg_ring_3_code:
-    dw 0x0000    ; Segment limit (bit 0 - 15)
-    dw 0x0000    ; Segment base  (bit 0 - 15)
-    db 0x00    ; Segment base  (bit 16 - 23)
-    db 11111010b ; Access Byte
-    db 10101111b ; Flags + Segment limit (bit 16 - 19)
-    db 0x00      ; Segment base (bit 24 - 31)
-
+; The ring 3 data segment must be right before the ring 3 code segment for SYSRET
 .seg_ring_3_data:
     dw 0x0000    ; Segment limit (bit 0 - 15)
     dw 0x0000    ; Segment base  (bit 0 - 15)
@@ -159,6 +152,14 @@ align 64
     db 00000000b ; Flags + Segment limit (bit 16 - 19)
     db 0x00      ; Segment base (bit 24 - 31)
 
+.seg_ring_3_code:
+    dw 0x0000    ; Segment limit (bit 0 - 15)
+    dw 0x0000    ; Segment base  (bit 0 - 15)
+    db 0x00    ; Segment base  (bit 16 - 23)
+    db 11111010b ; Access Byte
+    db 10101111b ; Flags + Segment limit (bit 16 - 19)
+    db 0x00      ; Segment base (bit 24 - 31)
+
 .seg_tss:
     dw tss64_end - tss64 ; Segment limit (bit 0 - 15)
     dw 0x0000            ; Segment base  (bit 0 - 15)
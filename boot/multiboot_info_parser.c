@@ -1,5 +1,6 @@
 #include "multiboot_info_parser.h"
 
+#include <acpi/tables.h>
 #include <multiboot2.h>
 
 #include "main.h"
@@ -82,6 +83,19 @@ boot_info parse_multiboot_info(uint32_t *multiboot_info_ptr) {
             printf("Multiboot2 framebuffer addr: %x%x, size: %dx%dx%d\n",
                    framebuffer_tag->framebuffer_addr, framebuffer_tag->framebuffer_height,
                    framebuffer_tag->framebuffer_width, framebuffer_tag->framebuffer_bpp);
+        } else if (tag->type == MULTIBOOT_TAG_TYPE_ACPI_OLD ||
+                   tag->type == MULTIBOOT_TAG_TYPE_ACPI_NEW)  // If the tag is an ACPI RSDP tag
+        {
+            acpi_rsdp_t *rsdp = (acpi_rsdp_t *)((struct multiboot_tag_new_acpi *)tag)->rsdp;
+
+            // Save the root tables addresses since the tag won't be mapped in the kernel
+            info.acpi.rsdt_address = rsdp->rsdt_address;
+            if (rsdp->revision >= ACPI_RSDP_REVISION_2) {
+                info.acpi.xsdt_address = rsdp->xsdt_address;
+            }
+
+            printf("Multiboot2 ACPI RSDP: revision = %d, rsdt = 0x%x, xsdt = 0x%lx\n",
+                   rsdp->revision, info.acpi.rsdt_address, info.acpi.xsdt_address);
         }
     }
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdint.h>
+
+#define ACPI_SIGNATURE_SIZE 4
+
+#define ACPI_RSDP_REVISION_1 0
+#define ACPI_RSDP_REVISION_2 2
+
+#define ACPI_MADT_SIGNATURE "APIC"
+#define ACPI_HPET_SIGNATURE "HPET"
+
+#define ACPI_ADDRESS_SPACE_SYSTEM_MEMORY 0
+
+#define ACPI_MADT_FLAGS_PCAT_COMPAT (1 << 0)
+
+#define ACPI_MADT_ENTRY_LOCAL_APIC 0
+#define ACPI_MADT_ENTRY_IO_APIC 1
+#define ACPI_MADT_ENTRY_INTERRUPT_SOURCE_OVERRIDE 2
+#define ACPI_MADT_ENTRY_LOCAL_APIC_ADDRESS_OVERRIDE 5
+
+#define ACPI_MADT_POLARITY_MASK 0b11
+#define ACPI_MADT_POLARITY_ACTIVE_LOW 0b11
+#define ACPI_MADT_TRIGGER_MODE_MASK 0b1100
+#define ACPI_MADT_TRIGGER_MODE_LEVEL 0b1100
+
+typedef struct acpi_rsdp {
+    char signature[8];
+    uint8_t checksum;
+    char oem_id[6];
+    uint8_t revision;
+    uint32_t rsdt_address;
+    uint32_t length;
+    uint64_t xsdt_address;
+    uint8_t extended_checksum;
+    uint8_t reserved[3];
+} __attribute__((packed)) acpi_rsdp_t;
+
+typedef struct acpi_sdt_header {
+    char signature[ACPI_SIGNATURE_SIZE];
+    uint32_t length;
+    uint8_t revision;
+    uint8_t checksum;
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} acpi_sdt_header_t;
+
+typedef struct acpi_madt {
+    acpi_sdt_header_t header;
+    uint32_t local_apic_address;
+    uint32_t flags;
+} acpi_madt_t;
+
+typedef struct acpi_madt_entry_header {
+    uint8_t type;
+    uint8_t length;
+} acpi_madt_entry_header_t;
+
+typedef struct acpi_madt_local_apic {
+    acpi_madt_entry_header_t header;
+    uint8_t processor_id;
+    uint8_t apic_id;
+    uint32_t flags;
+} acpi_madt_local_apic_t;
+
+typedef struct acpi_madt_io_apic {
+    acpi_madt_entry_header_t header;
+    uint8_t io_apic_id;
+    uint8_t reserved;
+    uint32_t io_apic_address;
+    uint32_t global_system_interrupt_base;
+} acpi_madt_io_apic_t;
+
+typedef struct acpi_madt_interrupt_source_override {
+    acpi_madt_entry_header_t header;
+    uint8_t bus;
+    uint8_t source;
+    uint32_t global_system_interrupt;
+    uint16_t flags;
+} __attribute__((packed)) acpi_madt_interrupt_source_override_t;
+
+typedef struct acpi_madt_local_apic_address_override {
+    acpi_madt_entry_header_t header;
+    uint16_t reserved;
+    uint64_t local_apic_address;
+} __attribute__((packed)) acpi_madt_local_apic_address_override_t;
+
+typedef struct acpi_generic_address {
+    uint8_t address_space_id;
+    uint8_t register_bit_width;
+    uint8_t register_bit_offset;
+    uint8_t access_size;
+    uint64_t address;
+} __attribute__((packed)) acpi_generic_address_t;
+
+typedef struct acpi_hpet {
+    acpi_sdt_header_t header;
+    uint32_t event_timer_block_id;
+    acpi_generic_address_t base_address;
+    uint8_t hpet_number;
+    uint16_t minimum_tick;
+    uint8_t page_protection;
+} __attribute__((packed)) acpi_hpet_t;
\ No newline at end of file
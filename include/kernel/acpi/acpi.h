@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+#include <acpi/tables.h>
+#include <sys/boot_info.h>
+
+namespace influx {
+class acpi {
+   public:
+    static void init(const boot_info_acpi &info);
+
+    static const acpi_sdt_header_t *find_table(const char *signature);
+
+   private:
+    inline static const acpi_sdt_header_t *_root_table = nullptr;
+    inline static bool _extended_root_table = false;
+
+    static void *map_physical(uint64_t physical_address, uint64_t size);
+    static void unmap_physical(const void *ptr, uint64_t size);
+    static const acpi_sdt_header_t *map_table(uint64_t physical_address);
+    static bool validate_table(const acpi_sdt_header_t *table);
+};
+};  // namespace influx
\ No newline at end of file
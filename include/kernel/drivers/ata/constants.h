@@ -30,6 +30,8 @@
 #define ATA_PRIMARY_IRQ 14
 #define ATA_SECONDARY_IRQ 15
 
+#define ATA_IRQ_TIMEOUT_MS 5000
+
 #define ATA_STATUS_ERR (1 << 0)
 #define ATA_STATUS_IDX (1 << 1)
 #define ATA_STATUS_CORR (1 << 2)
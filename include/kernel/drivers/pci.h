@@ -11,6 +11,8 @@
 
 #define VENDOR_ID_OFFSET 0x0
 #define DEVICE_ID_OFFSET 0x0
+#define COMMAND_OFFSET 0x4
+#define STATUS_OFFSET 0x6
 #define CLASS_CODE_OFFSET 0x8
 #define SUBCLASS_OFFSET 0x8
 #define PROG_IF_OFFSET 0x8
@@ -21,6 +23,22 @@
 #define BAR3_OFFSET 0x1C
 #define BAR4_OFFSET 0x20
 #define BAR5_OFFSET 0x24
+#define CAPABILITIES_POINTER_OFFSET 0x34
+
+#define COMMAND_INTERRUPT_DISABLE (1 << 10)
+#define STATUS_CAPABILITIES_LIST (1 << 4)
+
+#define CAPABILITY_ID_MSI 0x05
+
+#define MSI_CONTROL_OFFSET 0x2
+#define MSI_ADDRESS_LOW_OFFSET 0x4
+#define MSI_ADDRESS_HIGH_OFFSET 0x8
+#define MSI_DATA_32_OFFSET 0x8
+#define MSI_DATA_64_OFFSET 0xC
+
+#define MSI_CONTROL_ENABLE (1 << 0)
+#define MSI_CONTROL_MULTIPLE_MESSAGE_ENABLE_MASK 0x70
+#define MSI_CONTROL_64_BIT (1 << 7)
 
 #define AMOUNT_OF_BUSES 256
 #define AMOUNT_OF_DEVICES_PER_BUS 32
@@ -47,6 +65,10 @@ class pci : public driver {
 
     const structures::vector<pci_descriptor_t>& descriptors();
 
+    uint8_t find_capability(const pci_descriptor_t& descriptor, uint8_t capability_id);
+    int16_t enable_msi(const pci_descriptor_t& descriptor, uint64_t msi_handler_address,
+                       void* msi_handler_data);
+
    private:
     structures::vector<pci_descriptor_t> _descriptors;
 
@@ -0,0 +1,34 @@
+#pragma once
+#include <kernel/drivers/driver.h>
+
+#include <stdint.h>
+
+#define HPET_CAPABILITIES_REGISTER 0x0
+#define HPET_CONFIGURATION_REGISTER 0x10
+#define HPET_MAIN_COUNTER_REGISTER 0xF0
+
+#define HPET_REGISTERS_SIZE 0x400
+
+#define HPET_CAPABILITIES_64_BIT_COUNTER (1 << 13)
+#define HPET_CAPABILITIES_PERIOD_SHIFT 32
+#define HPET_CONFIGURATION_ENABLE (1 << 0)
+
+#define FEMTOSECONDS_IN_SECOND 1000000000000000
+
+namespace influx {
+namespace drivers {
+class hpet : public driver {
+   public:
+    hpet();
+
+    virtual bool load();
+
+    uint64_t main_counter() const;
+    inline uint64_t frequency() const { return _frequency; }
+
+   private:
+    volatile uint64_t *_registers;
+    uint64_t _frequency;
+};
+};  // namespace drivers
+};  // namespace influx
\ No newline at end of file
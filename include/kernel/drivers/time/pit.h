@@ -27,7 +27,7 @@ class pit : public timer_driver {
     virtual uint64_t timer_frequency() const { return PIT_FREQUENCY; }
 
    private:
-    uint64_t _count;
+    volatile uint64_t _count;
 
     friend void pit_irq(pit *pit);
 };
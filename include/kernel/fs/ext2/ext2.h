@@ -10,6 +10,7 @@
 #include <kernel/structures/pair.h>
 #include <kernel/structures/vector.h>
 #include <kernel/threading/mutex.h>
+#include <kernel/threading/shared_mutex.h>
 #include <kernel/vfs/file_permissions.h>
 #include <kernel/vfs/file_type.h>
 
@@ -38,9 +39,15 @@ class ext2 : public vfs::filesystem {
 
     virtual bool mount(const vfs::path& mount_path);
     virtual vfs::error read(void* fs_file_info, char* buffer, size_t count, size_t offset,
-                            size_t& amount_read);
+                            size_t& amount_read, vfs::open_flags flags);
     virtual vfs::error write(void* fs_file_info, const char* buffer, size_t count, size_t offset,
-                             size_t& amount_written);
+                             size_t& amount_written, vfs::open_flags flags);
+    virtual vfs::error readv(void* fs_file_info, const vfs::io_vector* vectors,
+                             size_t vector_count, size_t count, size_t offset,
+                             size_t& amount_read, vfs::open_flags flags);
+    virtual vfs::error writev(void* fs_file_info, const vfs::io_vector* vectors,
+                              size_t vector_count, size_t count, size_t offset,
+                              size_t& amount_written, vfs::open_flags flags);
     virtual vfs::error get_file_info(void* fs_file_info, vfs::file_info& file);
     virtual vfs::error read_dir_entries(void* fs_file_info, size_t offset,
                                         structures::vector<vfs::dir_entry>& entries,
@@ -49,11 +56,15 @@ class ext2 : public vfs::filesystem {
                                    void** fs_file_info_ptr);
     virtual vfs::error create_dir(const vfs::path& dir_path, vfs::file_permissions permissions,
                                   void** fs_file_info_ptr);
-    inline virtual void duplicate_open_file(const vfs::open_file& file, void* fs_file_info){};
     inline virtual void close_open_file(const vfs::open_file& file, void* fs_file_info){};
     virtual vfs::error unlink_file(const vfs::path& file_path);
     virtual void* get_fs_file_data(const vfs::path& file_path);
+    virtual void* get_root_fs_file_data();
+    virtual void* lookup_fs_file_data(void* dir_fs_file_data, const structures::string& name);
+    virtual void* duplicate_fs_file_data(void* fs_file_data);
     virtual bool compare_fs_file_data(void* fs_file_data_1, void* fs_file_data_2);
+    virtual uint64_t fs_file_data_key(void* fs_file_data);
+    inline virtual bool cacheable() const { return true; }
 
    private:
     ext2_superblock _sb;
@@ -62,7 +73,7 @@ class ext2 : public vfs::filesystem {
     uint32_t _block_size;
 
     structures::vector<ext2_block_group_desc> _block_groups;
-    structures::vector<threading::mutex> _block_groups_mutexes;
+    structures::vector<threading::shared_mutex> _block_groups_mutexes;
 
     threading::mutex _dir_edit_mutex;
 
@@ -72,6 +83,7 @@ class ext2 : public vfs::filesystem {
 
     ext2_inode* get_inode(uint32_t inode);
     uint32_t find_inode(const vfs::path& file_path);
+    uint32_t find_dir_entry_inode(uint32_t dir_inode, const structures::string& name);
 
     uint32_t get_block_for_offset(ext2_inode* inode, uint64_t offset, bool allocate);
     structures::dynamic_buffer read_file(ext2_inode* inode, uint64_t offset, uint64_t amount);
@@ -1,9 +1,14 @@
 #pragma once
+#include <stdint.h>
 
 namespace influx {
 enum class gdt_selector_types {
     null_descriptor = 0x0,
     code_descriptor = 0x8,
-    data_descriptor = 0x10
+    data_descriptor = 0x10,
+    user_data_descriptor = 0x18,
+    user_code_descriptor = 0x20
 };
+
+#define USER_SELECTOR(descriptor) ((uint64_t)(descriptor) | 0b11)
 };
\ No newline at end of file
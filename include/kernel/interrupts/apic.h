@@ -0,0 +1,83 @@
+#pragma once
+#include <stdint.h>
+
+#include <acpi/tables.h>
+#include <kernel/logger.h>
+
+#define MSR_IA32_APIC_BASE 0x1B
+#define APIC_BASE_GLOBAL_ENABLE (1 << 11)
+#define APIC_BASE_ADDRESS_MASK 0xFFFFFFFFFF000
+
+#define LAPIC_ID_REGISTER 0x20
+#define LAPIC_TASK_PRIORITY_REGISTER 0x80
+#define LAPIC_EOI_REGISTER 0xB0
+#define LAPIC_SPURIOUS_INTERRUPT_VECTOR_REGISTER 0xF0
+
+#define LAPIC_SOFTWARE_ENABLE (1 << 8)
+#define LAPIC_SPURIOUS_INTERRUPT_VECTOR 0xFF
+
+#define IOAPIC_REGISTER_SELECT 0x0
+#define IOAPIC_REGISTER_WINDOW 0x10
+
+#define IOAPIC_VERSION_REGISTER 0x1
+#define IOAPIC_REDIRECTION_TABLE_REGISTER(n) ((uint8_t)(0x10 + 2 * (n)))
+
+#define IOAPIC_REDIRECTION_ACTIVE_LOW (1 << 13)
+#define IOAPIC_REDIRECTION_LEVEL_TRIGGERED (1 << 15)
+#define IOAPIC_REDIRECTION_MASKED (1 << 16)
+
+#define IOAPIC_MAX_COUNT 8
+#define ISA_IRQ_COUNT 16
+#define ISA_CASCADE_IRQ 2
+
+#define MSI_ADDRESS_BASE 0xFEE00000
+#define MSI_ADDRESS_DESTINATION_SHIFT 12
+
+namespace influx {
+namespace interrupts {
+struct ioapic {
+    volatile uint32_t *registers;
+    uint32_t global_system_interrupt_base;
+    uint32_t redirection_entries;
+};
+
+class apic {
+   public:
+    static bool init();
+
+    inline static bool enabled() { return _enabled; }
+
+    static void send_eoi();
+
+    static bool route_irq(uint8_t irq, uint8_t vector);
+    static void mask_irq(uint8_t irq);
+
+    static uint8_t local_apic_id();
+    static uint64_t msi_address();
+
+   private:
+    inline static bool _enabled = false;
+
+    inline static volatile uint32_t *_local_apic = nullptr;
+
+    inline static ioapic _ioapics[IOAPIC_MAX_COUNT] = {};
+    inline static uint64_t _ioapics_count = 0;
+
+    inline static uint32_t _isa_global_system_interrupts[ISA_IRQ_COUNT] = {0};
+    inline static uint16_t _isa_flags[ISA_IRQ_COUNT] = {0};
+
+    static bool parse_madt(const acpi_madt_t *madt, logger &log);
+    static void init_local_apic();
+    static void init_ioapic(ioapic &io_apic);
+
+    static uint32_t read_local_apic(uint32_t reg);
+    static void write_local_apic(uint32_t reg, uint32_t value);
+
+    static uint32_t read_ioapic(const ioapic &io_apic, uint8_t reg);
+    static void write_ioapic(const ioapic &io_apic, uint8_t reg, uint32_t value);
+
+    static ioapic *get_ioapic(uint32_t global_system_interrupt);
+    static uint32_t get_global_system_interrupt(uint8_t irq, uint32_t &redirection_flags);
+};
+};  // namespace interrupts
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+
+// Adds an entry to the exception table from inline assembly, a page fault in the instruction at
+// the first label continues from the second label instead of crashing the kernel
+#define EXCEPTION_TABLE_ENTRY(fault_label, fixup_label) \
+    ".pushsection __ex_table, \"a\"\n"                  \
+    ".balign 8\n"                                       \
+    ".quad " fault_label ", " fixup_label "\n"          \
+    ".popsection\n"
+
+namespace influx {
+namespace interrupts {
+struct exception_table_entry {
+    uint64_t fault_address;
+    uint64_t fixup_address;
+};
+
+class exception_table {
+   public:
+    static uint64_t find_fixup(uint64_t fault_address);
+};
+};  // namespace interrupts
+};  // namespace influx
\ No newline at end of file
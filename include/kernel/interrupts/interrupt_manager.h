@@ -5,9 +5,8 @@
 #include <kernel/interrupts/interrupt_regs.h>
 #include <kernel/interrupts/interrupt_request.h>
 #include <kernel/logger.h>
-#include <kernel/threading/condition_variable.h>
+#include <kernel/threading/irq_notifier.h>
 #include <kernel/threading/mutex.h>
-#include <kernel/threading/thread.h>
 
 #define AMOUNT_OF_INTERRUPT_DESCRIPTORS 256
 #define IDT_SIZE (sizeof(interrupt_descriptor_t) * AMOUNT_OF_INTERRUPT_DESCRIPTORS)
@@ -17,6 +16,13 @@
 
 #define PIC_INTERRUPT_COUNT 16
 
+#define MSI_INTERRUPTS_OFFSET 48
+#define MSI_INTERRUPT_COUNT 80
+
+#define RFLAGS_INTERRUPT_FLAG (1 << 9)
+
+#define PAGE_FAULT_INTERRUPT 14
+
 namespace influx {
 namespace interrupts {
 enum class interrupt_service_routine_type {
@@ -28,8 +34,12 @@ extern "C" void isr_handler(regs *context);
 
 void exception_interrupt_handler(regs *context);
 
+void page_fault_interrupt_handler(regs *context);
+
 void irq_interrupt_handler(regs *context);
 
+void msi_interrupt_handler(regs *context);
+
 class interrupt_manager {
    public:
     interrupt_manager();
@@ -38,37 +48,43 @@ class interrupt_manager {
     void set_interrupt_privilege_level(uint8_t interrupt_index, uint8_t privilege_level);
 
     void set_irq_handler(uint8_t irq, uint64_t irq_handler_address, void *irq_handler_data);
-    bool wait_for_irq(uint8_t irq, bool interruptible);
+    bool wait_for_irq(uint8_t irq, bool interruptible, uint64_t timeout_ms = IRQ_NO_TIMEOUT);
+    void reset_irq(uint8_t irq);
 
-    void start_irq_notify_thread();
+    int16_t allocate_msi_vector(uint64_t msi_handler_address, void *msi_handler_data);
+    void free_msi_vector(uint8_t vector);
 
     void enable_interrupts() const;
     void disable_interrupts() const;
+    bool interrupts_enabled() const;
 
    private:
     logger _log;
 
     interrupt_descriptor_t *_idt;
 
-    threading::tcb *_irq_notify_task;
     interrupt_request _irq_handlers[PIC_INTERRUPT_COUNT] = {0};
-    uint64_t _irq_call_count[PIC_INTERRUPT_COUNT] = {0};
-    uint32_t _irq_call_count_changed;
-    threading::mutex _irq_mutexes[PIC_INTERRUPT_COUNT];
-    threading::condition_variable _irq_cvs[PIC_INTERRUPT_COUNT];
+    threading::irq_notifier _irq_notifiers[PIC_INTERRUPT_COUNT];
+
+    interrupt_request _msi_handlers[MSI_INTERRUPT_COUNT] = {};
+    threading::mutex _msi_mutex;
 
     void init_isrs();
     void set_isr(uint8_t interrupt_index, uint64_t isr, interrupt_service_routine_type type);
 
     void load_idt();
     void remap_pic_interrupts();
+    void mask_pic_interrupts();
+    void route_apic_interrupts();
+
+    static void send_irq_eoi(uint8_t irq);
 
     void register_exception_interrupts();
     void register_pic_interrupts();
-
-    void irq_notify_thread();
+    void register_msi_interrupts();
 
     friend void irq_interrupt_handler(regs *frame);
+    friend void msi_interrupt_handler(regs *frame);
 };
 };  // namespace interrupts
 };  // namespace influx
\ No newline at end of file
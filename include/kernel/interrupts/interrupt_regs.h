@@ -1,14 +1,9 @@
 #pragma once
 #include <stdint.h>
 
-#define AMOUNT_OF_SSE_REGISTERS 16
-
-typedef double sse_128 __attribute__((vector_size(16)));
-
 namespace influx {
 namespace interrupts {
 struct regs {
-    sse_128 xmm[AMOUNT_OF_SSE_REGISTERS];
     uint64_t rax;
     uint64_t rbx;
     uint64_t rcx;
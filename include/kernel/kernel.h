@@ -2,6 +2,7 @@
 #include <kernel/drivers/driver_manager.h>
 #include <kernel/interrupts/interrupt_manager.h>
 #include <kernel/syscalls/syscall_manager.h>
+#include <kernel/threading/futex_manager.h>
 #include <kernel/threading/scheduler.h>
 #include <kernel/time/time_manager.h>
 #include <kernel/tty/tty_manager.h>
@@ -20,6 +21,7 @@ class kernel {
     inline static drivers::driver_manager *driver_manager() { return _driver_manager; }
     inline static time::time_manager *time_manager() { return _time_manager; }
     inline static threading::scheduler *scheduler() { return _scheduler; }
+    inline static threading::futex_manager *futex_manager() { return _futex_manager; }
     inline static syscalls::syscall_manager *syscall_manager() { return _syscall_manager; }
     inline static vfs::vfs *vfs() { return _vfs; }
     inline static tty::tty_manager *tty_manager() { return _tty_manager; }
@@ -29,6 +31,7 @@ class kernel {
     inline static drivers::driver_manager *_driver_manager = nullptr;
     inline static time::time_manager *_time_manager = nullptr;
     inline static threading::scheduler *_scheduler = nullptr;
+    inline static threading::futex_manager *_futex_manager = nullptr;
     inline static syscalls::syscall_manager *_syscall_manager = nullptr;
     inline static vfs::vfs *_vfs = nullptr;
     inline static tty::tty_manager *_tty_manager = nullptr;
@@ -19,6 +19,8 @@ class utils {
 
     static void memset(void *ptr, uint8_t value, uint64_t amount);
     static void memcpy(void *dst, const void *src, uint64_t amount);
+    static uint64_t memcpy_fault_safe(void *dst, const void *src, uint64_t amount);
+    static int64_t strncpy_fault_safe(char *dst, const char *src, uint64_t size);
     static int memcmp(const void *a, const void *b, uint64_t amount);
 };
 };  // namespace memory
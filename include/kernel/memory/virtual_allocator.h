@@ -33,6 +33,9 @@ class virtual_allocator {
                           int64_t physical_page_index = -1);
     static void free(void *ptr, uint64_t size);
 
+    static void *map_io(uint64_t physical_address, uint64_t size);
+    static void unmap(void *ptr, uint64_t size);
+
    private:
     inline static vma_node_t *_vma_list_head = nullptr;
     inline static buffer_t _current_vma_list_page = {.ptr = nullptr, .size = 0};
@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+#define MSR_EFER 0xC0000080
+#define MSR_STAR 0xC0000081
+#define MSR_LSTAR 0xC0000082
+#define MSR_SFMASK 0xC0000084
+#define MSR_FS_BASE 0xC0000100
+
+#define EFER_SYSCALL_ENABLE (1 << 0)
+
+namespace influx {
+class msr {
+   public:
+    static uint64_t read(uint32_t msr);
+    static void write(uint32_t msr, uint64_t value);
+};
+};  // namespace influx
\ No newline at end of file
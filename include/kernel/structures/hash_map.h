@@ -7,7 +7,7 @@
 #include <stddef.h>
 
 #define DEFAULT_BUCKET_COUNT 16
-#define DEFAULT_MAX_LOAD_FACTOR 1.0f
+#define DEFAULT_MAX_LOAD_FACTOR 100  // Percents
 
 namespace influx {
 namespace structures {
@@ -164,9 +164,10 @@ class hash_map {
         _bucket_count = count;
         rehash();
     };
-    inline float load_factor() const { return _size / _bucket_count; };
-    inline float max_load_factor() const { return _max_load_factor; };
-    inline void max_load_factor(float l) { _max_load_factor = l; };
+    // Note: Non-standard, the load factor is in percents since the kernel doesn't use floats
+    inline size_type load_factor() const { return (_size * 100) / _bucket_count; };
+    inline size_type max_load_factor() const { return _max_load_factor; };
+    inline void max_load_factor(size_type l) { _max_load_factor = l; };
     inline size_type bucket_count() const { return _bucket_count; };
     inline size_type bucket(const Key& key) const { return Hash()(key) % _bucket_count; };
 
@@ -177,7 +178,7 @@ class hash_map {
     size_type _bucket_count;
     memblock _buckets;
     size_type _size;
-    float _max_load_factor;
+    size_type _max_load_factor;
     mapped_type _empty_item;
 
     void rehash();
@@ -280,9 +281,14 @@ void influx::structures::hash_map<Key, T, Hash>::clear() {
             b = b->next();
 
             // Free the current node
-            delete b;
+            delete temp;
         }
+
+        // Mark the bucket as empty
+        ((bucket_type*)_buckets.data())[i] = nullptr;
     }
+
+    _size = 0;
 }
 
 template <class Key, class T, class Hash>
@@ -300,14 +306,19 @@ influx::structures::memblock::size_type influx::structures::hash_map<Key, T, Has
     while (b != nullptr) {
         // If the wanted key was found, erase it
         if (b->value().first == key) {
-            // If it's the first element in the bucket, set the bucket as the next element
+            // If it's the first element in the bucket, set the bucket as the next element,
+            // otherwise detach the node from the previous element
             if (b->prev() == nullptr) {
                 ((bucket_type*)_buckets.data())[bucket_index] = b->next();
-            } else if (b->prev() == nullptr && b->next()) {
-                // Detach the node
+            } else {
                 b->prev()->next() = b->next();
             }
 
+            // Detach the node from the next element
+            if (b->next() != nullptr) {
+                b->next()->prev() = b->prev();
+            }
+
             // Free the element
             delete b;
 
@@ -362,7 +373,7 @@ influx::structures::hash_map<Key, T, Hash>::insert(bucket_element_type* element)
         _size += 1;
 
         // If rehash is needed
-        if ((float)_size > _max_load_factor * (float)_bucket_count) {
+        if (_size * 100 > _max_load_factor * _bucket_count) {
             rehash(_bucket_count * 2);
         }
     }
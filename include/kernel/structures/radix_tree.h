@@ -0,0 +1,237 @@
+#pragma once
+#include <kernel/assert.h>
+#include <kernel/memory/utils.h>
+#include <stdint.h>
+
+#define RADIX_TREE_SHIFT 6
+#define RADIX_TREE_SLOTS (1 << RADIX_TREE_SHIFT)
+#define RADIX_TREE_SLOT_MASK (RADIX_TREE_SLOTS - 1)
+#define RADIX_TREE_MAX_HEIGHT ((64 + RADIX_TREE_SHIFT - 1) / RADIX_TREE_SHIFT)
+
+namespace influx {
+namespace structures {
+struct radix_tree_node {
+    void* slots[RADIX_TREE_SLOTS];
+    uint64_t count;
+};
+
+// The tree doesn't own its items, and copies of it share the same nodes
+template <typename T>
+class radix_tree {
+   public:
+    inline radix_tree() : _root(nullptr), _height(0), _size(0) {}
+
+    T* find(uint64_t index) const;
+    T* find_next(uint64_t& index) const;
+    bool insert(uint64_t index, T* item);
+    T* erase(uint64_t index);
+    void clear();
+
+    inline uint64_t size() const { return _size; }
+    inline bool empty() const { return _size == 0; }
+
+   private:
+    radix_tree_node* _root;
+    uint64_t _height;
+    uint64_t _size;
+
+    inline uint64_t max_index() const {
+        return _height * RADIX_TREE_SHIFT >= 64 ? UINT64_MAX
+                                                : (1ULL << (_height * RADIX_TREE_SHIFT)) - 1;
+    }
+
+    static radix_tree_node* create_node();
+    static void free_node(radix_tree_node* node, uint64_t height);
+    static void* find_next_in_node(radix_tree_node* node, uint64_t height, uint64_t base,
+                                   uint64_t& index);
+};
+};  // namespace structures
+};  // namespace influx
+
+template <typename T>
+T* influx::structures::radix_tree<T>::find(uint64_t index) const {
+    void* slot = _root;
+
+    // Check if the index is covered by the tree
+    if (_root == nullptr || index > max_index()) {
+        return nullptr;
+    }
+
+    // Walk down the levels of the tree
+    for (uint64_t level = _height; level > 0 && slot != nullptr; level--) {
+        slot = ((radix_tree_node*)slot)
+                   ->slots[(index >> ((level - 1) * RADIX_TREE_SHIFT)) & RADIX_TREE_SLOT_MASK];
+    }
+
+    return (T*)slot;
+}
+
+template <typename T>
+T* influx::structures::radix_tree<T>::find_next(uint64_t& index) const {
+    // Check if the index is covered by the tree
+    if (_root == nullptr || index > max_index()) {
+        return nullptr;
+    }
+
+    return (T*)find_next_in_node(_root, _height, 0, index);
+}
+
+template <typename T>
+bool influx::structures::radix_tree<T>::insert(uint64_t index, T* item) {
+    kassert(item != nullptr);
+
+    radix_tree_node *node = nullptr, *child = nullptr;
+    uint64_t offset = 0;
+
+    // Create the root of an empty tree
+    if (_root == nullptr) {
+        _root = create_node();
+        _height = 1;
+    }
+
+    // Grow the tree until it covers the index
+    while (index > max_index()) {
+        node = create_node();
+        node->slots[0] = _root;
+        node->count = 1;
+
+        _root = node;
+        _height++;
+    }
+
+    // Walk down to the leaf node of the index, creating missing nodes on the way
+    node = _root;
+    for (uint64_t level = _height; level > 1; level--) {
+        offset = (index >> ((level - 1) * RADIX_TREE_SHIFT)) & RADIX_TREE_SLOT_MASK;
+        if ((child = (radix_tree_node*)node->slots[offset]) == nullptr) {
+            child = create_node();
+            node->slots[offset] = child;
+            node->count++;
+        }
+
+        node = child;
+    }
+
+    // Check if the index is already taken
+    offset = index & RADIX_TREE_SLOT_MASK;
+    if (node->slots[offset] != nullptr) {
+        return false;
+    }
+
+    // Set the item in the leaf
+    node->slots[offset] = item;
+    node->count++;
+    _size++;
+
+    return true;
+}
+
+template <typename T>
+T* influx::structures::radix_tree<T>::erase(uint64_t index) {
+    radix_tree_node* path[RADIX_TREE_MAX_HEIGHT] = {nullptr};
+    uint64_t offsets[RADIX_TREE_MAX_HEIGHT] = {0};
+    radix_tree_node* node = _root;
+    uint64_t level = 0;
+    T* item = nullptr;
+
+    // Check if the index is covered by the tree
+    if (_root == nullptr || index > max_index()) {
+        return nullptr;
+    }
+
+    // Save the path from the root to the leaf node of the index
+    for (level = _height; level > 0; level--) {
+        path[level - 1] = node;
+        offsets[level - 1] = (index >> ((level - 1) * RADIX_TREE_SHIFT)) & RADIX_TREE_SLOT_MASK;
+
+        if (level > 1 && (node = (radix_tree_node*)node->slots[offsets[level - 1]]) == nullptr) {
+            return nullptr;
+        }
+    }
+
+    // Check if the index has an item
+    if ((item = (T*)path[0]->slots[offsets[0]]) == nullptr) {
+        return nullptr;
+    }
+
+    // Remove the item and free the nodes that became empty
+    path[0]->slots[offsets[0]] = nullptr;
+    for (level = 0; level < _height && --path[level]->count == 0; level++) {
+        delete path[level];
+
+        if (level + 1 < _height) {
+            path[level + 1]->slots[offsets[level + 1]] = nullptr;
+        } else {
+            _root = nullptr;
+            _height = 0;
+        }
+    }
+    _size--;
+
+    return item;
+}
+
+template <typename T>
+void influx::structures::radix_tree<T>::clear() {
+    // Free the nodes of the tree, the items belong to the caller
+    if (_root != nullptr) {
+        free_node(_root, _height);
+    }
+
+    _root = nullptr;
+    _height = 0;
+    _size = 0;
+}
+
+template <typename T>
+influx::structures::radix_tree_node* influx::structures::radix_tree<T>::create_node() {
+    radix_tree_node* node = new radix_tree_node;
+
+    // Clear the slots of the node
+    memory::utils::memset(node->slots, 0, sizeof(node->slots));
+    node->count = 0;
+
+    return node;
+}
+
+template <typename T>
+void influx::structures::radix_tree<T>::free_node(influx::structures::radix_tree_node* node,
+                                                  uint64_t height) {
+    // Free the child nodes, the slots of the leaves are items
+    for (uint64_t i = 0; i < RADIX_TREE_SLOTS && height > 1; i++) {
+        if (node->slots[i] != nullptr) {
+            free_node((radix_tree_node*)node->slots[i], height - 1);
+        }
+    }
+
+    delete node;
+}
+
+template <typename T>
+void* influx::structures::radix_tree<T>::find_next_in_node(
+    influx::structures::radix_tree_node* node, uint64_t height, uint64_t base, uint64_t& index) {
+    uint64_t shift = (height - 1) * RADIX_TREE_SHIFT;
+    void* item = nullptr;
+
+    // Search the slots from the one that covers the index
+    for (uint64_t offset = index > base ? (index - base) >> shift : 0; offset < RADIX_TREE_SLOTS;
+         offset++) {
+        if (node->slots[offset] == nullptr) {
+            continue;
+        }
+
+        // Return the item of a leaf
+        if (height == 1) {
+            index = base + offset;
+            return node->slots[offset];
+        }
+
+        // Search the child node
+        if ((item = find_next_in_node((radix_tree_node*)node->slots[offset], height - 1,
+                                      base + (offset << shift), index)) != nullptr) {
+            return item;
+        }
+    }
+
+    return nullptr;
+}
\ No newline at end of file
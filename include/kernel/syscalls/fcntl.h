@@ -0,0 +1,13 @@
+#pragma once
+
+#define O_RDONLY 0x0000     /* open for reading only */
+#define O_WRONLY 0x0001     /* open for writing only */
+#define O_RDWR 0x0002       /* open for reading and writing */
+#define O_ACCMODE 0x0003    /* mask for the access mode */
+#define O_APPEND 0x0008     /* set append mode */
+#define O_CREAT 0x0200      /* create if nonexistant */
+#define O_NONBLOCK 0x4000   /* no delay */
+#define O_DIRECTORY 0x100000
+
+#define F_GETFL 3 /* get file status flags */
+#define F_SETFL 4 /* set file status flags */
\ No newline at end of file
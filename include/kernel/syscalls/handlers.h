@@ -1,10 +1,15 @@
 #pragma once
 #include <dirent.h>
+#include <kernel/syscalls/pollfd.h>
+#include <kernel/syscalls/rusage.h>
 #include <kernel/syscalls/stat.h>
 #include <kernel/threading/signal.h>
 #include <kernel/threading/signal_action.h>
+#include <kernel/time/timespec.h>
 #include <kernel/time/timeval.h>
+#include <kernel/vfs/epoll.h>
 #include <kernel/vfs/file_info.h>
+#include <kernel/vfs/io_vector.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -37,6 +42,40 @@ int64_t dup(size_t oldfd, size_t newfd);
 int64_t pipe(int pipefd[2]);
 int64_t sigprocmask(uint64_t how, const threading::signal_mask *set,
                     threading::signal_mask *oldset);
+int64_t clone(uint64_t flags, uint64_t entry, uint64_t arg, uint64_t tls,
+              uint32_t *clear_child_tid);
+int64_t arch_prctl(uint64_t code, uint64_t addr);
+int64_t futex(uint32_t *address, int op, uint32_t value, const time::timespec *timeout,
+              uint32_t *address2, uint32_t value3);
+int64_t lockstat(uint64_t op);
+int64_t clock_gettime(uint64_t clock_id, time::timespec *tp);
+int64_t clock_getres(uint64_t clock_id, time::timespec *res);
+int64_t nanosleep(const time::timespec *req, time::timespec *rem);
+int64_t systrace(uint64_t op, uint64_t arg);
+int64_t pread64(size_t fd, void *buf, size_t count, int64_t offset);
+int64_t pwrite64(size_t fd, const void *buf, size_t count, int64_t offset);
+int64_t readv(size_t fd, const vfs::io_vector *iov, int64_t iovcnt);
+int64_t writev(size_t fd, const vfs::io_vector *iov, int64_t iovcnt);
+int64_t preadv(size_t fd, const vfs::io_vector *iov, int64_t iovcnt, int64_t offset);
+int64_t pwritev(size_t fd, const vfs::io_vector *iov, int64_t iovcnt, int64_t offset);
+int64_t fsync(size_t fd);
+int64_t io_ring_setup(uint32_t entries);
+int64_t io_ring_enter(uint32_t to_submit);
+int64_t poll(pollfd *fds, uint64_t nfds, int64_t timeout_ms);
+int64_t select(uint64_t nfds, uint64_t *readfds, uint64_t *writefds, uint64_t *exceptfds,
+               time::timeval *timeout);
+int64_t epoll_create(int64_t size);
+int64_t epoll_ctl(size_t epfd, int op, size_t fd, const vfs::epoll_event *event);
+int64_t epoll_wait(size_t epfd, vfs::epoll_event *events, int64_t maxevents,
+                   int64_t timeout_ms);
+int64_t sendfile(size_t out_fd, size_t in_fd, int64_t *offset, size_t count);
+int64_t splice(size_t fd_in, int64_t *off_in, size_t fd_out, int64_t *off_out, size_t len,
+               uint64_t flags);
+int64_t fcntl(size_t fd, int cmd, uint64_t arg);
+int64_t pipe2(int pipefd[2], int flags);
+int64_t times(tms *buf);
+int64_t getrusage(int who, rusage *usage);
+int64_t wait4(int64_t pid, int *wait_status, uint64_t flags, rusage *usage);
 };  // namespace handlers
 };  // namespace syscalls
 };  // namespace influx
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <kernel/structures/hash_map.h>
+#include <kernel/threading/mutex.h>
+#include <memory/paging.h>
+#include <stdint.h>
+#include <sys/io_ring.h>
+
+#define IO_RING_SIZE (((sizeof(io_ring_t) + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_SIZE)
+
+namespace influx {
+namespace syscalls {
+struct io_ring_context {
+    io_ring_t *ring;
+
+    // Private copies of the indices that are advanced by the kernel
+    uint32_t sq_head;
+    uint32_t cq_tail;
+
+    // The process holds a reference, and each running enter call holds another one
+    uint64_t references;
+
+    threading::mutex mutex;
+};
+
+class io_ring_manager {
+   public:
+    io_ring_manager();
+
+    int64_t setup(uint32_t entries);
+    int64_t enter(uint32_t to_submit);
+    void release();
+
+   private:
+    threading::mutex _mutex;
+    structures::hash_map<uint64_t, io_ring_context *> _rings;
+
+    int64_t submit(io_ring_context *context, uint32_t to_submit);
+    void put_context(io_ring_context *context);
+
+    int64_t execute(const io_ring_sqe_t &sqe);
+    int64_t poll(const io_ring_sqe_t &sqe);
+
+    static void unmap_ring(const io_ring_t *ring, uint64_t size);
+};
+};  // namespace syscalls
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+#define POLL_MAX_FDS 1024
+#define SELECT_MAX_FDS 1024
+#define EPOLL_MAX_EVENTS 1024  // More events are returned by the next waits
+#define SELECT_BITS_PER_WORD 64
+
+namespace influx {
+namespace syscalls {
+struct pollfd {
+    int fd;
+    short events;
+    short revents;
+};
+};  // namespace syscalls
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <kernel/time/timeval.h>
+#include <stdint.h>
+
+#define RUSAGE_SELF 0
+#define RUSAGE_CHILDREN -1
+#define RUSAGE_THREAD 1
+
+#define TIMES_CLOCKS_PER_SECOND 1000  // CLOCKS_PER_SEC of newlib
+
+namespace influx {
+namespace syscalls {
+struct tms {
+    uint64_t user_time;
+    uint64_t system_time;
+    uint64_t children_user_time;
+    uint64_t children_system_time;
+};
+
+struct rusage {
+    time::timeval user_time;
+    time::timeval system_time;
+    int64_t max_rss;  // In KB
+    int64_t shared_memory_size;
+    int64_t unshared_data_size;
+    int64_t unshared_stack_size;
+    int64_t minor_page_faults;
+    int64_t major_page_faults;
+    int64_t swaps;
+    int64_t block_input_operations;
+    int64_t block_output_operations;
+    int64_t messages_sent;
+    int64_t messages_received;
+    int64_t signals_received;
+    int64_t voluntary_switches;
+    int64_t involuntary_switches;
+};
+};  // namespace syscalls
+};  // namespace influx
\ No newline at end of file
@@ -37,7 +37,40 @@ enum class syscall {
     dup,
     alarm,
     pipe,
-    sigprocmask
+    sigprocmask,
+    clone,
+    gettid,
+    arch_prctl,
+    exit_group,
+    futex,
+    lockstat,
+    clock_gettime,
+    clock_getres,
+    nanosleep,
+    systrace,
+    pread64,
+    pwrite64,
+    readv,
+    writev,
+    preadv,
+    pwritev,
+    fsync,
+    io_ring_setup,
+    io_ring_enter,
+    poll,
+    select,
+    epoll_create,
+    epoll_ctl,
+    epoll_wait,
+    sendfile,
+    splice,
+    fcntl,
+    pipe2,
+    getrusage,
+    wait4,
+
+    // Must be last, it's the amount of syscalls
+    amount_of_syscalls
 };
 };
 };  // namespace influx
\ No newline at end of file
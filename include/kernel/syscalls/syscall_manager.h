@@ -1,11 +1,22 @@
 #pragma once
 #include <kernel/interrupts/interrupt_regs.h>
 #include <kernel/logger.h>
+#include <kernel/syscalls/io_ring_manager.h>
 #include <kernel/syscalls/syscall.h>
+#include <kernel/syscalls/syscall_tracer.h>
 #include <kernel/threading/signal.h>
 
 #define SYSCALL_INTERRUPT 0x80
 
+#define STAR_KERNEL_SELECTORS_SHIFT 32
+#define STAR_USER_SELECTORS_SHIFT 48
+
+#define RFLAGS_TRAP_FLAG (1 << 8)
+#define RFLAGS_DIRECTION_FLAG (1 << 10)
+
+extern "C" uint64_t syscall_kernel_stack;
+extern "C" void syscall_entry();
+
 namespace influx {
 namespace syscalls {
 void syscall_interrupt_handler(interrupts::regs *context);
@@ -14,8 +25,15 @@ class syscall_manager {
    public:
     syscall_manager();
 
+    inline syscall_tracer &tracer() { return _tracer; }
+    inline io_ring_manager &io_rings() { return _io_rings; }
+
    private:
     logger _log;
+    syscall_tracer _tracer;
+    io_ring_manager _io_rings;
+
+    void init_syscall_instruction();
 
     int64_t handle_syscall(syscall syscall, uint64_t arg1, uint64_t arg2, uint64_t arg3,
                            uint64_t arg4, interrupts::regs *context);
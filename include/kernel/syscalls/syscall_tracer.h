@@ -0,0 +1,82 @@
+#pragma once
+#include <kernel/logger.h>
+#include <kernel/structures/hash_map.h>
+#include <kernel/syscalls/syscall.h>
+#include <kernel/threading/mutex.h>
+#include <stdint.h>
+
+#define SYSCALL_TRACER_MAX_SYSCALLS ((uint64_t)influx::syscalls::syscall::amount_of_syscalls)
+#define SYSCALL_TRACER_LATENCY_BUCKETS 32
+#define SYSCALL_TRACER_RING_SIZE 256
+#define SYSCALL_TRACER_ARGUMENTS 6
+
+#define SYSCALL_TRACER_MAX_ERROR 4095
+
+#define SYSTRACE_ENABLE 0
+#define SYSTRACE_DISABLE 1
+#define SYSTRACE_RESET 2
+#define SYSTRACE_DUMP 3
+#define SYSTRACE_TRACE_PID 4
+#define SYSTRACE_DUMP_TRACE 5
+
+#define SYSTRACE_ALL_PROCESSES ((uint64_t)-1)
+#define SYSTRACE_NO_PROCESS ((uint64_t)-1)
+
+namespace influx {
+namespace syscalls {
+struct syscall_stats {
+    uint64_t calls;
+    uint64_t errors;
+    uint64_t total_cycles;
+    uint64_t latency_buckets[SYSCALL_TRACER_LATENCY_BUCKETS];
+};
+
+struct syscall_trace_entry {
+    uint64_t tid;
+    syscall number;
+    uint64_t args[SYSCALL_TRACER_ARGUMENTS];
+    int64_t return_value;
+    uint64_t cycles;
+};
+
+class syscall_tracer {
+   public:
+    syscall_tracer();
+    ~syscall_tracer();
+
+    inline bool enabled() const { return _enabled; }
+    void enable();
+    void disable();
+    void reset();
+
+    void trace_process(uint64_t pid);
+
+    void record(syscall number, const uint64_t args[SYSCALL_TRACER_ARGUMENTS],
+                int64_t return_value, uint64_t cycles);
+
+    bool dump(uint64_t pid);
+    void dump_trace();
+
+   private:
+    logger _log;
+    threading::mutex _mutex;
+
+    bool _enabled;
+    uint64_t _traced_pid;
+
+    syscall_stats _stats[SYSCALL_TRACER_MAX_SYSCALLS];
+    structures::hash_map<uint64_t, syscall_stats *> _process_stats;
+
+    syscall_trace_entry _ring[SYSCALL_TRACER_RING_SIZE];
+    uint64_t _ring_head;
+    uint64_t _ring_count;
+
+    void clear_process_stats();
+
+    static void update_stats(syscall_stats &stats, int64_t return_value, uint64_t cycles);
+    void dump_stats(const syscall_stats *stats);
+
+    static const char *syscall_name(syscall number);
+};
+};  // namespace syscalls
+};  // namespace influx
\ No newline at end of file
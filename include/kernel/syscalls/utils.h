@@ -1,16 +1,36 @@
 #pragma once
+#include <kernel/structures/string.h>
+#include <kernel/structures/vector.h>
+#include <kernel/syscalls/rusage.h>
+#include <kernel/threading/cpu_usage.h>
 #include <kernel/vfs/error.h>
+#include <kernel/vfs/io_vector.h>
+#include <kernel/vfs/open_flags.h>
 #include <memory/protection_flags.h>
 #include <stdint.h>
 
+#define IOV_MAX 1024
+#define USER_STRING_MAX 4096
+
 namespace influx {
 namespace syscalls {
 class utils {
    public:
     static int64_t convert_vfs_error(vfs::error err);
+    static vfs::open_flags convert_open_flags(int flags);
+    static int convert_vfs_open_flags(vfs::open_flags flags);
+    static rusage convert_cpu_usage(const threading::cpu_usage &usage);
     static bool is_string_in_user_memory(const char *str);
     static bool is_buffer_in_user_memory(const void *buf, uint64_t size,
                                          protection_flags_t permissions);
+    static bool is_range_in_user_memory(const void *buf, uint64_t size);
+    static bool copy_from_user(void *dst, const void *user_src, uint64_t size);
+    static bool copy_to_user(void *user_dst, const void *src, uint64_t size);
+    static int64_t strncpy_from_user(char *dst, const char *user_src, uint64_t size);
+    static int64_t copy_string_from_user(const char *user_str, structures::string &str);
+    static int64_t copy_io_vectors_from_user(const vfs::io_vector *user_vectors,
+                                             int64_t vector_count,
+                                             structures::vector<vfs::io_vector> &vectors);
 };
 };  // namespace syscalls
 };  // namespace influx
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 namespace influx {
 namespace threading {
+enum class cv_status { no_timeout, timeout };
+
 class condition_variable {
    public:
     condition_variable();
@@ -15,6 +17,8 @@ class condition_variable {
 
     void wait(unique_lock<mutex>& lock);
     bool wait_interruptible(unique_lock<mutex>& lock);
+    cv_status wait_for(unique_lock<mutex>& lock, uint64_t timeout_ms);
+    cv_status wait_until(unique_lock<mutex>& lock, uint64_t deadline_ms);
 
    private:
     task_wait_queue _wait_queue;
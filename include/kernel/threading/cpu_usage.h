@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+namespace influx {
+namespace threading {
+struct cpu_usage {
+    uint64_t user_time;    // In TSC cycles
+    uint64_t system_time;  // In TSC cycles
+
+    uint64_t voluntary_switches;
+    uint64_t involuntary_switches;
+    uint64_t page_faults;
+
+    uint64_t max_rss;  // In bytes
+
+    inline cpu_usage& operator+=(const cpu_usage& usage) {
+        user_time += usage.user_time;
+        system_time += usage.system_time;
+        voluntary_switches += usage.voluntary_switches;
+        involuntary_switches += usage.involuntary_switches;
+        page_faults += usage.page_faults;
+        max_rss = usage.max_rss > max_rss ? usage.max_rss : max_rss;
+
+        return *this;
+    }
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
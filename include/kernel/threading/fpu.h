@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+
+#define DEVICE_NOT_AVAILABLE_INTERRUPT 7
+
+#define CR0_TASK_SWITCHED (1 << 3)
+#define CR4_OSXSAVE (1 << 18)
+
+#define CPUID_FEATURES_XSAVE (1 << 26)
+#define CPUID_XSAVE_FEATURES_XSAVEOPT (1 << 0)
+
+#define XCR0_X87_SSE 0b11
+
+#define FXSAVE_AREA_SIZE 512
+#define FPU_STATE_ALIGNMENT 64
+
+#define FPU_STATE_FCW_OFFSET 0
+#define FPU_STATE_MXCSR_OFFSET 24
+#define FPU_STATE_XSTATE_BV_OFFSET 512
+
+#define FPU_DEFAULT_FCW 0x37F
+#define FPU_DEFAULT_MXCSR 0x1F80
+
+#define FPU_EAGER_CMDLINE_OPTION "fpu=eager"
+
+namespace influx {
+namespace threading {
+enum class fpu_switch_mode { lazy, eager };
+
+enum class fpu_save_instruction { fxsave, xsave, xsaveopt };
+
+class fpu {
+   public:
+    static void init(const char *cmdline);
+
+    inline static fpu_switch_mode mode() { return _mode; }
+    inline static fpu_save_instruction save_instruction() { return _save_instruction; }
+    inline static uint64_t state_size() { return _state_size; }
+
+    static void *create_state();
+    static void free_state(void *state);
+
+    static void save(void *state);
+    static void restore(const void *state);
+
+    static void set_task_switched();
+    static void clear_task_switched();
+
+   private:
+    inline static fpu_switch_mode _mode = fpu_switch_mode::lazy;
+    inline static fpu_save_instruction _save_instruction = fpu_save_instruction::fxsave;
+    inline static uint64_t _state_size = FXSAVE_AREA_SIZE;
+
+    static bool cmdline_has_option(const char *cmdline, const char *option);
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
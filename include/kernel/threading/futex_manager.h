@@ -0,0 +1,45 @@
+#pragma once
+#include <kernel/structures/hash_map.h>
+#include <kernel/threading/mutex.h>
+#include <kernel/threading/task_wait_queue.h>
+#include <stdint.h>
+
+#define FUTEX_BITSET_MATCH_ANY 0xFFFFFFFF
+#define FUTEX_NO_TIMEOUT UINT64_MAX
+
+namespace influx {
+namespace threading {
+enum class futex_error : int64_t {
+    success = 0,
+    value_mismatch = -1,
+    timed_out = -2,
+    interrupted = -3,
+    fault = -4
+};
+
+struct futex_key_hash {
+    // Futex words are 4-byte aligned, so the low bits of the physical address are always zero
+    size_t operator()(const uint64_t &key) { return key >> 2; }
+};
+
+class futex_manager {
+   public:
+    futex_manager();
+
+    futex_error wait(uint32_t *address, uint32_t value, uint64_t timeout_ms, uint32_t bitset);
+    int64_t wake(uint32_t *address, uint64_t count, uint32_t bitset);
+    int64_t requeue(uint32_t *address, uint64_t wake_count, uint32_t *requeue_address,
+                    uint64_t requeue_count, bool compare, uint32_t value);
+
+   private:
+    mutex _futexes_mutex;
+    structures::hash_map<uint64_t, task_wait_queue *, futex_key_hash> _futexes;
+
+    uint64_t get_futex_key(uint32_t *address) const;
+    task_wait_queue *get_futex_queue(uint64_t key);
+    void release_futex_queue(uint64_t key);
+
+    static bool bitset_filter(tcb *task, void *bitset);
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
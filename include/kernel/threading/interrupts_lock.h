@@ -1,4 +1,6 @@
 #pragma once
+#include <kernel/threading/lockstat.h>
+#include <stdint.h>
 
 namespace influx {
 namespace threading {
@@ -12,6 +14,13 @@ class interrupts_lock {
 
    private:
     bool _locked;
+    bool _interrupts_enabled;
+
+#ifdef LOCKSTAT
+    const void* _lockstat_site;
+    lockstat_entry* _lockstat_entry;
+    uint64_t _lockstat_acquire_time;
+#endif
 };
 };  // namespace threading
 };  // namespace influx
\ No newline at end of file
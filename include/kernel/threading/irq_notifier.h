@@ -0,0 +1,31 @@
+#pragma once
+#include <kernel/threading/irq_waiter.h>
+#include <stdint.h>
+
+#define IRQ_NO_TIMEOUT UINT64_MAX
+
+namespace influx {
+namespace threading {
+class irq_notifier {
+   public:
+    irq_notifier();
+    irq_notifier(const irq_notifier&) = delete;
+
+    irq_notifier& operator=(const irq_notifier&) = delete;
+
+    void notify();
+    bool wait(bool interruptible, uint64_t timeout_ms = IRQ_NO_TIMEOUT);
+    void reset();
+
+   private:
+    uint64_t _pending;
+
+    // The waiters live on the stacks of the waiting tasks so notifying them doesn't free memory
+    irq_waiter *_waiters_head;
+    irq_waiter *_waiters_tail;
+
+    void add_waiter(irq_waiter *waiter);
+    void remove_waiter(irq_waiter *waiter);
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
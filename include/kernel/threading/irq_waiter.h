@@ -0,0 +1,12 @@
+#pragma once
+#include <kernel/threading/thread.h>
+
+namespace influx {
+namespace threading {
+struct irq_waiter {
+    tcb *task;
+    irq_waiter *next;
+    bool notified;
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+#define LOCKSTAT_MAX_ENTRIES 256
+
+#define LOCKSTAT_DUMP 0
+#define LOCKSTAT_RESET 1
+
+namespace influx {
+namespace threading {
+enum class lock_type { mutex, spinlock, interrupts_lock };
+
+struct lockstat_entry {
+    const void *key;
+    const char *name;
+    lock_type type;
+
+    uint64_t acquisitions;
+    uint64_t contentions;
+    uint64_t total_wait_time;
+    uint64_t max_hold_time;
+};
+
+class lockstat {
+   public:
+    static uint64_t timestamp();
+
+    static lockstat_entry *get_entry(lock_type type, const char *name, const void *site);
+    static void record_acquisition(lockstat_entry *entry, bool contended, uint64_t wait_time);
+    static void record_release(lockstat_entry *entry, uint64_t hold_time);
+
+    static void dump();
+    static void reset();
+
+   private:
+    inline static lockstat_entry _entries[LOCKSTAT_MAX_ENTRIES] = {};
+    inline static uint64_t _dropped_entries = 0;
+    inline static bool _paused = false;
+
+    static uint64_t disable_interrupts();
+    static void restore_interrupts(uint64_t rflags);
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
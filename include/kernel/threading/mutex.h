@@ -1,13 +1,14 @@
 #pragma once
-#include <kernel/threading/spinlock.h>
+#include <kernel/threading/lockstat.h>
 #include <kernel/threading/task_wait_queue.h>
+#include <kernel/threading/thread.h>
 #include <stdint.h>
 
 namespace influx {
 namespace threading {
 class mutex {
    public:
-    mutex();
+    mutex(const char* name = nullptr);
     mutex(const mutex& other) = delete;
 
     mutex& operator=(const mutex& other) = delete;
@@ -15,14 +16,29 @@ class mutex {
     void lock();
     bool lock_interruptible();
     bool try_lock();
+    bool try_lock_for(uint64_t timeout_ms);
 
     void unlock();
 
    private:
     uint32_t _value;
-    spinlock _value_lock;
+    tcb* _owner;
+    mutex* _next_held;
 
     task_wait_queue _wait_queue;
+
+#ifdef LOCKSTAT
+    const char* _name;
+    lockstat_entry* _lockstat_entry;
+    uint64_t _lockstat_acquire_time;
+
+    void lockstat_acquired(const void* site, bool contended, uint64_t wait_start);
+#endif
+
+    void acquire(tcb* task);
+    void release();
+
+    static void update_priority(tcb* task);
 };
 };  // namespace threading
 };  // namespace influx
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <kernel/structures/unique_hash_map.h>
 #include <kernel/structures/unique_vector.h>
 #include <kernel/structures/vector.h>
+#include <kernel/threading/cpu_usage.h>
 #include <kernel/threading/signal.h>
 #include <kernel/threading/signal_action.h>
 #include <kernel/vfs/open_file.h>
@@ -37,7 +38,6 @@ struct process {
     structures::unique_vector threads;
     structures::vector<uint64_t> child_processes;
 
-    structures::unique_hash_map<vfs::open_file> open_files;
     structures::unique_hash_map<vfs::file_descriptor> file_descriptors;
     structures::string name;
 
@@ -48,6 +48,9 @@ struct process {
 
     uint64_t tty;
 
+    cpu_usage usage;
+    cpu_usage children_usage;
+
     uint64_t exit_code;
     uint64_t exit_status;
 
@@ -1,14 +1,9 @@
 #pragma once
 #include <stdint.h>
 
-#define AMOUNT_OF_SSE_REGISTERS 16
-
-typedef double sse_128 __attribute__((vector_size(16)));
-
 namespace influx {
 namespace threading {
 struct regs {
-    sse_128 xmm[AMOUNT_OF_SSE_REGISTERS];
     uint64_t rax;
     uint64_t rbx;
     uint64_t rcx;
@@ -24,6 +19,9 @@ struct regs {
     uint64_t r14;
     uint64_t r15;
     uint64_t rbp;
-} __attribute__((packed));
+};
+
+// The context is pushed and popped by the save_context and restore_context macros
+static_assert(sizeof(regs) == 15 * sizeof(uint64_t), "regs must match the saved context layout");
 };  // namespace threading
 };  // namespace influx
\ No newline at end of file
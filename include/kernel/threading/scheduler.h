@@ -6,6 +6,7 @@
 #include <kernel/structures/unique_hash_map.h>
 #include <kernel/structures/vector.h>
 #include <kernel/syscalls/syscall_manager.h>
+#include <kernel/threading/cpu_usage.h>
 #include <kernel/threading/init_process.h>
 #include <kernel/threading/process.h>
 #include <kernel/threading/thread.h>
@@ -25,6 +26,17 @@
 
 #define DEFAULT_USER_STACK_ADDRESS (USERLAND_MEMORY_BARRIER - DEFAULT_USER_STACK_SIZE)
 
+#define MAX_USER_ARGS_SIZE (0x100000 * 2)
+
+#define MAX_USER_THREADS 256
+#define DEFAULT_USER_THREAD_STACK_SIZE (0x100000 * 2)
+#define USER_THREAD_STACK_SLOT_SIZE (DEFAULT_USER_THREAD_STACK_SIZE + PAGE_SIZE)  // + Guard page
+#define USER_THREAD_STACKS_TOP (DEFAULT_USER_STACK_ADDRESS - MAX_USER_ARGS_SIZE)
+#define USER_THREAD_STACKS_BOTTOM \
+    (USER_THREAD_STACKS_TOP - MAX_USER_THREADS * USER_THREAD_STACK_SLOT_SIZE)
+#define USER_THREAD_STACK_ADDRESS(tid) \
+    (USER_THREAD_STACKS_TOP - ((tid) + 1) * USER_THREAD_STACK_SLOT_SIZE + PAGE_SIZE)
+
 #define WAIT_FOR_ANY_PROCESS -1
 
 namespace influx {
@@ -38,7 +50,9 @@ void new_kernel_thread_wrapper(void (*func)(void *), void *data);
 void new_user_process_wrapper(executable *exec);
 void new_fork_process_wrapper(structures::vector<file_segment> *segments,
                               interrupts::regs *old_context);
+void new_user_thread_wrapper(uint64_t entry, uint64_t arg);
 void terminate_thread();
+void device_not_available_handler(interrupts::regs *context);
 
 class scheduler {
    public:
@@ -50,9 +64,11 @@ class scheduler {
                               uint64_t pid = KERNEL_PID);
 
     uint64_t sleep(uint64_t ms);
-    int64_t wait_for_child(int64_t child_pid, uint16_t *wait_status, bool no_hang);
+    int64_t wait_for_child(int64_t child_pid, uint16_t *wait_status, bool no_hang,
+                           cpu_usage *child_usage = nullptr);
 
     void exit(uint8_t code);
+    void exit_thread(uint8_t code);
     void kill_current_task();
 
     tcb *get_current_task() const;
@@ -64,6 +80,7 @@ class scheduler {
                   const structures::vector<structures::string> &args,
                   const structures::vector<structures::string> &env);
     uint64_t fork(interrupts::regs old_context);
+    int64_t clone(uint64_t entry, uint64_t arg, uint64_t fs_base, uint32_t *clear_child_tid);
     uint64_t sbrk(int64_t inc);
 
     uint64_t alarm(uint64_t ms);
@@ -84,13 +101,22 @@ class scheduler {
     uint64_t get_current_process_id() const;
     uint64_t get_current_parent_process_id();
 
+    uint64_t get_fs_base() const;
+    void set_fs_base(uint64_t fs_base);
+
     bool interrupted() const;
 
-    uint64_t add_file_descriptor(const vfs::open_file &file);
-    vfs::error get_file_descriptor(uint64_t fd, vfs::open_file &file);
-    void update_file_descriptor(uint64_t fd, vfs::open_file &file);
-    void remove_file_descriptor(uint64_t fd);
-    uint64_t duplicate_file_descriptor(uint64_t oldfd, int64_t newfd = -1);
+    void account_user_time();
+    void account_system_time();
+    void count_page_fault();
+    cpu_usage get_thread_cpu_usage();
+    cpu_usage get_process_cpu_usage();
+    cpu_usage get_children_cpu_usage();
+
+    uint64_t add_file_descriptor(vfs::open_file *file);
+    vfs::error get_file_descriptor(uint64_t fd, vfs::open_file *&file);
+    vfs::open_file *remove_file_descriptor(uint64_t fd);
+    int64_t duplicate_file_descriptor(uint64_t oldfd, int64_t newfd = -1);
 
    private:
     logger _log;
@@ -102,6 +128,9 @@ class scheduler {
     tcb *_tasks_clean_task;
     tcb *_idle_task;
     tcb *_current_task;
+    tcb *_fpu_owner;
+
+    uint64_t _loaded_fs_base;
 
     uint64_t _max_quantum;
 
@@ -114,6 +143,7 @@ class scheduler {
 
     void reschedule();
     void tick_handler();
+    void sleep_task(tcb *task, uint64_t ms);
     void update_tasks_sleep_quantum();
     void update_alarm_timers();
     void queue_task(tcb *task);
@@ -140,16 +170,33 @@ class scheduler {
     void default_signal_handler(process &process, signal_info sig_info);
     bool get_next_signal_info(signal_info &sig_info);
 
+    bool is_last_thread(tcb *task);
+    structures::vector<tcb *> get_process_tasks(uint64_t pid);
+    bool is_user_stack_slot_used(uint64_t pid, uint64_t user_stack_address);
+
+    void set_task_priority(tcb *task, uint8_t priority);
+
+    void switch_fpu_context(tcb *task);
+    void load_fpu_context();
+    void sync_fpu_state(tcb *task);
+    void reload_fpu_state(tcb *task);
+
     interrupts::regs *get_task_interrupt_regs(tcb *task);
 
     void create_wait_status(uint16_t *wait_status, process &process);
+    void reap_child_cpu_usage(process &parent, process &child, cpu_usage *child_usage);
+    void update_max_rss(process &process);
 
     friend void new_user_process_wrapper(executable *exec);
     friend void new_fork_process_wrapper(structures::vector<file_segment> *segments,
                                          interrupts::regs *old_context);
+    friend void new_user_thread_wrapper(uint64_t entry, uint64_t arg);
+    friend void device_not_available_handler(interrupts::regs *context);
 
     friend class mutex;
+    friend class shared_mutex;
     friend class condition_variable;
+    friend class futex_manager;
     friend class irq_notifier;
     friend class init_process;
     friend class syscalls::syscall_manager;
@@ -0,0 +1,58 @@
+#pragma once
+#include <kernel/threading/lock_types.h>
+#include <kernel/threading/scheduler_started.h>
+
+namespace influx {
+namespace threading {
+template <typename Mutex>
+class shared_lock {
+   public:
+    shared_lock(Mutex& mutex) : _mutex(mutex), _locked(scheduler_started) {
+        if (_locked) {
+            _mutex.lock_shared();
+        }
+    }
+
+    shared_lock(Mutex& mutex, defer_lock_t t) : _mutex(mutex), _locked(false) {}
+    shared_lock(Mutex& mutex, try_to_lock_t t)
+        : _mutex(mutex), _locked(scheduler_started && mutex.try_lock_shared()) {}
+    shared_lock(Mutex& mutex, adopt_lock_t t) : _mutex(mutex), _locked(true) {}
+    shared_lock(const shared_lock& other) = delete;
+
+    ~shared_lock() {
+        if (_locked) {
+            _mutex.unlock_shared();
+        }
+    }
+
+    void lock() {
+        if (scheduler_started && !_locked) {
+            _mutex.lock_shared();
+            _locked = true;
+        }
+    }
+
+    bool try_lock() {
+        if (scheduler_started && !_locked) {
+            _locked = _mutex.try_lock_shared();
+        }
+
+        return _locked || !scheduler_started;
+    }
+
+    void unlock() {
+        if (_locked) {
+            _mutex.unlock_shared();
+            _locked = false;
+        }
+    }
+
+    bool owns_lock() const { return _locked; }
+    explicit operator bool() const { return _locked; }
+
+   private:
+    Mutex& _mutex;
+    bool _locked;
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
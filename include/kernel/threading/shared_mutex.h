@@ -0,0 +1,31 @@
+#pragma once
+#include <kernel/threading/task_wait_queue.h>
+#include <stdint.h>
+
+namespace influx {
+namespace threading {
+class shared_mutex {
+   public:
+    shared_mutex();
+    shared_mutex(const shared_mutex& other) = delete;
+
+    shared_mutex& operator=(const shared_mutex& other) = delete;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+   private:
+    uint64_t _readers;
+    uint64_t _waiting_writers;
+    bool _writer;
+
+    task_wait_queue _readers_queue;
+    task_wait_queue _writers_queue;
+};
+};  // namespace threading
+};  // namespace influx
\ No newline at end of file
@@ -1,11 +1,12 @@
 #pragma once
+#include <kernel/threading/lockstat.h>
 #include <stdint.h>
 
 namespace influx {
 namespace threading {
 class spinlock {
    public:
-    spinlock();
+    spinlock(const char* name = nullptr);
     spinlock(const spinlock& other) = delete;
 
     spinlock& operator=(const spinlock& other) = delete;
@@ -17,6 +18,12 @@ class spinlock {
 
    private:
     volatile uint32_t _value;
+
+#ifdef LOCKSTAT
+    const char* _name;
+    lockstat_entry* _lockstat_entry;
+    uint64_t _lockstat_acquire_time;
+#endif
 };
 };  // namespace threading
 };  // namespace influx
\ No newline at end of file
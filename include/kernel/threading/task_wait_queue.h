@@ -1,5 +1,4 @@
 #pragma once
-#include <kernel/structures/node.h>
 #include <kernel/structures/vector.h>
 #include <kernel/threading/spinlock.h>
 #include <kernel/threading/thread.h>
@@ -12,15 +11,25 @@ class task_wait_queue {
 
     void enqueue(tcb *task);
     tcb *dequeue();
-    structures::vector<tcb *> dequeue_all();
+    tcb *dequeue(bool (*filter)(tcb *task, void *data), void *data);
+    uint64_t dequeue_all();
 
-    void remove_task(tcb *task);
+    structures::vector<tcb *> requeue(task_wait_queue &other, uint64_t count);
 
+    bool remove_task(tcb *task);
+    void reposition(tcb *task);
+
+    tcb *front();
     bool empty();
 
    private:
-    structures::node<tcb *> *_queue_head;
+    tcb *_queue_head;
     spinlock _queue_lock;
+
+    void enqueue_task(tcb *task);
+
+    void insert_task(tcb *task);
+    void unlink_task(tcb *task);
 };
 };  // namespace threading
 };  // namespace influx
\ No newline at end of file
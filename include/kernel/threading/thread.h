@@ -2,6 +2,7 @@
 #include <kernel/interrupts/interrupt_regs.h>
 #include <kernel/structures/node.h>
 #include <kernel/structures/vector.h>
+#include <kernel/threading/cpu_usage.h>
 #include <kernel/threading/regs.h>
 #include <kernel/threading/signal.h>
 #include <kernel/threading/signal_info.h>
@@ -9,6 +10,9 @@
 
 namespace influx {
 namespace threading {
+class mutex;
+class task_wait_queue;
+
 enum class thread_state { ready, running, blocked, sleeping, waiting_for_child, killed };
 
 struct thread {
@@ -19,14 +23,35 @@ struct thread {
 
     void* kernel_stack;
     void* user_stack;
+    uint64_t user_stack_address;
+    uint64_t user_stack_size;
     uint64_t args_size;
+    uint64_t fs_base;
+
+    void* fpu_state;
+    void* old_fpu_state;
 
     thread_state state;
+    uint8_t priority;
     uint64_t quantum;
     uint64_t sleep_quantum;
 
+    cpu_usage usage;
+    uint64_t usage_timestamp;
+
     int64_t child_wait_pid;
 
+    uint64_t futex_key;
+    uint32_t futex_bitset;
+    uint32_t* clear_child_tid;
+
+    mutex* blocked_mutex;
+    mutex* held_mutexes;
+
+    task_wait_queue* wait_queue;
+    structures::node<thread>* wait_prev;
+    structures::node<thread>* wait_next;
+
     bool signal_interruptible;
     bool signal_interrupted;
 
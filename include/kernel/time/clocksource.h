@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+
+#define NSECONDS_IN_SECOND 1000000000
+#define NSECONDS_IN_MILLISECOND 1000000
+
+#define CLOCKSOURCE_SHIFT 32
+
+namespace influx {
+namespace time {
+class clocksource {
+   public:
+    clocksource(const char *name, uint64_t frequency)
+        : _name(name),
+          _frequency(frequency),
+          _mult(((uint64_t)NSECONDS_IN_SECOND << CLOCKSOURCE_SHIFT) / frequency) {}
+    virtual ~clocksource(){};
+
+    virtual uint64_t read() const = 0;
+    virtual bool user_readable() const { return false; }
+
+    inline const char *name() const { return _name; }
+    inline uint64_t frequency() const { return _frequency; }
+    inline uint64_t mult() const { return _mult; }
+
+    inline uint64_t resolution() const {
+        return _frequency >= NSECONDS_IN_SECOND ? 1 : NSECONDS_IN_SECOND / _frequency;
+    }
+
+    inline uint64_t to_nanoseconds(uint64_t count) const {
+        return (uint64_t)(((unsigned __int128)count * _mult) >> CLOCKSOURCE_SHIFT);
+    }
+
+   private:
+    const char *_name;
+    uint64_t _frequency;
+    uint64_t _mult;
+};
+};  // namespace time
+};  // namespace influx
\ No newline at end of file
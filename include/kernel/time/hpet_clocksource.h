@@ -0,0 +1,17 @@
+#pragma once
+#include <kernel/drivers/time/hpet.h>
+#include <kernel/time/clocksource.h>
+
+namespace influx {
+namespace time {
+class hpet_clocksource : public clocksource {
+   public:
+    hpet_clocksource(drivers::hpet *hpet) : clocksource("hpet", hpet->frequency()), _hpet(hpet) {}
+
+    virtual uint64_t read() const { return _hpet->main_counter(); }
+
+   private:
+    drivers::hpet *_hpet;
+};
+};  // namespace time
+};  // namespace influx
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 #include <kernel/drivers/time/cmos.h>
 #include <kernel/drivers/time/timer_driver.h>
+#include <kernel/logger.h>
+#include <kernel/time/clocksource.h>
+#include <kernel/time/timespec.h>
 #include <kernel/time/timeval.h>
 #include <stdint.h>
+#include <sys/time_page.h>
 
 namespace influx {
 namespace time {
@@ -11,29 +15,54 @@ struct tick_handler {
     void *data;
 };
 
+// Matches the clock ids of newlib
+enum class clock_id { realtime = 1, monotonic = 4 };
+
 class time_manager {
    public:
     time_manager();
 
-    double seconds() const;
-    double milliseconds() const;
+    uint64_t seconds() const;
+    uint64_t milliseconds() const;
+
+    uint64_t monotonic_ns() const;
+    uint64_t realtime_ns() const;
 
     uint64_t unix_timestamp() const;
     uint64_t unix_timestamp_ms() const;
     timeval get_timeval() const;
 
+    bool get_time(clock_id clock, timespec &ts) const;
+    bool get_resolution(clock_id clock, timespec &ts) const;
+
     uint64_t timer_frequency() const;
+    const clocksource *current_clocksource() const;
+
+    uint64_t tsc_to_nanoseconds(uint64_t cycles) const;
+
+    bool map_time_page() const;
+    void unmap_time_page() const;
 
     void tick();
     void register_tick_handler(void (*handler)(void *), void *data);
 
    private:
+    logger _log;
+
     drivers::timer_driver *_timer_driver;
     drivers::cmos *_cmos_driver;
 
-    double _unix_timestamp;
+    clocksource *_clocksource;
+    clocksource *_tsc_clocksource;
+    uint64_t _start_count;
+    uint64_t _boot_unix_ns;
 
     tick_handler _tick_handler;
+
+    time_page_t *_time_page;
+
+    clocksource *select_clocksource();
+    void update_time_page();
 };
 };  // namespace time
 };  // namespace influx
\ No newline at end of file
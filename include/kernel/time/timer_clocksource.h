@@ -0,0 +1,18 @@
+#pragma once
+#include <kernel/drivers/time/timer_driver.h>
+#include <kernel/time/clocksource.h>
+
+namespace influx {
+namespace time {
+class timer_clocksource : public clocksource {
+   public:
+    timer_clocksource(drivers::timer_driver *timer)
+        : clocksource("timer", timer->count_frequency()), _timer(timer) {}
+
+    virtual uint64_t read() const { return _timer->current_count(); }
+
+   private:
+    drivers::timer_driver *_timer;
+};
+};  // namespace time
+};  // namespace influx
\ No newline at end of file
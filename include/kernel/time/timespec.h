@@ -0,0 +1,11 @@
+#pragma once
+#include <stdint.h>
+
+namespace influx {
+namespace time {
+struct timespec {
+    uint64_t seconds;
+    uint64_t nseconds;
+};
+};  // namespace time
+};  // namespace influx
\ No newline at end of file
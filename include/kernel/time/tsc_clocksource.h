@@ -0,0 +1,31 @@
+#pragma once
+#include <kernel/time/clocksource.h>
+
+#define CPUID_EXTENDED_MAX_LEAF 0x80000000
+#define CPUID_ADVANCED_POWER_MANAGEMENT 0x80000007
+#define CPUID_APM_INVARIANT_TSC (1 << 8)
+
+#define TSC_CALIBRATION_MS 50
+
+namespace influx {
+namespace time {
+class tsc_clocksource : public clocksource {
+   public:
+    tsc_clocksource(uint64_t frequency) : clocksource("tsc", frequency) {}
+
+    virtual uint64_t read() const { return rdtsc(); }
+    virtual bool user_readable() const { return true; }
+
+    static bool invariant();
+    static uint64_t calibrate(const clocksource &reference);
+
+    inline static uint64_t rdtsc() {
+        uint32_t low, high;
+
+        __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+
+        return ((uint64_t)high << 32) | low;
+    }
+};
+};  // namespace time
+};  // namespace influx
\ No newline at end of file
@@ -5,6 +5,10 @@
 #include <kernel/threading/condition_variable.h>
 #include <kernel/threading/lock_guard.h>
 #include <kernel/threading/mutex.h>
+#include <kernel/vfs/poll_notifier.h>
+
+#define TTY_BAD_ADDRESS ((uint64_t)-1)
+#define TTY_WOULD_BLOCK ((uint64_t)-2)
 
 namespace influx {
 namespace tty {
@@ -67,7 +71,8 @@ class tty {
     void activate();
     void deactivate();
 
-    uint64_t stdin_read(char* buf, size_t count);
+    uint64_t stdin_read(char* buf, size_t count, bool non_blocking);
+    uint16_t poll(vfs::poll_listener* listener);
     void stdout_write(structures::string& str);
     inline void stderr_write(structures::string& str) { stdout_write(str); }
 
@@ -93,6 +98,7 @@ class tty {
     bool _print_stdin;
 
     threading::condition_variable _stdin_cv;
+    vfs::poll_notifier _stdin_notifier;
     threading::mutex _stdin_mutex;
     threading::mutex _stdout_mutex;
 
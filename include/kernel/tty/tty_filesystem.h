@@ -11,9 +11,9 @@ class tty_filesystem : public vfs::filesystem {
 
     inline virtual bool mount(const vfs::path& mount_path) { return false; }
     virtual vfs::error read(void* fs_file_info, char* buffer, size_t count, size_t offset,
-                            size_t& amount_read);
+                            size_t& amount_read, vfs::open_flags flags);
     virtual vfs::error write(void* fs_file_info, const char* buffer, size_t count, size_t offset,
-                             size_t& amount_written);
+                             size_t& amount_written, vfs::open_flags flags);
     virtual vfs::error get_file_info(void* fs_file_info, vfs::file_info& file);
     inline virtual vfs::error read_dir_entries(void* fs_file_info, size_t offset,
                                                structures::vector<vfs::dir_entry>& entries,
@@ -30,13 +30,14 @@ class tty_filesystem : public vfs::filesystem {
                                          void** fs_file_info_ptr) {
         return vfs::error::insufficient_permissions;
     }
-    inline virtual void duplicate_open_file(const vfs::open_file& file, void* fs_file_info){};
     inline virtual void close_open_file(const vfs::open_file& file, void* fs_file_info){};
     inline virtual vfs::error unlink_file(const vfs::path& file_path) {
         return vfs::error::insufficient_permissions;
     }
     inline virtual void* get_fs_file_data(const vfs::path& file_path) { return nullptr; }
     virtual bool compare_fs_file_data(void* fs_file_data_1, void* fs_file_data_2);
+    virtual uint64_t fs_file_data_key(void* fs_file_data);
+    virtual uint16_t poll(void* fs_file_info, vfs::poll_listener* listener);
 
    private:
     uint64_t _creation_time;
@@ -0,0 +1,19 @@
+#pragma once
+#include <kernel/structures/radix_tree.h>
+#include <stdint.h>
+
+namespace influx {
+namespace vfs {
+struct cached_page {
+    uint64_t index;
+    uint8_t *data;  // A whole page so it can be mapped as is
+
+    bool dirty;
+    uint64_t references;  // Pages in use can't be evicted
+
+    structures::radix_tree<cached_page> *tree;
+    cached_page *lru_prev;
+    cached_page *lru_next;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include <kernel/structures/string.h>
+#include <kernel/vfs/file_info.h>
+#include <stdint.h>
+
+namespace influx {
+namespace vfs {
+class filesystem;
+
+struct dentry {
+    filesystem *fs;
+    dentry *parent;
+    structures::string name;
+    void *fs_data;  // Null for a negative entry
+
+    file_info file;
+    bool file_cached;  // The info of files that have a vnode is kept in their vnode
+
+    uint64_t key;
+    uint64_t children;  // Entries with cached children can't be evicted
+
+    dentry *hash_next;
+    dentry *lru_prev;
+    dentry *lru_next;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <kernel/structures/hash_map.h>
+#include <kernel/structures/string.h>
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/dentry.h>
+#include <kernel/vfs/filesystem.h>
+#include <kernel/vfs/path.h>
+#include <stdint.h>
+
+#define DENTRY_CACHE_MAX_ENTRIES 1024
+
+#define DENTRY_HASH_OFFSET_BASIS 0xCBF29CE484222325
+#define DENTRY_HASH_PRIME 0x100000001B3
+
+namespace influx {
+namespace vfs {
+class dentry_cache {
+   public:
+    dentry_cache();
+
+    void *lookup(filesystem *fs, const path &file_path);
+    void invalidate(filesystem *fs, const path &file_path);
+
+    bool get_file_info(filesystem *fs, const path &file_path, file_info &file,
+                       uint64_t &generation);
+    void set_file_info(filesystem *fs, const path &file_path, const file_info &file,
+                       uint64_t generation);
+    void forget_file_info(filesystem *fs, const path &file_path);
+
+   private:
+    threading::mutex _mutex;
+    structures::hash_map<uint64_t, dentry *> _dentries;
+    uint64_t _amount_of_dentries;
+
+    dentry *_lru_head;
+    dentry *_lru_tail;
+
+    uint64_t _generation;  // Advanced on every invalidation
+
+    dentry *find_dentry(filesystem *fs, dentry *parent, const structures::string &name);
+    dentry *find_path_dentry(filesystem *fs, const path &file_path);
+    dentry *create_dentry(filesystem *fs, dentry *parent, const structures::string &name,
+                          void *fs_data);
+    void remove_dentry(dentry *entry);
+    void touch_dentry(dentry *entry);
+    void evict_dentries();
+
+    static uint64_t dentry_key(filesystem *fs, dentry *parent, const structures::string &name);
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
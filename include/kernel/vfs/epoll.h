@@ -0,0 +1,62 @@
+#pragma once
+#include <kernel/structures/hash_map.h>
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/poll_notifier.h>
+#include <kernel/vfs/poll_set.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EPOLLIN 0x1
+#define EPOLLPRI 0x2
+#define EPOLLOUT 0x4
+#define EPOLLERR 0x8
+#define EPOLLHUP 0x10
+#define EPOLLONESHOT (1u << 30)
+#define EPOLLET (1u << 31)
+
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+namespace influx {
+namespace vfs {
+struct epoll_event {
+    uint32_t events;
+    uint64_t data;
+} __attribute__((packed));
+
+struct epoll;
+
+struct epoll_item {
+    size_t fd;
+    uint32_t events;
+    uint64_t data;
+
+    bool enabled;
+    bool ready;
+    epoll_item *ready_next;
+
+    poll_listener listener;
+    epoll *instance;
+};
+
+struct epoll {
+    inline epoll()
+        : mutex("epoll"),
+          items(nullptr),
+          ready_mutex("epoll_ready"),
+          ready_head(nullptr),
+          ready_tail(nullptr) {}
+
+    threading::mutex mutex;
+    structures::hash_map<uint64_t, epoll_item *> items;
+
+    threading::mutex ready_mutex;
+    epoll_item *ready_head;
+    epoll_item *ready_tail;
+
+    poll_waiter waiter;
+    poll_notifier notifier;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
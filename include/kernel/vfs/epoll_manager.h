@@ -0,0 +1,39 @@
+#pragma once
+#include <kernel/structures/unique_hash_map.h>
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/epoll.h>
+#include <kernel/vfs/epoll_filesystem.h>
+#include <kernel/vfs/error.h>
+#include <stdint.h>
+
+namespace influx {
+namespace vfs {
+class epoll_manager {
+   public:
+    epoll_manager();
+
+    bool create_instance(uint64_t* fd);
+
+    error control(size_t epfd, int op, size_t fd, const epoll_event& event);
+    int64_t wait(size_t epfd, epoll_event* events, size_t max_events, int64_t timeout_ms);
+
+   private:
+    epoll_filesystem _fs;
+
+    threading::mutex _instances_mutex;
+    structures::unique_hash_map<epoll*> _instances;
+
+    epoll* get_instance(size_t fd);
+    void destroy_instance(uint64_t instance_index);
+    uint16_t poll(uint64_t instance_index, poll_listener* listener);
+
+    size_t collect(epoll* instance, epoll_event* events, size_t max_events);
+    void remove_item(epoll_item* item);
+
+    static void enqueue_ready(epoll_item* item);
+    static void item_callback(poll_listener* listener, uint16_t events);
+
+    friend class epoll_filesystem;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
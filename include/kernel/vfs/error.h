@@ -21,7 +21,9 @@ enum error : int64_t {
     invalid_position = -14,
     interrupted = -15,
     is_pipe = -16,
-    pipe_closed = -17
+    pipe_closed = -17,
+    bad_address = -18,
+    would_block = -19
 };
 };
 };  // namespace influx
\ No newline at end of file
@@ -5,12 +5,10 @@
 namespace influx {
 namespace vfs {
 struct file_descriptor {
-    uint64_t open_file_index;
+    open_file* file;
 
     inline bool operator!=(const file_descriptor& fd) const { return !(*this == fd); }
-    inline bool operator==(const file_descriptor& fd) const {
-        return open_file_index == fd.open_file_index;
-    }
+    inline bool operator==(const file_descriptor& fd) const { return file == fd.file; }
 };
 };  // namespace vfs
 };  // namespace influx
\ No newline at end of file
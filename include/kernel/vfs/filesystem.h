@@ -5,8 +5,10 @@
 #include <kernel/vfs/dir_entry.h>
 #include <kernel/vfs/error.h>
 #include <kernel/vfs/file_info.h>
+#include <kernel/vfs/io_vector.h>
 #include <kernel/vfs/open_file.h>
 #include <kernel/vfs/path.h>
+#include <kernel/vfs/poll_notifier.h>
 
 namespace influx {
 namespace vfs {
@@ -17,9 +19,13 @@ class filesystem {
     inline virtual ~filesystem(){};
     virtual bool mount(const path& mount_path) = 0;
     virtual error read(void* fs_file_info, char* buffer, size_t count, size_t offset,
-                       size_t& amount_read) = 0;
+                       size_t& amount_read, open_flags flags) = 0;
     virtual error write(void* fs_file_info, const char* buffer, size_t count, size_t offset,
-                        size_t& amount_written) = 0;
+                        size_t& amount_written, open_flags flags) = 0;
+    virtual error readv(void* fs_file_info, const io_vector* vectors, size_t vector_count,
+                        size_t count, size_t offset, size_t& amount_read, open_flags flags);
+    virtual error writev(void* fs_file_info, const io_vector* vectors, size_t vector_count,
+                         size_t count, size_t offset, size_t& amount_written, open_flags flags);
     virtual error get_file_info(void* fs_file_info, file_info& file) = 0;
     virtual error read_dir_entries(void* fs_file_info, size_t offset,
                                    structures::vector<dir_entry>& entries,
@@ -28,11 +34,17 @@ class filesystem {
                               void** fs_file_info_ptr) = 0;
     virtual error create_dir(const path& dir_path, file_permissions permissions,
                              void** fs_file_info_ptr) = 0;
-    virtual void duplicate_open_file(const open_file& file, void* fs_file_info) = 0;
     virtual void close_open_file(const open_file& file, void* fs_file_info) = 0;
     virtual error unlink_file(const path& file_path) = 0;
     virtual void* get_fs_file_data(const path& file_path) = 0;
+    virtual void* get_root_fs_file_data();
+    virtual void* lookup_fs_file_data(void* dir_fs_file_data, const structures::string& name);
+    virtual void* duplicate_fs_file_data(void* fs_file_data);
     virtual bool compare_fs_file_data(void* fs_file_data_1, void* fs_file_data_2) = 0;
+    virtual uint64_t fs_file_data_key(void* fs_file_data) = 0;
+    virtual uint16_t poll(void* fs_file_info, poll_listener* listener);
+    inline virtual void release_fs_file_data(void* fs_file_data){};
+    inline virtual bool cacheable() const { return false; }
 
     inline const structures::string& name() const { return _name; }
     inline const drivers::ata::drive_slice& drive() const { return _drive; }
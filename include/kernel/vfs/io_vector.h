@@ -0,0 +1,12 @@
+#pragma once
+#include <stddef.h>
+
+namespace influx {
+namespace vfs {
+// Has the same layout as the userland iovec struct
+struct io_vector {
+    void* base;
+    size_t length;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -1,20 +1,25 @@
 #pragma once
+#include <kernel/threading/mutex.h>
 #include <kernel/vfs/open_flags.h>
 #include <stdint.h>
 
 namespace influx {
 namespace vfs {
+struct vnode;
+
+// Open file descriptions are shared by the file descriptors that were duplicated from them
 struct open_file {
+    inline open_file(uint64_t vnode_index_, vnode* vn_, open_flags flags_)
+        : vnode_index(vnode_index_), vn(vn_), position(0), flags(flags_), references(1) {}
+    open_file(const open_file& other) = delete;
+
     uint64_t vnode_index;
+    vnode* vn;  // Pinned by the open files count of the vnode
     uint64_t position;
     open_flags flags;
 
-    uint64_t amount_of_file_descriptors;
-
-    inline bool operator!=(const open_file& f) const { return !(*this == f); }
-    inline bool operator==(const open_file& f) const {
-        return vnode_index == f.vnode_index && flags == f.flags;
-    }
+    uint64_t references;  // The file descriptors and the operations in progress
+    threading::mutex position_mutex;
 };
 };  // namespace vfs
 };  // namespace influx
\ No newline at end of file
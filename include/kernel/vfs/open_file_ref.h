@@ -0,0 +1,23 @@
+#pragma once
+#include <kernel/vfs/open_file.h>
+
+namespace influx {
+namespace vfs {
+// Holds a reference of an open file, which is released when the object is destroyed
+class open_file_ref {
+   public:
+    inline open_file_ref() : _file(nullptr) {}
+    open_file_ref(const open_file_ref& other) = delete;
+    ~open_file_ref();
+
+    void reset(open_file* file = nullptr);
+
+    inline open_file* get() const { return _file; }
+    inline open_file* operator->() const { return _file; }
+    inline open_file& operator*() const { return *_file; }
+
+   private:
+    open_file* _file;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -2,6 +2,13 @@
 
 namespace influx {
 namespace vfs {
-enum open_flags { read = 0x1, write = 0x2, append = 0x4, directory = 0x8, create = 0x10 };
+enum open_flags {
+    read = 0x1,
+    write = 0x2,
+    append = 0x4,
+    directory = 0x8,
+    create = 0x10,
+    non_blocking = 0x20
+};
 };
 };  // namespace influx
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/cached_page.h>
+#include <kernel/vfs/error.h>
+#include <kernel/vfs/io_vector.h>
+#include <kernel/vfs/open_flags.h>
+#include <kernel/vfs/vnode.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PAGE_CACHE_MAX_PAGES 4096
+#define PAGE_CACHE_MAX_DIRTY_PAGES 1024
+#define PAGE_CACHE_MAX_RUN_PAGES 32
+#define PAGE_CACHE_FLUSH_INTERVAL 5000  // Milliseconds
+
+namespace influx {
+namespace vfs {
+class page_cache {
+   public:
+    page_cache();
+
+    // ** The file mutex of the vnode should be locked for these **
+    error read(vnode &vn, const io_vector *vectors, size_t vector_count, size_t count,
+               size_t offset, size_t &amount_read, open_flags flags);
+    error write(vnode &vn, const io_vector *vectors, size_t vector_count, size_t count,
+                size_t offset, size_t &amount_written, open_flags flags);
+    error flush(vnode &vn);
+    void release(vnode &vn);
+
+   private:
+    threading::mutex _mutex;
+    uint64_t _amount_of_pages;
+    uint64_t _amount_of_dirty_pages;
+
+    cached_page *_lru_head;
+    cached_page *_lru_tail;
+
+    error fill_pages(vnode &vn, uint64_t index, uint64_t max_amount, open_flags flags,
+                     cached_page *&first_page);
+
+    cached_page *get_page(vnode &vn, uint64_t index);
+    void put_page(cached_page *page);
+    void set_dirty(cached_page *page, bool dirty);
+    void insert_page(vnode &vn, cached_page *page);
+    void remove_page(cached_page *page);
+    void touch_page(cached_page *page);
+    void evict_pages();
+
+    static cached_page *create_page(uint64_t index);
+    static bool copy_to_vectors(const io_vector *vectors, size_t vector_count,
+                                size_t vectors_offset, const uint8_t *data, size_t amount);
+    static bool copy_from_vectors(uint8_t *data, const io_vector *vectors, size_t vector_count,
+                                  size_t vectors_offset, size_t amount);
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <kernel/threading/condition_variable.h>
 #include <kernel/threading/mutex.h>
 #include <kernel/vfs/file_info.h>
+#include <kernel/vfs/poll_notifier.h>
 #include <stdint.h>
 
 namespace influx {
@@ -12,7 +13,8 @@ struct pipe {
         : buffer(raw_buffer, size),
           amount_of_read_file_descriptors(1),
           amount_of_write_file_descriptors(1),
-          file(pipe_file) {}
+          file(pipe_file),
+          mutex("pipe") {}
 
     structures::fifo buffer;
 
@@ -25,6 +27,8 @@ struct pipe {
 
     threading::condition_variable read_cv;
     threading::condition_variable write_cv;
+
+    poll_notifier notifier;
 };
 };  // namespace vfs
 };  // namespace influx
\ No newline at end of file
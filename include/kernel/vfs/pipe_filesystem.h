@@ -11,9 +11,9 @@ class pipe_filesystem : public filesystem {
 
     inline virtual bool mount(const path& mount_path) { return false; }
     virtual error read(void* fs_file_info, char* buffer, size_t count, size_t offset,
-                       size_t& amount_read);
+                       size_t& amount_read, open_flags flags);
     virtual error write(void* fs_file_info, const char* buffer, size_t count, size_t offset,
-                        size_t& amount_written);
+                        size_t& amount_written, open_flags flags);
     virtual error get_file_info(void* fs_file_info, file_info& file);
     inline virtual error read_dir_entries(void* fs_file_info, size_t offset,
                                           structures::vector<dir_entry>& entries,
@@ -28,13 +28,14 @@ class pipe_filesystem : public filesystem {
                                     void** fs_file_info_ptr) {
         return error::insufficient_permissions;
     }
-    virtual void duplicate_open_file(const open_file& file, void* fs_file_info);
     virtual void close_open_file(const open_file& file, void* fs_file_info);
     inline virtual error unlink_file(const path& file_path) {
         return error::insufficient_permissions;
     }
     inline virtual void* get_fs_file_data(const path& file_path) { return nullptr; }
     virtual bool compare_fs_file_data(void* fs_file_data_1, void* fs_file_data_2);
+    virtual uint64_t fs_file_data_key(void* fs_file_data);
+    virtual uint16_t poll(void* fs_file_info, poll_listener* listener);
 
    private:
     pipe_manager* _manager;
@@ -1,32 +1,38 @@
 #pragma once
 #include <kernel/structures/unique_hash_map.h>
 #include <kernel/threading/mutex.h>
+#include <kernel/threading/shared_mutex.h>
 #include <kernel/vfs/pipe.h>
 #include <kernel/vfs/pipe_filesystem.h>
 #include <stdint.h>
 
 #define PIPE_BUFFER_SIZE (1 << 16)
 
+#define PIPE_CLOSED ((uint64_t)-1)
+#define PIPE_BAD_ADDRESS ((uint64_t)-2)
+#define PIPE_WOULD_BLOCK ((uint64_t)-3)
+
 namespace influx {
 namespace vfs {
 class pipe_manager {
    public:
     pipe_manager();
 
-    bool create_pipe(uint64_t* read_fd, uint64_t* write_fd);
+    bool create_pipe(uint64_t* read_fd, uint64_t* write_fd, open_flags flags = (open_flags)0);
 
    private:
     pipe_filesystem _fs;
 
-    threading::mutex _pipes_mutex;
+    threading::shared_mutex _pipes_mutex;
     structures::unique_hash_map<pipe*> _pipes;
 
     file_info get_pipe_file_info(uint64_t pipe_index);
     bool pipe_exists(uint64_t pipe_index);
     bool close_pipe(uint64_t pipe_index);
 
-    uint64_t read(uint64_t pipe_index, void* buf, size_t count);
-    uint64_t write(uint64_t pipe_index, const void* buf, size_t count);
+    uint64_t read(uint64_t pipe_index, void* buf, size_t count, bool non_blocking);
+    uint64_t write(uint64_t pipe_index, const void* buf, size_t count, bool non_blocking);
+    uint16_t poll(uint64_t pipe_index, poll_listener* listener);
 
     pipe *get_pipe(uint64_t pipe_index);
 
@@ -0,0 +1,9 @@
+#pragma once
+
+// The values match the userland poll events
+#define VFS_POLL_IN 0x1
+#define VFS_POLL_PRIORITY 0x2
+#define VFS_POLL_OUT 0x4
+#define VFS_POLL_ERROR 0x8
+#define VFS_POLL_HANG_UP 0x10
+#define VFS_POLL_INVALID 0x20
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/poll_events.h>
+#include <stdint.h>
+
+namespace influx {
+namespace vfs {
+class poll_notifier;
+
+struct poll_listener {
+    void (*callback)(poll_listener *listener, uint16_t events);
+    void *data;
+
+    poll_notifier *notifier;
+    poll_listener *next;
+};
+
+class poll_notifier {
+   public:
+    poll_notifier();
+    poll_notifier(const poll_notifier &other) = delete;
+    ~poll_notifier();
+
+    poll_notifier &operator=(const poll_notifier &other) = delete;
+
+    void add_listener(poll_listener *listener);
+    void notify(uint16_t events);
+
+    static void remove_listener(poll_listener *listener);
+
+   private:
+    threading::mutex _mutex;
+    poll_listener *_listeners;
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <kernel/structures/vector.h>
+#include <kernel/threading/condition_variable.h>
+#include <kernel/threading/mutex.h>
+#include <kernel/vfs/poll_notifier.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define POLL_INFINITE_TIMEOUT -1
+
+namespace influx {
+namespace vfs {
+struct poll_request {
+    int64_t fd;
+    uint16_t events;
+    uint16_t revents;
+};
+
+class poll_waiter {
+   public:
+    poll_waiter();
+    poll_waiter(const poll_waiter &other) = delete;
+
+    void wake();
+    bool wait_until(int64_t deadline_ms);
+
+    static void listener_callback(poll_listener *listener, uint16_t events);
+
+   private:
+    threading::mutex _mutex;
+    threading::condition_variable _cv;
+    bool _triggered;
+};
+
+class poll_set {
+   public:
+    poll_set(poll_request *requests, size_t count);
+    poll_set(const poll_set &other) = delete;
+    ~poll_set();
+
+    int64_t wait(int64_t timeout_ms);
+
+   private:
+    poll_request *_requests;
+    size_t _count;
+
+    structures::vector<poll_listener> _listeners;
+    poll_waiter _waiter;
+
+    size_t scan(bool listen);
+};
+};  // namespace vfs
+};  // namespace influx
\ No newline at end of file
@@ -7,17 +7,29 @@
 #include <kernel/structures/vector.h>
 #include <kernel/threading/mutex.h>
 #include <kernel/threading/scheduler.h>
+#include <kernel/threading/shared_mutex.h>
 #include <kernel/tty/tty_manager.h>
+#include <kernel/vfs/dentry_cache.h>
+#include <kernel/vfs/epoll_manager.h>
 #include <kernel/vfs/error.h>
 #include <kernel/vfs/fs_mount.h>
 #include <kernel/vfs/fs_type.h>
+#include <kernel/vfs/io_vector.h>
 #include <kernel/vfs/open_file.h>
+#include <kernel/vfs/open_file_ref.h>
 #include <kernel/vfs/open_flags.h>
+#include <kernel/vfs/page_cache.h>
 #include <kernel/vfs/pipe_manager.h>
+#include <kernel/vfs/poll_notifier.h>
 #include <kernel/vfs/seek_type.h>
 #include <kernel/vfs/vnode.h>
 #include <stddef.h>
 
+#define VFS_CURRENT_POSITION -1
+#define VFS_SPLICE_BUFFER_SIZE (1 << 16)
+#define VFS_VNODE_KEY_MULTIPLIER 0x9E3779B97F4A7C15
+#define VFS_INVALID_VNODE -1
+
 namespace influx {
 namespace vfs {
 class vfs {
@@ -25,6 +37,7 @@ class vfs {
     vfs();
 
     bool mount(fs_type type, path mount_path, drivers::ata::drive_slice drive);
+    void start_flusher_thread();
 
     int64_t open(const path& file_path, open_flags flags,
                  file_permissions permissions = {.raw = 0});
@@ -34,8 +47,17 @@ class vfs {
     int64_t stat(const path& file_path, file_info& info);
 
     int64_t seek(size_t fd, int64_t offset, seek_type type);
-    int64_t read(size_t fd, void* buf, size_t count);
-    int64_t write(size_t fd, const void* buf, size_t count);
+    int64_t read(size_t fd, void* buf, size_t count, int64_t offset = VFS_CURRENT_POSITION);
+    int64_t write(size_t fd, const void* buf, size_t count,
+                  int64_t offset = VFS_CURRENT_POSITION);
+    int64_t readv(size_t fd, const io_vector* vectors, size_t vector_count,
+                  int64_t offset = VFS_CURRENT_POSITION);
+    int64_t writev(size_t fd, const io_vector* vectors, size_t vector_count,
+                   int64_t offset = VFS_CURRENT_POSITION);
+    int64_t splice(size_t in_fd, int64_t in_offset, size_t out_fd, int64_t out_offset,
+                   size_t count);
+    int64_t sync(size_t fd);
+    int64_t poll(size_t fd, poll_listener* listener);
 
     int64_t mkdir(const path& dir_path, file_permissions permissions);
     int64_t get_dir_entries(size_t fd, structures::vector<dir_entry>& entries,
@@ -46,9 +68,11 @@ class vfs {
     filesystem* get_filesystem(size_t fd);
     int64_t get_vnode_index(size_t fd);
 
-    void fork_file_descriptors(structures::unique_hash_map<open_file>& file_descriptors);
+    error get_open_file_for_fd(int64_t fd, open_file_ref& file);
+    void release_open_file(open_file* file);
 
     inline pipe_manager* pipe_handler() { return &_pipe_manager; };
+    inline epoll_manager* epoll_handler() { return &_epoll_manager; };
 
     static uint64_t dirent_size_for_dir_entry(dir_entry& entry);
 
@@ -56,15 +80,19 @@ class vfs {
     logger _log;
 
     structures::vector<fs_mount> _mounts;
-    threading::mutex _mounts_mutex;
+    threading::shared_mutex _mounts_mutex;
 
     structures::unique_hash_map<vnode> _vnodes;
+    structures::hash_map<uint64_t, int64_t> _vnodes_table;
     structures::hash_map<uint64_t, path> _deleted_vnodes_paths;
     threading::mutex _vnodes_mutex;
+    uint64_t _released_vnodes;
 
-    pipe_manager _pipe_manager;
+    dentry_cache _dentry_cache;
+    page_cache _page_cache;
 
-    error get_open_file_for_fd(int64_t fd, open_file& file);
+    pipe_manager _pipe_manager;
+    epoll_manager _epoll_manager;
 
     error get_vnode_for_file(filesystem* fs, void* fs_file_data,
                              structures::pair<uint64_t, structures::reference_wrapper<vnode>>& vn);
@@ -73,12 +101,23 @@ class vfs {
         structures::pair<uint64_t, structures::reference_wrapper<vnode>>& vn);
 
     filesystem* get_fs_for_file(const path& file_path);
+    error get_file_info_for_path(filesystem* fs, const path& file_path, void* fs_file_data,
+                                 file_info& file);
 
     void close_open_file(const open_file& file);
+    void put_vnode(uint64_t vnode_index);
+    void release_vnode(uint64_t vnode_index);
+    void reap_cached_vnodes();
+
+    void flusher_thread();
+
+    static bool vnode_cacheable(const vnode& vn);
+    static uint64_t vnode_key(filesystem* fs, void* fs_file_data);
 
     friend class influx::tty::tty_manager;
     friend class influx::threading::scheduler;
     friend class influx::vfs::pipe_manager;
+    friend class influx::vfs::epoll_manager;
 };
 };  // namespace vfs
 };  // namespace influx
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
+#include <kernel/structures/radix_tree.h>
 #include <kernel/threading/mutex.h>
+#include <kernel/vfs/cached_page.h>
 #include <kernel/vfs/file_info.h>
 #include <kernel/vfs/filesystem.h>
 #include <stdint.h>
@@ -7,15 +9,22 @@
 namespace influx {
 namespace vfs {
 struct vnode {
-    inline vnode() : deleted(false), amount_of_open_files(0), fs_data(nullptr) {}
+    inline vnode() : deleted(false), amount_of_open_files(0), fs_data(nullptr), hash_next(-1) {}
     inline vnode(file_info file_, filesystem *fs_, void *fs_data_)
-        : file(file_), fs(fs_), deleted(false), amount_of_open_files(0), fs_data(fs_data_) {}
+        : file(file_),
+          fs(fs_),
+          deleted(false),
+          amount_of_open_files(0),
+          fs_data(fs_data_),
+          hash_next(-1) {}
     inline vnode(const vnode &other)
         : file(other.file),
           fs(other.fs),
           deleted(other.deleted),
           amount_of_open_files(other.amount_of_open_files),
-          fs_data(other.fs_data) {}
+          fs_data(other.fs_data),
+          hash_next(other.hash_next),
+          pages(other.pages) {}
 
     inline vnode &operator=(vnode &other) {
         file = other.file;
@@ -23,6 +32,8 @@ struct vnode {
         deleted = other.deleted;
         amount_of_open_files = other.amount_of_open_files;
         fs_data = other.fs_data;
+        hash_next = other.hash_next;
+        pages = other.pages;
 
         return *this;
     }
@@ -32,7 +43,9 @@ struct vnode {
     bool deleted;
     uint64_t amount_of_open_files;
     void *fs_data;
+    int64_t hash_next;  // The next vnode with the same key in the vnodes table
     threading::mutex file_mutex;
+    structures::radix_tree<cached_page> pages;
 };
 };  // namespace vfs
 };  // namespace influx
\ No newline at end of file
@@ -34,10 +34,16 @@ typedef struct boot_info_framebuffer {
     uint8_t framebuffer_bpp;
 } boot_info_framebuffer;
 
+typedef struct boot_info_acpi {
+    uint64_t rsdt_address;
+    uint64_t xsdt_address;
+} boot_info_acpi;
+
 typedef struct boot_info {
     boot_info_kernel_module kernel_module;
     boot_info_mem memory;
     boot_info_framebuffer framebuffer;
+    boot_info_acpi acpi;
     uint64_t tss_address;
     char *cmdline;
 } boot_info;
\ No newline at end of file
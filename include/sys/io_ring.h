@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+// The ring is mapped right after the time page
+#define IO_RING_ADDRESS 0x7FFF00001000
+
+#define IO_RING_MAX_ENTRIES 128
+
+#define IO_RING_OP_NOP 0
+#define IO_RING_OP_READ 1
+#define IO_RING_OP_WRITE 2
+#define IO_RING_OP_PREAD 3
+#define IO_RING_OP_PWRITE 4
+#define IO_RING_OP_OPEN 5
+#define IO_RING_OP_CLOSE 6
+#define IO_RING_OP_FSYNC 7
+#define IO_RING_OP_POLL 8
+
+// A submission queue entry, the meaning of the fields depends on the opcode:
+// read/write:   fd, addr = buffer, length
+// pread/pwrite: fd, addr = buffer, length, offset
+// open:         addr = path, op_flags = open flags, length = mode
+// close/fsync:  fd
+// poll:         fd, op_flags = poll events
+typedef struct io_ring_sqe {
+    uint8_t opcode;
+    uint8_t reserved[3];
+    int32_t fd;
+    uint64_t offset;
+    uint64_t addr;
+    uint64_t length;
+    uint32_t op_flags;
+    uint32_t reserved2;
+    uint64_t user_data;
+} io_ring_sqe_t;
+
+// A completion queue entry, the result is the return value of the matching syscall
+typedef struct io_ring_cqe {
+    uint64_t user_data;
+    int64_t result;
+} io_ring_cqe_t;
+
+// Userland fills entries at the submission tail and consumes entries from the completion head,
+// the kernel advances the submission head and the completion tail.
+// The indices only grow, the entry of an index is at (index & (entries - 1)).
+typedef struct io_ring {
+    volatile uint32_t sq_head;
+    volatile uint32_t sq_tail;
+    volatile uint32_t cq_head;
+    volatile uint32_t cq_tail;
+    uint32_t sq_entries;
+    uint32_t cq_entries;
+    io_ring_sqe_t sqes[IO_RING_MAX_ENTRIES];
+    io_ring_cqe_t cqes[IO_RING_MAX_ENTRIES * 2];
+} io_ring_t;
\ No newline at end of file
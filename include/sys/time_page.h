@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+#define TIME_PAGE_ADDRESS 0x7FFF00000000
+
+#define TIME_PAGE_MODE_SYSCALL 0
+#define TIME_PAGE_MODE_TSC 1
+
+#define TIME_PAGE_NSECONDS_IN_SECOND 1000000000
+
+typedef struct time_page {
+    volatile uint32_t sequence;
+    uint32_t mode;
+    uint64_t base_count;
+    uint64_t mult;
+    uint64_t shift;
+    uint64_t realtime_offset_ns;
+} time_page_t;
+
+// Reads the monotonic and realtime clocks from the time page without a syscall.
+// Returns 0 if the page can't be used and the clock_gettime syscall should be used instead.
+static inline int time_page_read(const time_page_t *page, uint64_t *monotonic_ns,
+                                 uint64_t *realtime_ns) {
+    uint32_t sequence, low, high;
+    uint64_t count, ns, offset;
+
+    do {
+        // Wait for the kernel to finish updating the page
+        while ((sequence = page->sequence) & 1) {
+            __asm__ __volatile__("pause");
+        }
+        __asm__ __volatile__("" ::: "memory");
+
+        if (page->mode != TIME_PAGE_MODE_TSC) {
+            return 0;
+        }
+
+        __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+        count = ((uint64_t)high << 32) | low;
+
+        ns = (uint64_t)(((unsigned __int128)(count - page->base_count) * page->mult) >>
+                        page->shift);
+        offset = page->realtime_offset_ns;
+
+        __asm__ __volatile__("" ::: "memory");
+    } while (page->sequence != sequence);
+
+    if (monotonic_ns != 0) {
+        *monotonic_ns = ns;
+    }
+    if (realtime_ns != 0) {
+        *realtime_ns = offset + ns;
+    }
+
+    return 1;
+}
\ No newline at end of file
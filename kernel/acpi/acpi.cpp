@@ -0,0 +1,129 @@
+#include <kernel/acpi/acpi.h>
+
+#include <kernel/logger.h>
+#include <kernel/memory/virtual_allocator.h>
+#include <memory/paging.h>
+
+void influx::acpi::init(const boot_info_acpi &info) {
+    logger log("ACPI", console_color::green);
+
+    // Prefer the XSDT since it contains 64-bit addresses
+    if (info.xsdt_address != 0) {
+        _root_table = map_table(info.xsdt_address);
+        _extended_root_table = _root_table != nullptr;
+    }
+
+    // Fallback to the RSDT
+    if (_root_table == nullptr && info.rsdt_address != 0) {
+        _root_table = map_table(info.rsdt_address);
+    }
+
+    if (_root_table == nullptr) {
+        log("No valid ACPI root table was found.\n");
+    } else {
+        log("ACPI %s found in %p.\n", _extended_root_table ? "XSDT" : "RSDT", _root_table);
+    }
+}
+
+const acpi_sdt_header_t *influx::acpi::find_table(const char *signature) {
+    uint64_t entry_size = _extended_root_table ? sizeof(uint64_t) : sizeof(uint32_t);
+    uint64_t entries_count = 0, table_address = 0;
+
+    const acpi_sdt_header_t *table = nullptr;
+
+    if (_root_table == nullptr) {
+        return nullptr;
+    }
+
+    // For each table in the root table
+    entries_count = (_root_table->length - sizeof(acpi_sdt_header_t)) / entry_size;
+    for (uint64_t i = 0; i < entries_count; i++) {
+        // Get the physical address of the table
+        const uint8_t *entry = (const uint8_t *)(_root_table + 1) + i * entry_size;
+        table_address = _extended_root_table ? *(const uint64_t *)entry : *(const uint32_t *)entry;
+
+        // Map the table and check its signature
+        table = map_table(table_address);
+        if (table != nullptr && table->signature[0] == signature[0] &&
+            table->signature[1] == signature[1] && table->signature[2] == signature[2] &&
+            table->signature[3] == signature[3]) {
+            return table;
+        }
+
+        // Unmap tables that don't match
+        if (table != nullptr) {
+            unmap_physical(table, table->length);
+        }
+    }
+
+    return nullptr;
+}
+
+void *influx::acpi::map_physical(uint64_t physical_address, uint64_t size) {
+    uint64_t offset = physical_address % PAGE_SIZE;
+    uint64_t pages_size = (offset + size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+    // Map the physical pages to virtual memory
+    uint8_t *pages =
+        (uint8_t *)memory::virtual_allocator::allocate(pages_size, PROT_READ,
+                                                       (int64_t)(physical_address / PAGE_SIZE));
+    if (pages == nullptr) {
+        return nullptr;
+    }
+
+    return pages + offset;
+}
+
+void influx::acpi::unmap_physical(const void *ptr, uint64_t size) {
+    memory::virtual_allocator::unmap((void *)ptr, size);
+}
+
+const acpi_sdt_header_t *influx::acpi::map_table(uint64_t physical_address) {
+    // Map the header of the table to get its length
+    const acpi_sdt_header_t *header =
+        (const acpi_sdt_header_t *)map_physical(physical_address, sizeof(acpi_sdt_header_t));
+    uint64_t offset = physical_address % PAGE_SIZE;
+    uint64_t header_pages_size =
+        (offset + sizeof(acpi_sdt_header_t) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    uint32_t length = 0;
+
+    if (header == nullptr) {
+        return nullptr;
+    }
+
+    // Tables must contain at least their header
+    length = header->length;
+    if (length < sizeof(acpi_sdt_header_t)) {
+        unmap_physical(header, sizeof(acpi_sdt_header_t));
+        return nullptr;
+    }
+
+    // Replace the mapping of the header with a mapping of the entire table if it exceeds the
+    // mapped pages
+    if (offset + length > header_pages_size) {
+        unmap_physical(header, sizeof(acpi_sdt_header_t));
+        header = (const acpi_sdt_header_t *)map_physical(physical_address, length);
+        if (header == nullptr) {
+            return nullptr;
+        }
+    }
+
+    // Unmap invalid tables
+    if (!validate_table(header)) {
+        unmap_physical(header, length);
+        return nullptr;
+    }
+
+    return header;
+}
+
+bool influx::acpi::validate_table(const acpi_sdt_header_t *table) {
+    uint8_t sum = 0;
+
+    // The sum of all the bytes in the table should be 0
+    for (uint32_t i = 0; i < table->length; i++) {
+        sum = (uint8_t)(sum + ((const uint8_t *)table)[i]);
+    }
+
+    return sum == 0;
+}
\ No newline at end of file
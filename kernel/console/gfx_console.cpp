@@ -25,7 +25,8 @@ influx::gfx_console::gfx_console(const boot_info_framebuffer &multiboot_framebuf
       _multiboot_framebuffer(multiboot_framebuffer),
       _framebuffer(nullptr),
       _framebuffer_height(),
-      _framebuffer_width(0) {}
+      _framebuffer_width(0),
+      _mutex("gfx console") {}
 
 bool influx::gfx_console::load() {
     influx::drivers::graphics::bga *bga_driver =
@@ -9,7 +9,7 @@
 #include <kernel/threading/scheduler_started.h>
 #include <kernel/threading/unique_lock.h>
 
-influx::drivers::ata::ata::ata() : driver("ATA") {}
+influx::drivers::ata::ata::ata() : driver("ATA"), _mutex("ata") {}
 
 bool influx::drivers::ata::ata::load() {
     threading::lock_guard lk(_mutex);
@@ -41,11 +41,25 @@ bool influx::drivers::ata::ata::load() {
 }
 
 bool influx::drivers::ata::ata::wait_for_primary_irq(bool interruptible) {
-    return kernel::interrupt_manager()->wait_for_irq(ATA_PRIMARY_IRQ, interruptible);
+    // IRQs can't be waited for before the scheduler is started, so poll the status instead
+    if (!threading::scheduler_started) {
+        return !read_status_register_with_mask(ata_primary_bus, ATA_STATUS_BSY, 0, 30000)
+                    .fetch_failed;
+    }
+
+    return kernel::interrupt_manager()->wait_for_irq(ATA_PRIMARY_IRQ, interruptible,
+                                                     ATA_IRQ_TIMEOUT_MS);
 }
 
 bool influx::drivers::ata::ata::wait_for_secondary_irq(bool interruptible) {
-    return kernel::interrupt_manager()->wait_for_irq(ATA_SECONDARY_IRQ, interruptible);
+    // IRQs can't be waited for before the scheduler is started, so poll the status instead
+    if (!threading::scheduler_started) {
+        return !read_status_register_with_mask(ata_secondary_bus, ATA_STATUS_BSY, 0, 30000)
+                    .fetch_failed;
+    }
+
+    return kernel::interrupt_manager()->wait_for_irq(ATA_SECONDARY_IRQ, interruptible,
+                                                     ATA_IRQ_TIMEOUT_MS);
 }
 
 void influx::drivers::ata::ata::detect_drives() {
@@ -80,7 +94,7 @@ uint16_t influx::drivers::ata::ata::access_drive_sectors(
     const influx::drivers::ata::drive &drive, influx::drivers::ata::access_type access_type,
     uint32_t lba, uint16_t amount_of_sectors, uint16_t *data, bool interruptible) {
     threading::lock_guard lk(_mutex);
-    bool interrupted = false;
+    bool irq_received = false;
 
     status_register status_reg;
     uint16_t sectors = 0;
@@ -105,6 +119,10 @@ uint16_t influx::drivers::ata::ata::access_drive_sectors(
     ports::out<uint8_t>((uint8_t)(lba >> 16),
                         (uint16_t)(drive.controller.io_base + ATA_IO_HCYL_REGISTER));
 
+    // Drop IRQs of previous commands that weren't waited for, such as the cache flush IRQ
+    kernel::interrupt_manager()->reset_irq(drive.controller == ata_primary_bus ? ATA_PRIMARY_IRQ
+                                                                               : ATA_SECONDARY_IRQ);
+
     // Send the access command
     ports::out<uint8_t>(
         (uint8_t)(access_type == access_type::read ? command::read : command::write),
@@ -112,16 +130,17 @@ uint16_t influx::drivers::ata::ata::access_drive_sectors(
 
     // For each sector
     for (uint16_t sector = 0; sector < amount_of_sectors; sector++) {
-        // Wait for the controller to finish loading the drive and check if there are errors
-        if ((status_reg =
-                 read_status_register_with_mask(drive.controller, ATA_STATUS_BSY, 0, 30000))
-                .fetch_failed ||
-            status_reg.err) {
-            return 0;
-        }
-
         // If this is a write operation
         if (access_type == access_type::write) {
+            // Wait for the controller to be ready for the sector's data, the drive doesn't send an
+            // IRQ before the first sector of a write
+            if ((status_reg =
+                     read_status_register_with_mask(drive.controller, ATA_STATUS_BSY, 0, 30000))
+                    .fetch_failed ||
+                status_reg.err) {
+                return 0;
+            }
+
             for (uint64_t i = (sector * ATA_SECTOR_SIZE) / sizeof(uint16_t);
                  i < ((sector + 1) * ATA_SECTOR_SIZE) / sizeof(uint16_t); i++) {
                 ports::out<uint16_t>(data[i],
@@ -129,11 +148,16 @@ uint16_t influx::drivers::ata::ata::access_drive_sectors(
             }
         }
 
-        // Wait for IRQ
+        // Sleep until the IRQ of the sector or until the timeout instead of polling the status
         if (drive.controller == ata_primary_bus) {
-            interrupted = !wait_for_primary_irq(interruptible);
+            irq_received = wait_for_primary_irq(interruptible);
         } else {
-            interrupted = !wait_for_secondary_irq(interruptible);
+            irq_received = wait_for_secondary_irq(interruptible);
+        }
+
+        // If the wait was interrupted by a signal or timed out, stop
+        if (!irq_received) {
+            break;
         }
 
         // If an error occurred
@@ -152,11 +176,6 @@ uint16_t influx::drivers::ata::ata::access_drive_sectors(
 
         // Increase amount of accessed sectors
         sectors++;
-
-        // If was interrupted by a signal, stop
-        if (interrupted && interruptible) {
-            break;
-        }
     }
 
     // Flush cache after write
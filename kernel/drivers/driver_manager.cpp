@@ -6,6 +6,7 @@
 #include <kernel/drivers/pci.h>
 #include <kernel/drivers/ps2_keyboard.h>
 #include <kernel/drivers/time/cmos.h>
+#include <kernel/drivers/time/hpet.h>
 #include <kernel/drivers/time/pit.h>
 
 influx::drivers::driver_manager::driver_manager() : _log("Driver Manager", console_color::green) {
@@ -14,6 +15,7 @@ influx::drivers::driver_manager::driver_manager() : _log("Driver Manager", conso
     _drivers.push_back(new ata::ata());
     _drivers.push_back(new graphics::bga());
     _drivers.push_back(new cmos());
+    _drivers.push_back(new hpet());
     _drivers.push_back(new ps2_keyboard());
 }
 
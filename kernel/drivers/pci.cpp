@@ -1,5 +1,7 @@
 #include <kernel/drivers/pci.h>
 
+#include <kernel/interrupts/apic.h>
+#include <kernel/kernel.h>
 #include <kernel/ports.h>
 
 influx::drivers::pci::pci() : driver("PCI") {}
@@ -93,6 +95,87 @@ const influx::structures::vector<pci_descriptor_t> &influx::drivers::pci::descri
     return _descriptors;
 }
 
+uint8_t influx::drivers::pci::find_capability(const pci_descriptor_t &descriptor,
+                                              uint8_t capability_id) {
+    uint8_t capability = 0;
+
+    // Check if the function has a capabilities list
+    if (!(read_config_word(descriptor.bus, descriptor.device, descriptor.function, STATUS_OFFSET) &
+          STATUS_CAPABILITIES_LIST)) {
+        return 0;
+    }
+
+    // Walk the capabilities list
+    capability = read_config_byte(descriptor.bus, descriptor.device, descriptor.function,
+                                  CAPABILITIES_POINTER_OFFSET) &
+                 0xFC;
+    while (capability != 0) {
+        if (read_config_byte(descriptor.bus, descriptor.device, descriptor.function, capability) ==
+            capability_id) {
+            return capability;
+        }
+
+        capability = read_config_byte(descriptor.bus, descriptor.device, descriptor.function,
+                                      (uint8_t)(capability + 1)) &
+                     0xFC;
+    }
+
+    return 0;
+}
+
+int16_t influx::drivers::pci::enable_msi(const pci_descriptor_t &descriptor,
+                                         uint64_t msi_handler_address, void *msi_handler_data) {
+    uint8_t capability = find_capability(descriptor, CAPABILITY_ID_MSI);
+    uint64_t address = 0;
+    uint16_t control = 0, command = 0;
+    int16_t vector = -1;
+
+    // Check if the function supports MSI
+    if (capability == 0) {
+        return -1;
+    }
+
+    // Allocate an interrupt vector for the MSI
+    vector = kernel::interrupt_manager()->allocate_msi_vector(msi_handler_address,
+                                                              msi_handler_data);
+    if (vector < 0) {
+        return -1;
+    }
+    address = interrupts::apic::msi_address();
+
+    // Set the message address and data
+    control = read_config_word(descriptor.bus, descriptor.device, descriptor.function,
+                               (uint8_t)(capability + MSI_CONTROL_OFFSET));
+    write_config_dword(descriptor.bus, descriptor.device, descriptor.function,
+                       (uint8_t)(capability + MSI_ADDRESS_LOW_OFFSET), (uint32_t)address);
+    if (control & MSI_CONTROL_64_BIT) {
+        write_config_dword(descriptor.bus, descriptor.device, descriptor.function,
+                           (uint8_t)(capability + MSI_ADDRESS_HIGH_OFFSET),
+                           (uint32_t)(address >> 32));
+        write_config_word(descriptor.bus, descriptor.device, descriptor.function,
+                          (uint8_t)(capability + MSI_DATA_64_OFFSET), (uint16_t)vector);
+    } else {
+        write_config_word(descriptor.bus, descriptor.device, descriptor.function,
+                          (uint8_t)(capability + MSI_DATA_32_OFFSET), (uint16_t)vector);
+    }
+
+    // Enable a single message
+    control = (uint16_t)((control & ~MSI_CONTROL_MULTIPLE_MESSAGE_ENABLE_MASK) | MSI_CONTROL_ENABLE);
+    write_config_word(descriptor.bus, descriptor.device, descriptor.function,
+                      (uint8_t)(capability + MSI_CONTROL_OFFSET), control);
+
+    // Disable the legacy interrupt pin of the function
+    command =
+        read_config_word(descriptor.bus, descriptor.device, descriptor.function, COMMAND_OFFSET);
+    write_config_word(descriptor.bus, descriptor.device, descriptor.function, COMMAND_OFFSET,
+                      (uint16_t)(command | COMMAND_INTERRUPT_DISABLE));
+
+    _log("MSI enabled for device %d:%d:%d with interrupt %x.\n", descriptor.bus,
+         descriptor.device, descriptor.function, vector);
+
+    return vector;
+}
+
 uint32_t influx::drivers::pci::calc_address(uint16_t bus, uint8_t device, uint8_t function,
                                             uint8_t offset) {
     return (1 << 31)                      // Enable bit
@@ -0,0 +1,50 @@
+#include <kernel/drivers/time/hpet.h>
+
+#include <kernel/acpi/acpi.h>
+#include <kernel/memory/virtual_allocator.h>
+
+influx::drivers::hpet::hpet() : driver("HPET"), _registers(nullptr), _frequency(0) {}
+
+bool influx::drivers::hpet::load() {
+    uint64_t capabilities = 0, period = 0;
+
+    // Find the HPET table
+    const acpi_hpet_t *hpet_table = (const acpi_hpet_t *)acpi::find_table(ACPI_HPET_SIGNATURE);
+    if (hpet_table == nullptr ||
+        hpet_table->base_address.address_space_id != ACPI_ADDRESS_SPACE_SYSTEM_MEMORY) {
+        _log("HPET wasn't found.\n");
+        return false;
+    }
+
+    // Map the HPET registers
+    _registers = (volatile uint64_t *)memory::virtual_allocator::map_io(
+        hpet_table->base_address.address, HPET_REGISTERS_SIZE);
+    if (_registers == nullptr) {
+        return false;
+    }
+
+    // A 32-bit main counter would wrap too fast to be used as a clocksource
+    capabilities = _registers[HPET_CAPABILITIES_REGISTER / sizeof(uint64_t)];
+    if (!(capabilities & HPET_CAPABILITIES_64_BIT_COUNTER)) {
+        _log("HPET main counter isn't 64-bit.\n");
+        return false;
+    }
+
+    // Get the period of the main counter in femtoseconds
+    period = capabilities >> HPET_CAPABILITIES_PERIOD_SHIFT;
+    if (period == 0) {
+        return false;
+    }
+    _frequency = FEMTOSECONDS_IN_SECOND / period;
+
+    // Start the main counter
+    _registers[HPET_CONFIGURATION_REGISTER / sizeof(uint64_t)] |= HPET_CONFIGURATION_ENABLE;
+    _log("HPET (%p) main counter started with a frequency of %d Hz.\n",
+         hpet_table->base_address.address, _frequency);
+
+    return true;
+}
+
+uint64_t influx::drivers::hpet::main_counter() const {
+    return _registers[HPET_MAIN_COUNTER_REGISTER / sizeof(uint64_t)];
+}
\ No newline at end of file
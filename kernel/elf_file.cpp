@@ -14,7 +14,7 @@ bool influx::elf_file::parse() {
     file_segment seg;
 
     // Read the header from the file
-    if (kernel::vfs()->read(_fd, &header, sizeof(Elf64_Ehdr)) < 0) {
+    if (kernel::vfs()->read(_fd, &header, sizeof(Elf64_Ehdr), 0) < 0) {
         return false;
     }
 
@@ -28,17 +28,11 @@ bool influx::elf_file::parse() {
     // Save the entry address
     _entry_address = header.e_entry;
 
-    // Seek the file to the program header table
-    if (kernel::vfs()->seek(_fd, header.e_phoff, vfs::seek_type::set) < 0) {
-        return false;
-    }
-
     // Read program headers
     for (uint64_t i = 0; i < header.e_phnum; i++) {
         // Read the program header
-        if (kernel::vfs()->seek(_fd, header.e_phoff + i * sizeof(Elf64_Phdr), vfs::seek_type::set) <
-                0 ||
-            kernel::vfs()->read(_fd, &program_header, sizeof(Elf64_Phdr)) < 0) {
+        if (kernel::vfs()->read(_fd, &program_header, sizeof(Elf64_Phdr),
+                                (int64_t)(header.e_phoff + i * sizeof(Elf64_Phdr))) < 0) {
             return false;
         }
 
@@ -54,8 +48,8 @@ bool influx::elf_file::parse() {
 
             // Read segment data
             if (program_header.p_filesz > 0 &&
-                (kernel::vfs()->seek(_fd, program_header.p_offset, vfs::seek_type::set) < 0 ||
-                 kernel::vfs()->read(_fd, seg.data.data(), program_header.p_filesz) < 0)) {
+                kernel::vfs()->read(_fd, seg.data.data(), program_header.p_filesz,
+                                    (int64_t)program_header.p_offset) < 0) {
                 return false;
             }
 
@@ -4,6 +4,7 @@
 #include <kernel/kernel.h>
 #include <kernel/memory/utils.h>
 #include <kernel/threading/lock_guard.h>
+#include <kernel/threading/shared_lock.h>
 #include <kernel/threading/unique_lock.h>
 #include <kernel/time/time_manager.h>
 
@@ -12,7 +13,7 @@
 #define EXT2_TIND_N_BLOCKS (EXT2_IND_N_BLOCKS * EXT2_DIND_N_BLOCKS)
 
 influx::fs::ext2::ext2(const influx::drivers::ata::drive_slice &drive)
-    : vfs::filesystem("EXT2", drive), _block_size(0) {}
+    : vfs::filesystem("EXT2", drive), _sb_mutex("ext2 superblock"), _block_size(0) {}
 
 bool influx::fs::ext2::mount(const influx::vfs::path &mount_path) {
     uint32_t number_of_groups = 0;
@@ -69,7 +70,8 @@ bool influx::fs::ext2::mount(const influx::vfs::path &mount_path) {
 }
 
 influx::vfs::error influx::fs::ext2::read(void *fs_file_info, char *buffer, size_t count,
-                                          size_t offset, size_t &amount_read) {
+                                          size_t offset, size_t &amount_read,
+                                          vfs::open_flags flags) {
     kassert(fs_file_info != nullptr && buffer != nullptr);
 
     structures::dynamic_buffer buf;
@@ -104,8 +106,10 @@ influx::vfs::error influx::fs::ext2::read(void *fs_file_info, char *buffer, size
     // Set the amount read variable
     amount_read = buf.size();
 
-    // Copy to the buffer
-    memory::utils::memcpy(buffer, buf.data(), buf.size());
+    // Copy to the buffer, which may be an invalid user buffer
+    if (memory::utils::memcpy_fault_safe(buffer, buf.data(), buf.size()) != 0) {
+        return vfs::error::bad_address;
+    }
 
     // Save the inode
     if (!save_inode(*(uint32_t *)fs_file_info, inode)) {
@@ -116,7 +120,8 @@ influx::vfs::error influx::fs::ext2::read(void *fs_file_info, char *buffer, size
 }
 
 influx::vfs::error influx::fs::ext2::write(void *fs_file_info, const char *buffer, size_t count,
-                                           size_t offset, size_t &amount_written) {
+                                           size_t offset, size_t &amount_written,
+                                           vfs::open_flags flags) {
     kassert(fs_file_info != nullptr && buffer != nullptr && count > 0);
 
     structures::dynamic_buffer buf(count);
@@ -132,8 +137,10 @@ influx::vfs::error influx::fs::ext2::write(void *fs_file_info, const char *buffe
         return vfs::error::file_is_directory;
     }
 
-    // Copy to the buffer
-    memory::utils::memcpy(buf.data(), buffer, buf.size());
+    // Copy from the buffer, which may be an invalid user buffer
+    if (memory::utils::memcpy_fault_safe(buf.data(), buffer, buf.size()) != 0) {
+        return vfs::error::bad_address;
+    }
 
     // Try to write to the file
     amount_written = write_file(inode, offset, buf);
@@ -154,6 +161,116 @@ influx::vfs::error influx::fs::ext2::write(void *fs_file_info, const char *buffe
     return vfs::error::success;
 }
 
+influx::vfs::error influx::fs::ext2::readv(void *fs_file_info, const vfs::io_vector *vectors,
+                                           size_t vector_count, size_t count, size_t offset,
+                                           size_t &amount_read, vfs::open_flags flags) {
+    kassert(fs_file_info != nullptr && vectors != nullptr);
+
+    structures::dynamic_buffer buf;
+    size_t copied = 0, vector_amount = 0;
+
+    // Get the inode of the file
+    ext2_inode *inode = get_inode(*(uint32_t *)fs_file_info);
+    if (!inode) {
+        return vfs::error::invalid_file;
+    }
+
+    // Check if the file is a directory
+    if (file_type_for_inode(inode) == vfs::file_type::directory) {
+        return vfs::error::file_is_directory;
+    }
+
+    // If the offset + the amount of bytes surpasses the size of the file, reduce the count
+    if (offset + count > inode->size) {
+        count = offset > inode->size ? 0 : inode->size - offset;
+    }
+
+    // Read the whole range of the file at once
+    buf = read_file(inode, offset, count);
+    if (buf.empty() && count > 0) {
+        // If the task was interrupted
+        if (kernel::scheduler()->interrupted()) {
+            return vfs::error::interrupted;
+        } else {
+            return vfs::error::io_error;
+        }
+    }
+
+    // Scatter the data to the vectors, which may be invalid user buffers
+    for (size_t i = 0; i < vector_count && copied < buf.size(); i++) {
+        vector_amount = algorithm::min<size_t>(vectors[i].length, buf.size() - copied);
+        if (memory::utils::memcpy_fault_safe(vectors[i].base, buf.data() + copied,
+                                             vector_amount) != 0) {
+            return vfs::error::bad_address;
+        }
+        copied += vector_amount;
+    }
+
+    // Set the amount read variable
+    amount_read = copied;
+
+    // Save the inode
+    if (!save_inode(*(uint32_t *)fs_file_info, inode)) {
+        return vfs::error::io_error;
+    }
+
+    return vfs::error::success;
+}
+
+influx::vfs::error influx::fs::ext2::writev(void *fs_file_info, const vfs::io_vector *vectors,
+                                            size_t vector_count, size_t count, size_t offset,
+                                            size_t &amount_written, vfs::open_flags flags) {
+    kassert(fs_file_info != nullptr && vectors != nullptr);
+
+    structures::dynamic_buffer buf(count);
+    size_t copied = 0, vector_amount = 0;
+
+    // Nothing to write
+    if (count == 0) {
+        amount_written = 0;
+        return vfs::error::success;
+    }
+
+    // Get the inode of the file
+    ext2_inode *inode = get_inode(*(uint32_t *)fs_file_info);
+    if (!inode) {
+        return vfs::error::invalid_file;
+    }
+
+    // Check if the file is a directory
+    if (file_type_for_inode(inode) == vfs::file_type::directory) {
+        return vfs::error::file_is_directory;
+    }
+
+    // Gather the vectors to the buffer, which may be invalid user buffers
+    for (size_t i = 0; i < vector_count && copied < count; i++) {
+        vector_amount = algorithm::min<size_t>(vectors[i].length, count - copied);
+        if (memory::utils::memcpy_fault_safe(buf.data() + copied, vectors[i].base,
+                                             vector_amount) != 0) {
+            return vfs::error::bad_address;
+        }
+        copied += vector_amount;
+    }
+
+    // Try to write the whole range to the file at once
+    amount_written = write_file(inode, offset, buf);
+    if (amount_written == 0) {
+        // If the task was interrupted
+        if (kernel::scheduler()->interrupted()) {
+            return vfs::error::interrupted;
+        } else {
+            return vfs::error::io_error;
+        }
+    }
+
+    // Save the inode
+    if (!save_inode(*(uint32_t *)fs_file_info, inode)) {
+        return vfs::error::io_error;
+    }
+
+    return vfs::error::success;
+}
+
 influx::vfs::error influx::fs::ext2::get_file_info(void *fs_file_info,
                                                    influx::vfs::file_info &file) {
     kassert(fs_file_info != nullptr);
@@ -178,6 +295,8 @@ influx::vfs::error influx::fs::ext2::get_file_info(void *fs_file_info,
     file.accessed = inode->last_access_time;
     file.created = inode->creation_time;
 
+    delete inode;
+
     return vfs::error::success;
 }
 
@@ -388,11 +507,16 @@ influx::vfs::error influx::fs::ext2::create_dir(const influx::vfs::path &dir_pat
 }
 
 influx::vfs::error influx::fs::ext2::unlink_file(const influx::vfs::path &file_path) {
-    uint32_t inode = find_inode(file_path);
     uint32_t parent_inode = find_inode(file_path.parent_path());
+    uint32_t inode = EXT2_INVALID_INODE;
 
     ext2_inode *inode_obj = nullptr;
 
+    // Find the file in its parent directory instead of resolving the whole path again
+    if (parent_inode != EXT2_INVALID_INODE) {
+        inode = find_dir_entry_inode(parent_inode, file_path.base_name());
+    }
+
     // If the inode wasn't found
     if (inode == EXT2_INVALID_INODE || parent_inode == EXT2_INVALID_INODE) {
         return vfs::error::file_not_found;
@@ -443,10 +567,27 @@ void *influx::fs::ext2::get_fs_file_data(const influx::vfs::path &file_path) {
     return inode == EXT2_INVALID_INODE ? nullptr : new uint32_t(inode);
 }
 
+void *influx::fs::ext2::get_root_fs_file_data() { return new uint32_t(EXT2_ROOT_INO); }
+
+void *influx::fs::ext2::lookup_fs_file_data(void *dir_fs_file_data,
+                                            const influx::structures::string &name) {
+    uint32_t inode = find_dir_entry_inode(*(uint32_t *)dir_fs_file_data, name);
+
+    return inode == EXT2_INVALID_INODE ? nullptr : new uint32_t(inode);
+}
+
+void *influx::fs::ext2::duplicate_fs_file_data(void *fs_file_data) {
+    return new uint32_t(*(uint32_t *)fs_file_data);
+}
+
 bool influx::fs::ext2::compare_fs_file_data(void *fs_file_data_1, void *fs_file_data_2) {
     return *(uint32_t *)fs_file_data_1 == *(uint32_t *)fs_file_data_2;
 }
 
+uint64_t influx::fs::ext2::fs_file_data_key(void *fs_file_data) {
+    return *(uint32_t *)fs_file_data;
+}
+
 influx::structures::dynamic_buffer influx::fs::ext2::read_block(uint32_t block, uint64_t offset,
                                                                 int64_t amount) {
     amount = amount == -1 ? _block_size - offset : amount;
@@ -489,7 +630,7 @@ influx::fs::ext2_inode *influx::fs::ext2::get_inode(uint32_t inode) {
     uint32_t inode_block_index = (inode - 1) % (_block_size / _sb.inode_size);
     ext2_inode *inode_obj = new ext2_inode();
 
-    threading::lock_guard lk(_block_groups_mutexes[block_group]);
+    threading::shared_lock lk(_block_groups_mutexes[block_group]);
 
     // Read the inode
     if (_drive.read(
@@ -504,61 +645,53 @@ influx::fs::ext2_inode *influx::fs::ext2::get_inode(uint32_t inode) {
 }
 
 uint32_t influx::fs::ext2::find_inode(const influx::vfs::path &file_path) {
-    uint32_t inode = EXT2_INVALID_INODE, current_inode = EXT2_INVALID_INODE;
-    ext2_inode *current_inode_obj = nullptr;
-
-    structures::vector<vfs::dir_entry> dir_entries;
+    uint32_t inode = EXT2_INVALID_INODE;
 
     // For each branch try to find it's matching inode
     for (const auto &branch : file_path.branches()) {
-        // Save current inode
-        current_inode = inode;
-
-        // Get the inode object of the new inode
-        if (inode != EXT2_INVALID_INODE) {
-            current_inode_obj = get_inode(inode);
-            if (current_inode_obj == nullptr) {
-                return EXT2_INVALID_INODE;
-            }
-        }
-
         // If the current inode is null, it means the branch must be root
         if (inode == EXT2_INVALID_INODE && branch == "") {
             // Get the root inode
             inode = EXT2_ROOT_INO;
-        } else if (current_inode_obj != nullptr &&
-                   current_inode_obj->types_permissions &
-                       ext2_types_permissions::directory)  // Check that the inode is a directory
-        {
-            // Read directory
-            dir_entries = read_dir(current_inode_obj).first;
-
-            // Search for the wanted entry
-            for (const auto &entry : dir_entries) {
-                if (entry.name == branch) {
-                    inode = (uint32_t)entry.inode;
-                    break;
-                }
-            }
+        } else if (inode != EXT2_INVALID_INODE) {
+            // Search for the branch in the current directory
+            inode = find_dir_entry_inode(inode, branch);
+        }
 
-            // Branch not found
-            if (current_inode == inode) {
-                return EXT2_INVALID_INODE;
-            }
-        } else {
+        // Branch not found
+        if (inode == EXT2_INVALID_INODE) {
             return EXT2_INVALID_INODE;
         }
+    }
 
-        // Free previous inode
-        if (current_inode_obj != nullptr) {
-            delete current_inode_obj;
-            current_inode_obj = nullptr;
-        }
+    return inode;
+}
+
+uint32_t influx::fs::ext2::find_dir_entry_inode(uint32_t dir_inode,
+                                                const influx::structures::string &name) {
+    uint32_t inode = EXT2_INVALID_INODE;
+    ext2_inode *dir_inode_obj = get_inode(dir_inode);
+
+    structures::vector<vfs::dir_entry> dir_entries;
+
+    // Check that the inode is a directory
+    if (dir_inode_obj == nullptr) {
+        return EXT2_INVALID_INODE;
+    } else if (!(dir_inode_obj->types_permissions & ext2_types_permissions::directory)) {
+        delete dir_inode_obj;
+        return EXT2_INVALID_INODE;
     }
 
-    // Free inode object
-    if (current_inode_obj != nullptr) {
-        delete current_inode_obj;
+    // Read directory
+    dir_entries = read_dir(dir_inode_obj).first;
+    delete dir_inode_obj;
+
+    // Search for the wanted entry
+    for (const auto &entry : dir_entries) {
+        if (entry.name == name) {
+            inode = (uint32_t)entry.inode;
+            break;
+        }
     }
 
     return inode;
@@ -790,8 +923,6 @@ uint64_t influx::fs::ext2::write_file(influx::fs::ext2_inode *inode, uint64_t of
     uint64_t current_offset = 0, current_write_amount = 0;
 
     uint32_t current_block = EXT2_INVALID_BLOCK;
-    uint32_t size_change = (uint32_t)(
-        (buf.size() - (inode->size - offset)) > 0 ? (buf.size() - (inode->size - offset)) : 0);
 
     // Verify file offset
     if ((offset + buf.size() >=
@@ -825,9 +956,8 @@ uint64_t influx::fs::ext2::write_file(influx::fs::ext2_inode *inode, uint64_t of
 
     // Update file's size and disk sectors
     if (current_offset > 0) {
-        inode->size += (size_change - (amount - current_offset)) > 0
-                           ? (uint32_t)(size_change - (amount - current_offset))
-                           : 0;
+        // The file only grows if the data was written past its end
+        inode->size = (uint32_t)algorithm::max<uint64_t>(inode->size, offset + current_offset);
 
         // Update accessed and modified times of inode
         inode->last_access_time = (uint32_t)kernel::time_manager()->unix_timestamp();
@@ -0,0 +1,230 @@
+#include <kernel/interrupts/apic.h>
+
+#include <kernel/acpi/acpi.h>
+#include <kernel/memory/virtual_allocator.h>
+#include <kernel/msr.h>
+#include <memory/paging.h>
+
+bool influx::interrupts::apic::init() {
+    logger log("APIC", console_color::green);
+
+    // Find the MADT which describes the interrupt controllers
+    const acpi_madt_t *madt = (const acpi_madt_t *)acpi::find_table(ACPI_MADT_SIGNATURE);
+    if (madt == nullptr) {
+        log("MADT wasn't found, falling back to the PIC.\n");
+        return false;
+    }
+
+    // Parse the interrupt controllers from the MADT
+    if (!parse_madt(madt, log)) {
+        log("No I/O APIC was found, falling back to the PIC.\n");
+        return false;
+    }
+
+    // Enable the local APIC of the CPU
+    init_local_apic();
+    log("Local APIC (ID %d) enabled in %p.\n", local_apic_id(), _local_apic);
+
+    // Mask all the interrupts in the I/O APICs until they are routed
+    for (uint64_t i = 0; i < _ioapics_count; i++) {
+        init_ioapic(_ioapics[i]);
+    }
+
+    _enabled = true;
+
+    return true;
+}
+
+void influx::interrupts::apic::send_eoi() { write_local_apic(LAPIC_EOI_REGISTER, 0); }
+
+bool influx::interrupts::apic::route_irq(uint8_t irq, uint8_t vector) {
+    uint32_t redirection_flags = 0;
+    uint32_t global_system_interrupt = get_global_system_interrupt(irq, redirection_flags);
+    uint8_t entry = 0;
+
+    // Find the I/O APIC that handles the interrupt
+    ioapic *io_apic = get_ioapic(global_system_interrupt);
+    if (io_apic == nullptr) {
+        return false;
+    }
+    entry = (uint8_t)(global_system_interrupt - io_apic->global_system_interrupt_base);
+
+    // Set the destination to this CPU's local APIC before unmasking the entry
+    write_ioapic(*io_apic, (uint8_t)(IOAPIC_REDIRECTION_TABLE_REGISTER(entry) + 1),
+                 (uint32_t)local_apic_id() << 24);
+    write_ioapic(*io_apic, IOAPIC_REDIRECTION_TABLE_REGISTER(entry), vector | redirection_flags);
+
+    return true;
+}
+
+void influx::interrupts::apic::mask_irq(uint8_t irq) {
+    uint32_t redirection_flags = 0;
+    uint32_t global_system_interrupt = get_global_system_interrupt(irq, redirection_flags);
+    uint8_t entry = 0;
+
+    // Find the I/O APIC that handles the interrupt
+    ioapic *io_apic = get_ioapic(global_system_interrupt);
+    if (io_apic == nullptr) {
+        return;
+    }
+    entry = (uint8_t)(global_system_interrupt - io_apic->global_system_interrupt_base);
+
+    // Set the mask bit of the entry
+    write_ioapic(*io_apic, IOAPIC_REDIRECTION_TABLE_REGISTER(entry),
+                 read_ioapic(*io_apic, IOAPIC_REDIRECTION_TABLE_REGISTER(entry)) |
+                     IOAPIC_REDIRECTION_MASKED);
+}
+
+uint8_t influx::interrupts::apic::local_apic_id() {
+    return (uint8_t)(read_local_apic(LAPIC_ID_REGISTER) >> 24);
+}
+
+uint64_t influx::interrupts::apic::msi_address() {
+    return MSI_ADDRESS_BASE | ((uint64_t)local_apic_id() << MSI_ADDRESS_DESTINATION_SHIFT);
+}
+
+bool influx::interrupts::apic::parse_madt(const acpi_madt_t *madt, logger &log) {
+    const uint8_t *entry = (const uint8_t *)(madt + 1);
+    const uint8_t *madt_end = (const uint8_t *)madt + madt->header.length;
+
+    uint64_t local_apic_address = madt->local_apic_address;
+
+    const acpi_madt_io_apic_t *io_apic_entry = nullptr;
+    const acpi_madt_interrupt_source_override_t *override_entry = nullptr;
+
+    // ISA IRQs are identity mapped unless overridden
+    for (uint8_t irq = 0; irq < ISA_IRQ_COUNT; irq++) {
+        _isa_global_system_interrupts[irq] = irq;
+        _isa_flags[irq] = 0;
+    }
+
+    // For each entry in the MADT
+    for (; entry < madt_end && ((const acpi_madt_entry_header_t *)entry)->length != 0;
+         entry += ((const acpi_madt_entry_header_t *)entry)->length) {
+        switch (((const acpi_madt_entry_header_t *)entry)->type) {
+            case ACPI_MADT_ENTRY_IO_APIC:
+                io_apic_entry = (const acpi_madt_io_apic_t *)entry;
+                if (_ioapics_count == IOAPIC_MAX_COUNT) {
+                    break;
+                }
+
+                // Map the I/O APIC and get the amount of redirection entries
+                _ioapics[_ioapics_count] = ioapic{
+                    .registers = (volatile uint32_t *)memory::virtual_allocator::map_io(
+                        io_apic_entry->io_apic_address, PAGE_SIZE),
+                    .global_system_interrupt_base = io_apic_entry->global_system_interrupt_base,
+                    .redirection_entries = 0};
+                if (_ioapics[_ioapics_count].registers == nullptr) {
+                    break;
+                }
+                _ioapics[_ioapics_count].redirection_entries =
+                    ((read_ioapic(_ioapics[_ioapics_count], IOAPIC_VERSION_REGISTER) >> 16) &
+                     0xFF) +
+                    1;
+
+                log("I/O APIC %d found in %x handling GSIs %d-%d.\n", io_apic_entry->io_apic_id,
+                    io_apic_entry->io_apic_address, io_apic_entry->global_system_interrupt_base,
+                    io_apic_entry->global_system_interrupt_base +
+                        _ioapics[_ioapics_count].redirection_entries - 1);
+                _ioapics_count++;
+                break;
+
+            case ACPI_MADT_ENTRY_INTERRUPT_SOURCE_OVERRIDE:
+                override_entry = (const acpi_madt_interrupt_source_override_t *)entry;
+                if (override_entry->source >= ISA_IRQ_COUNT) {
+                    break;
+                }
+
+                // Save the override of the ISA IRQ
+                _isa_global_system_interrupts[override_entry->source] =
+                    override_entry->global_system_interrupt;
+                _isa_flags[override_entry->source] = override_entry->flags;
+
+                log("ISA IRQ %d is overridden to GSI %d.\n", override_entry->source,
+                    override_entry->global_system_interrupt);
+                break;
+
+            case ACPI_MADT_ENTRY_LOCAL_APIC_ADDRESS_OVERRIDE:
+                local_apic_address =
+                    ((const acpi_madt_local_apic_address_override_t *)entry)->local_apic_address;
+                break;
+        }
+    }
+
+    // Map the local APIC
+    _local_apic =
+        (volatile uint32_t *)memory::virtual_allocator::map_io(local_apic_address, PAGE_SIZE);
+
+    return _local_apic != nullptr && _ioapics_count > 0;
+}
+
+void influx::interrupts::apic::init_local_apic() {
+    // Make sure the local APIC is globally enabled
+    msr::write(MSR_IA32_APIC_BASE, msr::read(MSR_IA32_APIC_BASE) | APIC_BASE_GLOBAL_ENABLE);
+
+    // Accept all interrupts
+    write_local_apic(LAPIC_TASK_PRIORITY_REGISTER, 0);
+
+    // Enable the local APIC by setting the spurious interrupt vector
+    write_local_apic(LAPIC_SPURIOUS_INTERRUPT_VECTOR_REGISTER,
+                     LAPIC_SOFTWARE_ENABLE | LAPIC_SPURIOUS_INTERRUPT_VECTOR);
+}
+
+void influx::interrupts::apic::init_ioapic(ioapic &io_apic) {
+    for (uint32_t i = 0; i < io_apic.redirection_entries; i++) {
+        write_ioapic(io_apic, IOAPIC_REDIRECTION_TABLE_REGISTER(i),
+                     IOAPIC_REDIRECTION_MASKED);
+    }
+}
+
+uint32_t influx::interrupts::apic::read_local_apic(uint32_t reg) {
+    return _local_apic[reg / sizeof(uint32_t)];
+}
+
+void influx::interrupts::apic::write_local_apic(uint32_t reg, uint32_t value) {
+    _local_apic[reg / sizeof(uint32_t)] = value;
+}
+
+uint32_t influx::interrupts::apic::read_ioapic(const ioapic &io_apic, uint8_t reg) {
+    io_apic.registers[IOAPIC_REGISTER_SELECT / sizeof(uint32_t)] = reg;
+
+    return io_apic.registers[IOAPIC_REGISTER_WINDOW / sizeof(uint32_t)];
+}
+
+void influx::interrupts::apic::write_ioapic(const ioapic &io_apic, uint8_t reg, uint32_t value) {
+    io_apic.registers[IOAPIC_REGISTER_SELECT / sizeof(uint32_t)] = reg;
+    io_apic.registers[IOAPIC_REGISTER_WINDOW / sizeof(uint32_t)] = value;
+}
+
+influx::interrupts::ioapic *influx::interrupts::apic::get_ioapic(
+    uint32_t global_system_interrupt) {
+    for (uint64_t i = 0; i < _ioapics_count; i++) {
+        if (global_system_interrupt >= _ioapics[i].global_system_interrupt_base &&
+            global_system_interrupt <
+                _ioapics[i].global_system_interrupt_base + _ioapics[i].redirection_entries) {
+            return &_ioapics[i];
+        }
+    }
+
+    return nullptr;
+}
+
+uint32_t influx::interrupts::apic::get_global_system_interrupt(uint8_t irq,
+                                                               uint32_t &redirection_flags) {
+    redirection_flags = 0;
+
+    // IRQs above the ISA IRQs are already global system interrupts
+    if (irq >= ISA_IRQ_COUNT) {
+        return irq;
+    }
+
+    // ISA IRQs are active high and edge triggered unless overridden
+    if ((_isa_flags[irq] & ACPI_MADT_POLARITY_MASK) == ACPI_MADT_POLARITY_ACTIVE_LOW) {
+        redirection_flags |= IOAPIC_REDIRECTION_ACTIVE_LOW;
+    }
+    if ((_isa_flags[irq] & ACPI_MADT_TRIGGER_MODE_MASK) == ACPI_MADT_TRIGGER_MODE_LEVEL) {
+        redirection_flags |= IOAPIC_REDIRECTION_LEVEL_TRIGGERED;
+    }
+
+    return _isa_global_system_interrupts[irq];
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include <kernel/interrupts/exception_table.h>
+
+extern "C" influx::interrupts::exception_table_entry __ex_table_start[], __ex_table_end[];
+
+uint64_t influx::interrupts::exception_table::find_fixup(uint64_t fault_address) {
+    // The table only has the few instructions that access user memory
+    for (exception_table_entry *entry = __ex_table_start; entry < __ex_table_end; entry++) {
+        if (entry->fault_address == fault_address) {
+            return entry->fixup_address;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
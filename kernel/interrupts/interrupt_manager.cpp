@@ -3,6 +3,8 @@
 #include <kernel/assert.h>
 #include <kernel/drivers/pic.h>
 #include <kernel/gdt.h>
+#include <kernel/interrupts/exception_table.h>
+#include <kernel/interrupts/apic.h>
 #include <kernel/interrupts/interrupt_manager.h>
 #include <kernel/interrupts/isrs.h>
 #include <kernel/kernel.h>
@@ -12,8 +14,6 @@
 #include <kernel/threading/interrupts_lock.h>
 #include <kernel/threading/lock_guard.h>
 #include <kernel/threading/scheduler_started.h>
-#include <kernel/threading/unique_lock.h>
-#include <kernel/utils.h>
 
 #define SET_ISR(n, t) set_isr(n, (uint64_t)isr_##n, t)
 
@@ -28,6 +28,12 @@ void influx::interrupts::isr_handler(influx::interrupts::regs *context) {
 
     bool blocked = threading::scheduler_started &&
                    current_task->value().state != threading::thread_state::running;
+    bool from_user = threading::scheduler_started && (context->cs & 0b11) == 3;
+
+    // Charge the time spent in userland before the interrupt
+    if (from_user) {
+        kernel::scheduler()->account_user_time();
+    }
 
     // Unblock the task
     if (blocked) {
@@ -43,6 +49,11 @@ void influx::interrupts::isr_handler(influx::interrupts::regs *context) {
     if (blocked) {
         kernel::scheduler()->block_current_task();
     }
+
+    // Charge the time spent in the kernel before returning to userland
+    if (from_user) {
+        kernel::scheduler()->account_system_time();
+    }
 }
 
 void influx::interrupts::exception_interrupt_handler(influx::interrupts::regs *context) {
@@ -57,13 +68,31 @@ void influx::interrupts::exception_interrupt_handler(influx::interrupts::regs *c
     kpanic();
 }
 
+void influx::interrupts::page_fault_interrupt_handler(influx::interrupts::regs *context) {
+    uint64_t fixup_address = 0;
+
+    // Count the fault for the task that caused it
+    if (threading::scheduler_started) {
+        kernel::scheduler()->count_page_fault();
+    }
+
+    // Faults of the kernel in instructions that access user memory continue from their fixup
+    if ((context->cs & 0b11) == 0 &&
+        (fixup_address = exception_table::find_fixup(context->rip)) != 0) {
+        context->rip = fixup_address;
+        return;
+    }
+
+    exception_interrupt_handler(context);
+}
+
 void influx::interrupts::irq_interrupt_handler(influx::interrupts::regs *context) {
     interrupts::interrupt_manager *manager = kernel::interrupt_manager();
     uint8_t irq_number = (uint8_t)(context->isr_number - PIC1_INTERRUPTS_OFFSET);
 
     if (irq_number == 0) {
-        // Send EOI to the master PIC
-        influx::ports::out<uint8_t>(PIC_EOI, PIC1_COMMAND);
+        // Send EOI before the timer handler since it may switch tasks
+        interrupt_manager::send_irq_eoi(irq_number);
     }
 
     // Call IRQ handler or notify waiters
@@ -71,33 +100,33 @@ void influx::interrupts::irq_interrupt_handler(influx::interrupts::regs *context
         ((void (*)(void *))manager->_irq_handlers[irq_number].handler_address)(
             manager->_irq_handlers[irq_number].handler_data);
     } else if (threading::scheduler_started) {
-        threading::interrupts_lock int_lk;
-        manager->_irq_call_count[irq_number]++;
-        manager->_irq_call_count_changed = true;
-
-        // Unblock IRQ notify task
-        if (manager->_irq_notify_task != nullptr) {
-            kernel::scheduler()->unblock_task(manager->_irq_notify_task);
-        }
+        // Wake the task waiting for the IRQ directly
+        manager->_irq_notifiers[irq_number].notify();
     }
 
     if (irq_number != 0) {
-        // If the IRQ is on the slave PIC, send EOI to it
-        if (irq_number >= 8) {
-            influx::ports::out<uint8_t>(PIC_EOI, PIC2_COMMAND);
-        }
+        interrupt_manager::send_irq_eoi(irq_number);
+    }
+}
 
-        // Send EOI to the master PIC
-        influx::ports::out<uint8_t>(PIC_EOI, PIC1_COMMAND);
+void influx::interrupts::msi_interrupt_handler(influx::interrupts::regs *context) {
+    interrupts::interrupt_manager *manager = kernel::interrupt_manager();
+    uint8_t msi_number = (uint8_t)(context->isr_number - MSI_INTERRUPTS_OFFSET);
+
+    // Call the MSI handler
+    if (manager->_msi_handlers[msi_number].handler_address != 0) {
+        ((void (*)(void *))manager->_msi_handlers[msi_number].handler_address)(
+            manager->_msi_handlers[msi_number].handler_data);
     }
+
+    // MSIs are always delivered to the local APIC
+    apic::send_eoi();
 }
 
 influx::interrupts::interrupt_manager::interrupt_manager()
     : _log("Interrupt Manager", console_color::green),
       _idt((interrupt_descriptor_t *)memory::virtual_allocator::allocate(IDT_SIZE,
-                                                                         PROT_READ | PROT_WRITE)),
-      _irq_notify_task(nullptr),
-      _irq_call_count_changed(false) {
+                                                                         PROT_READ | PROT_WRITE)) {
     kassert(_idt != nullptr);
 
     // Init the ISR array
@@ -118,10 +147,24 @@ influx::interrupts::interrupt_manager::interrupt_manager()
     _log("Resitering PIC interrupt handlers..\n");
     register_pic_interrupts();
 
+    // Register MSI interrupts
+    _log("Resitering MSI interrupt handlers..\n");
+    register_msi_interrupts();
+
     // Remap PIC interrupts
     _log("Remmaping PICs interrupt offsets..\n");
     remap_pic_interrupts();
 
+    // Route the IRQs through the APIC if available, otherwise keep using the PIC
+    _log("Initializing APIC..\n");
+    if (apic::init()) {
+        route_apic_interrupts();
+        mask_pic_interrupts();
+        _log("IRQs are routed through the I/O APIC.\n");
+    } else {
+        _log("IRQs are routed through the PIC.\n");
+    }
+
     // Load the IDT
     load_idt();
 
@@ -150,33 +193,62 @@ void influx::interrupts::interrupt_manager::set_irq_handler(uint8_t irq,
                                                             uint64_t irq_handler_address,
                                                             void *irq_handler_data) {
     kassert(irq >= 0 && irq < PIC_INTERRUPT_COUNT);
-    threading::lock_guard irq_lk(_irq_mutexes[irq]);
+    threading::interrupts_lock int_lk;
 
-    // Set IRQ handler
+    // Set IRQ handler, the IRQ handler reads it so it's updated with interrupts disabled
     _irq_handlers[irq].handler_address = irq_handler_address;
     _irq_handlers[irq].handler_data = irq_handler_data;
     _log("IRQ handler (%p) has been set for IRQ %x.\n", irq_handler_address, irq);
 }
 
-bool influx::interrupts::interrupt_manager::wait_for_irq(uint8_t irq, bool interruptible) {
-    threading::unique_lock irq_lk(_irq_mutexes[irq]);
+bool influx::interrupts::interrupt_manager::wait_for_irq(uint8_t irq, bool interruptible,
+                                                         uint64_t timeout_ms) {
+    kassert(irq >= 0 && irq < PIC_INTERRUPT_COUNT);
 
     if (!threading::scheduler_started) {
         return false;
     }
 
-    if (interruptible) {
-        return _irq_cvs[irq].wait_interruptible(irq_lk);
-    } else {
-        _irq_cvs[irq].wait(irq_lk);
-        return true;
+    return _irq_notifiers[irq].wait(interruptible, timeout_ms);
+}
+
+void influx::interrupts::interrupt_manager::reset_irq(uint8_t irq) {
+    kassert(irq >= 0 && irq < PIC_INTERRUPT_COUNT);
+
+    _irq_notifiers[irq].reset();
+}
+
+int16_t influx::interrupts::interrupt_manager::allocate_msi_vector(uint64_t msi_handler_address,
+                                                                  void *msi_handler_data) {
+    kassert(msi_handler_address != 0);
+    threading::lock_guard lk(_msi_mutex);
+
+    // MSIs can only be delivered to the local APIC
+    if (!apic::enabled()) {
+        return -1;
     }
+
+    // Find a free MSI vector
+    for (uint8_t i = 0; i < MSI_INTERRUPT_COUNT; i++) {
+        if (_msi_handlers[i].handler_address == 0) {
+            _msi_handlers[i].handler_data = msi_handler_data;
+            _msi_handlers[i].handler_address = msi_handler_address;
+            _log("MSI handler (%p) has been set for interrupt %x.\n", msi_handler_address,
+                 MSI_INTERRUPTS_OFFSET + i);
+
+            return (int16_t)(MSI_INTERRUPTS_OFFSET + i);
+        }
+    }
+
+    return -1;
 }
 
-void influx::interrupts::interrupt_manager::start_irq_notify_thread() {
-    _irq_notify_task = kernel::scheduler()->create_kernel_thread(
-        utils::method_function_wrapper<interrupt_manager, &interrupt_manager::irq_notify_thread>,
-        this, true);
+void influx::interrupts::interrupt_manager::free_msi_vector(uint8_t vector) {
+    kassert(vector >= MSI_INTERRUPTS_OFFSET && vector < MSI_INTERRUPTS_OFFSET + MSI_INTERRUPT_COUNT);
+    threading::lock_guard lk(_msi_mutex);
+
+    _msi_handlers[vector - MSI_INTERRUPTS_OFFSET].handler_address = 0;
+    _msi_handlers[vector - MSI_INTERRUPTS_OFFSET].handler_data = nullptr;
 }
 
 void influx::interrupts::interrupt_manager::enable_interrupts() const {
@@ -187,6 +259,14 @@ void influx::interrupts::interrupt_manager::disable_interrupts() const {
     __asm__ __volatile__("cli");
 }
 
+bool influx::interrupts::interrupt_manager::interrupts_enabled() const {
+    uint64_t rflags;
+
+    __asm__ __volatile__("pushfq; pop %0" : "=r"(rflags));
+
+    return (rflags & RFLAGS_INTERRUPT_FLAG) != 0;
+}
+
 void influx::interrupts::interrupt_manager::set_isr(uint8_t interrupt_index, uint64_t isr,
                                                     interrupt_service_routine_type type) {
     interrupt_descriptor_t descriptor{.offset_1 = (uint16_t)(isr & 0xFFFF),
@@ -242,40 +322,51 @@ void influx::interrupts::interrupt_manager::remap_pic_interrupts() {
     ports::out<uint8_t>(0, PIC2_DATA);
 }
 
-void influx::interrupts::interrupt_manager::register_exception_interrupts() {
-    // Set the exception interrupt handler as the interrupt handler for the first 20 interrupts
-    for (uint8_t i = 0; i < 20; i++) {
-        set_interrupt_service_routine(i, (uint64_t)exception_interrupt_handler);
-    }
+void influx::interrupts::interrupt_manager::mask_pic_interrupts() {
+    // Mask all IRQs in both PICs
+    ports::out<uint8_t>(0xFF, PIC1_DATA);
+    ports::out<uint8_t>(0xFF, PIC2_DATA);
 }
 
-void influx::interrupts::interrupt_manager::irq_notify_thread() {
-    uint64_t irq_call_count_copy[PIC_INTERRUPT_COUNT];
-
-    while (true) {
-        // Create a copy of the IRQ call count
-        threading::interrupts_lock int_lk;
-        memory::utils::memcpy(irq_call_count_copy, _irq_call_count, sizeof(_irq_call_count));
-        memory::utils::memset(_irq_call_count, 0, sizeof(_irq_call_count));
-        _irq_call_count_changed = false;
-        int_lk.unlock();
-
-        // For each IRQ
-        for (uint64_t irq = 0; irq < PIC_INTERRUPT_COUNT; irq++) {
-            while (irq_call_count_copy[irq] > 0) {
-                _irq_cvs[irq].notify_one();
-                irq_call_count_copy[irq]--;
-            }
+void influx::interrupts::interrupt_manager::route_apic_interrupts() {
+    // Route each ISA IRQ to the same interrupt the PIC would have raised
+    for (uint8_t irq = 0; irq < PIC_INTERRUPT_COUNT; irq++) {
+        if (irq == ISA_CASCADE_IRQ) {
+            continue;
         }
 
-        // Block this task
-        int_lk.lock();
-        if (_irq_call_count_changed == false) {
-            kernel::scheduler()->block_current_task();
+        if (!apic::route_irq(irq, (uint8_t)(PIC1_INTERRUPTS_OFFSET + irq))) {
+            _log("Unable to route IRQ %d through the I/O APIC.\n", irq);
         }
     }
 }
 
+void influx::interrupts::interrupt_manager::send_irq_eoi(uint8_t irq) {
+    // The local APIC EOI is a single MMIO write
+    if (apic::enabled()) {
+        apic::send_eoi();
+        return;
+    }
+
+    // If the IRQ is on the slave PIC, send EOI to it
+    if (irq >= 8) {
+        influx::ports::out<uint8_t>(PIC_EOI, PIC2_COMMAND);
+    }
+
+    // Send EOI to the master PIC
+    influx::ports::out<uint8_t>(PIC_EOI, PIC1_COMMAND);
+}
+
+void influx::interrupts::interrupt_manager::register_exception_interrupts() {
+    // Set the exception interrupt handler as the interrupt handler for the first 20 interrupts
+    for (uint8_t i = 0; i < 20; i++) {
+        set_interrupt_service_routine(i, (uint64_t)exception_interrupt_handler);
+    }
+
+    // Page faults may be recovered using the exception table
+    set_interrupt_service_routine(PAGE_FAULT_INTERRUPT, (uint64_t)page_fault_interrupt_handler);
+}
+
 void influx::interrupts::interrupt_manager::register_pic_interrupts() {
     ADD_IRQ_HANDLER(0);
     ADD_IRQ_HANDLER(1);
@@ -295,6 +386,12 @@ void influx::interrupts::interrupt_manager::register_pic_interrupts() {
     ADD_IRQ_HANDLER(15);
 }
 
+void influx::interrupts::interrupt_manager::register_msi_interrupts() {
+    for (uint8_t i = 0; i < MSI_INTERRUPT_COUNT; i++) {
+        set_interrupt_service_routine(MSI_INTERRUPTS_OFFSET + i, (uint64_t)msi_interrupt_handler);
+    }
+}
+
 void influx::interrupts::interrupt_manager::init_isrs() {
     SET_ISR(0, interrupt_service_routine_type::trap_gate);
     SET_ISR(1, interrupt_service_routine_type::trap_gate);
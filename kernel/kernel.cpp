@@ -1,5 +1,6 @@
 #include <kernel/kernel.h>
 
+#include <kernel/acpi/acpi.h>
 #include <kernel/assert.h>
 #include <kernel/console/console.h>
 #include <kernel/console/early_console.h>
@@ -8,6 +9,7 @@
 #include <kernel/logger.h>
 #include <kernel/memory/physical_allocator.h>
 #include <kernel/memory/virtual_allocator.h>
+#include <kernel/threading/fpu.h>
 
 extern "C" void _init();
 
@@ -17,6 +19,9 @@ void influx::kernel::start(const boot_info info) {
 }
 
 void influx::kernel::early_kmain(const boot_info info) {
+    // Select the FPU context switching mode before the boot memory (with the cmdline) is unmapped
+    threading::fpu::init(info.cmdline);
+
     // Init memory manager
     memory::physical_allocator::init(info.memory);
     memory::virtual_allocator::init(info.memory);
@@ -40,6 +45,10 @@ void influx::kernel::kmain(const boot_info info) {
 
     log("Finished initializing memory manager and console.\n");
 
+    // Init ACPI tables for the interrupt controllers
+    log("Loading ACPI tables..\n");
+    acpi::init(info.acpi);
+
     // Init interrupt manager
     log("Loading interrupt manager..\n");
     _interrupt_manager = new interrupts::interrupt_manager();
@@ -60,10 +69,14 @@ void influx::kernel::kmain(const boot_info info) {
     // Init scheduler
     log("Loading scheduler..\n");
     _scheduler = new threading::scheduler(info.tss_address);
-    _interrupt_manager->start_irq_notify_thread();
     _tty_manager->start_input_threads();
     log("Scheduler loaded.\n");
 
+    // Init futex manager
+    log("Loading futex manager..\n");
+    _futex_manager = new threading::futex_manager();
+    log("Futex manager loaded.\n");
+
     // Init syscall manager
     log("Loading syscall manager..\n");
     _syscall_manager = new syscalls::syscall_manager();
@@ -78,6 +91,7 @@ void influx::kernel::kmain(const boot_info info) {
                      drivers::ata::drive_slice(ata, ata->drives()[0], 0))) {
         kpanic("Unable to mount main drive!\n");
     }
+    _vfs->start_flusher_thread();
     log("VFS loaded and default drive mounted on '/'.\n");
 
     // Kill this task since it's no necessary
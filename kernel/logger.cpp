@@ -54,10 +54,9 @@ influx::structures::string influx::logger::format_time() const {
     if (kernel::time_manager() == nullptr) {
         return "00:00:00.000";
     } else {
-        return format("%02d:%02d:%02d.%03d",
-                      (uint64_t)(kernel::time_manager()->seconds() / (60 * 60)),
-                      (uint64_t)(kernel::time_manager()->seconds() / 60) % 60,
-                      (uint64_t)kernel::time_manager()->seconds() % 60,
-                      (uint64_t)kernel::time_manager()->milliseconds() % 1000);
+        return format("%02d:%02d:%02d.%03d", kernel::time_manager()->seconds() / (60 * 60),
+                      (kernel::time_manager()->seconds() / 60) % 60,
+                      kernel::time_manager()->seconds() % 60,
+                      kernel::time_manager()->milliseconds() % 1000);
     }
 }
\ No newline at end of file
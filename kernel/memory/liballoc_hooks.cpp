@@ -8,7 +8,7 @@
 #include <stdint.h>
 
 uint32_t liballoc_early_mutex = 0;
-influx::threading::mutex liballoc_mutex;
+influx::threading::mutex liballoc_mutex("liballoc");
 
 extern "C" int liballoc_lock() {
     // If the scheduler has started
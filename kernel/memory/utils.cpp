@@ -1,5 +1,6 @@
 #include <kernel/memory/utils.h>
 
+#include <kernel/interrupts/exception_table.h>
 #include <memory/paging.h>
 
 void *influx::memory::utils::get_pml4() {
@@ -61,6 +62,41 @@ void influx::memory::utils::memcpy(void *dst, const void *src, uint64_t amount)
     }
 }
 
+uint64_t influx::memory::utils::memcpy_fault_safe(void *dst, const void *src, uint64_t amount) {
+    // If the copy faults, the amount that wasn't copied is left in RCX
+    __asm__ __volatile__("1: rep movsb\n"
+                         "2:\n" EXCEPTION_TABLE_ENTRY("1b", "2b")
+                         : "+D"(dst), "+S"(src), "+c"(amount)
+                         :
+                         : "memory");
+
+    return amount;
+}
+
+int64_t influx::memory::utils::strncpy_fault_safe(char *dst, const char *src, uint64_t size) {
+    uint64_t length = 0;
+    uint8_t c = 0;
+
+    // Copy until the null terminator, the length is set to -1 if the copy faults
+    __asm__ __volatile__(
+        "1: cmp %[length], %[size]\n"
+        "jae 3f\n"
+        "2: mov %b[c], byte ptr [%[src] + %[length]]\n"
+        "mov byte ptr [%[dst] + %[length]], %b[c]\n"
+        "inc %[length]\n"
+        "test %b[c], %b[c]\n"
+        "jnz 1b\n"
+        "dec %[length]\n"
+        "jmp 3f\n"
+        "4: mov %[length], -1\n"
+        "3:\n" EXCEPTION_TABLE_ENTRY("2b", "4b")
+        : [length] "+r"(length), [c] "=&q"(c)
+        : [dst] "r"(dst), [src] "r"(src), [size] "r"(size)
+        : "memory", "cc");
+
+    return (int64_t)length;
+}
+
 int influx::memory::utils::memcmp(const void *a, const void *b, uint64_t amount) {
     const uint8_t *s1 = (const uint8_t *)a;
     const uint8_t *s2 = (const uint8_t *)b;
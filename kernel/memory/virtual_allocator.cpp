@@ -80,6 +80,44 @@ void *influx::memory::virtual_allocator::allocate(uint64_t size, protection_flag
     }
 }
 
+void *influx::memory::virtual_allocator::map_io(uint64_t physical_address, uint64_t size) {
+    uint64_t offset = physical_address % PAGE_SIZE;
+    uint64_t pages_size = (offset + size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+    // Map the physical pages of the registers
+    uint8_t *pages = (uint8_t *)allocate(pages_size, PROT_READ | PROT_WRITE,
+                                         (int64_t)(physical_address / PAGE_SIZE));
+    if (pages == nullptr) {
+        return nullptr;
+    }
+
+    // The registers must not be cached
+    for (uint64_t i = 0; i < pages_size / PAGE_SIZE; i++) {
+        paging_manager::get_pte((uint64_t)pages + i * PAGE_SIZE)->page_cache_disable = true;
+    }
+
+    return pages + offset;
+}
+
+void influx::memory::virtual_allocator::unmap(void *ptr, uint64_t size) {
+    uint64_t offset = (uint64_t)ptr % PAGE_SIZE;
+    uint64_t pages_address = (uint64_t)ptr - offset;
+    uint64_t pages_size = (offset + size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+    // Free the VMA region
+    if (!free_vma_region({.base_addr = pages_address,
+                          .size = pages_size,
+                          .protection_flags = 0,
+                          .allocated = true})) {
+        // TODO: throw exception
+    }
+
+    // Free the mapping to the pages, the physical pages aren't owned by the allocator
+    for (uint64_t i = 0; i < pages_size / PAGE_SIZE; i++) {
+        paging_manager::unmap_page(pages_address + i * PAGE_SIZE);
+    }
+}
+
 void influx::memory::virtual_allocator::free(void *ptr, uint64_t size) {
     uint64_t page_physical_address = 0;
 
@@ -0,0 +1,15 @@
+#include <kernel/msr.h>
+
+uint64_t influx::msr::read(uint32_t msr) {
+    uint32_t low, high;
+
+    __asm__ __volatile__("rdmsr" : "=a"(low), "=d"(high) : "c"(msr));
+
+    return ((uint64_t)high << 32) | low;
+}
+
+void influx::msr::write(uint32_t msr, uint64_t value) {
+    __asm__ __volatile__("wrmsr"
+                         :
+                         : "c"(msr), "a"((uint32_t)value), "d"((uint32_t)(value >> 32)));
+}
\ No newline at end of file
@@ -1,19 +1,26 @@
 #include <kernel/structures/fifo.h>
 
+#include <kernel/algorithm.h>
+#include <kernel/memory/utils.h>
+
 influx::structures::fifo::fifo(uint8_t *buffer, uint64_t max_size)
     : _buffer(buffer), _max_size(max_size), _head(0), _tail(0) {}
 
 uint64_t influx::structures::fifo::current_size() const { return _tail - _head; }
 
 bool influx::structures::fifo::push(const uint8_t *buffer, size_t count) {
+    uint64_t tail_offset = _tail % _max_size;
+    uint64_t first_part = algorithm::min<uint64_t>(count, _max_size - tail_offset);
+
     // Verify the size of the FIFO after the insert
     if (current_size() + count > _max_size) {
         return false;
     }
 
-    // Copy data from buffer to FIFO
-    for (uint64_t i = _tail; i < (_tail + count); i++) {
-        *(_buffer + (i % _max_size)) = *(buffer + (i - _tail));
+    // Copy data from buffer to FIFO in at most two parts, the buffer may be an invalid user buffer
+    if (memory::utils::memcpy_fault_safe(_buffer + tail_offset, buffer, first_part) != 0 ||
+        memory::utils::memcpy_fault_safe(_buffer, buffer + first_part, count - first_part) != 0) {
+        return false;
     }
 
     // Increase tail ptr
@@ -29,14 +36,18 @@ bool influx::structures::fifo::push(const uint8_t *buffer, size_t count) {
 }
 
 bool influx::structures::fifo::pop(uint8_t *buffer, size_t count) {
+    uint64_t head_offset = _head % _max_size;
+    uint64_t first_part = algorithm::min<uint64_t>(count, _max_size - head_offset);
+
     // Verify the FIFO has the amount of the wanted data
     if (current_size() < count) {
         return false;
     }
 
-    // Copy data from FIFO to buffer
-    for (uint64_t i = _head; i < (_head + count); i++) {
-        *(buffer + (i - _head)) = *(_buffer + (i % _max_size));
+    // Copy data from FIFO to buffer in at most two parts, the buffer may be an invalid user buffer
+    if (memory::utils::memcpy_fault_safe(buffer, _buffer + head_offset, first_part) != 0 ||
+        memory::utils::memcpy_fault_safe(buffer + first_part, _buffer, count - first_part) != 0) {
+        return false;
     }
 
     // Increase head ptr
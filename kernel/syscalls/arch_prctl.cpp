@@ -0,0 +1,35 @@
+#include <kernel/kernel.h>
+#include <kernel/memory/paging_manager.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+#define ARCH_SET_FS 0x1002
+#define ARCH_GET_FS 0x1003
+
+int64_t influx::syscalls::handlers::arch_prctl(uint64_t code, uint64_t addr) {
+    uint64_t fs_base = 0;
+
+    switch (code) {
+        case ARCH_SET_FS:
+            // The FS base must be in user memory
+            if (addr >= USERLAND_MEMORY_BARRIER) {
+                return -EPERM;
+            }
+
+            kernel::scheduler()->set_fs_base(addr);
+            return 0;
+
+        case ARCH_GET_FS:
+            // Copy the FS base to the user
+            fs_base = kernel::scheduler()->get_fs_base();
+            if (!utils::copy_to_user((uint64_t *)addr, &fs_base, sizeof(uint64_t))) {
+                return -EFAULT;
+            }
+
+            return 0;
+
+        default:
+            return -EINVAL;
+    }
+}
\ No newline at end of file
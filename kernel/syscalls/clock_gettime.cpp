@@ -0,0 +1,36 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::clock_gettime(uint64_t clock_id, influx::time::timespec *tp) {
+    time::timespec ts;
+
+    // Get the time of the clock
+    if (!kernel::time_manager()->get_time((time::clock_id)clock_id, ts)) {
+        return -EINVAL;
+    }
+
+    // Copy the time to the user
+    if (!utils::copy_to_user(tp, &ts, sizeof(time::timespec))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
+
+int64_t influx::syscalls::handlers::clock_getres(uint64_t clock_id, influx::time::timespec *res) {
+    time::timespec ts;
+
+    // Get the resolution of the clock
+    if (!kernel::time_manager()->get_resolution((time::clock_id)clock_id, ts)) {
+        return -EINVAL;
+    }
+
+    // The resolution is optional
+    if (res != nullptr && !utils::copy_to_user(res, &ts, sizeof(time::timespec))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <kernel/kernel.h>
+#include <kernel/memory/paging_manager.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+#define CLONE_VM 0x00000100             /* set if VM shared between processes */
+#define CLONE_FS 0x00000200             /* set if fs info shared between processes */
+#define CLONE_FILES 0x00000400          /* set if open files shared between processes */
+#define CLONE_SIGHAND 0x00000800        /* set if signal handlers shared */
+#define CLONE_THREAD 0x00010000         /* Same thread group? */
+#define CLONE_SETTLS 0x00080000         /* create a new TLS for the child */
+#define CLONE_CHILD_CLEARTID 0x00200000 /* clear the TID in the child */
+
+#define CLONE_SUPPORTED_FLAGS                                                          \
+    (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | CLONE_THREAD | CLONE_SETTLS | \
+     CLONE_CHILD_CLEARTID)
+
+int64_t influx::syscalls::handlers::clone(uint64_t flags, uint64_t entry, uint64_t arg,
+                                          uint64_t tls, uint32_t *clear_child_tid) {
+    int64_t tid = 0;
+
+    // Only threads that share the address space of the process are supported
+    if ((flags & ~(uint64_t)CLONE_SUPPORTED_FLAGS) || !(flags & CLONE_VM) ||
+        !(flags & CLONE_THREAD)) {
+        return -EINVAL;
+    }
+
+    // Verify that the entry point is in user memory
+    if (entry >= USERLAND_MEMORY_BARRIER ||
+        !(memory::paging_manager::get_pte_permissions(entry) & PROT_EXEC)) {
+        return -EFAULT;
+    }
+
+    // Verify the TLS address
+    if ((flags & CLONE_SETTLS) && tls >= USERLAND_MEMORY_BARRIER) {
+        return -EINVAL;
+    }
+
+    // Verify the address of the thread id to clear when the thread exits
+    if ((flags & CLONE_CHILD_CLEARTID) &&
+        !utils::is_buffer_in_user_memory(clear_child_tid, sizeof(uint32_t), PROT_WRITE)) {
+        return -EFAULT;
+    }
+
+    // Create the thread, it inherits the TLS of the calling thread if no new TLS was requested
+    tid = kernel::scheduler()->clone(
+        entry, arg, (flags & CLONE_SETTLS) ? tls : kernel::scheduler()->get_fs_base(),
+        (flags & CLONE_CHILD_CLEARTID) ? clear_child_tid : nullptr);
+
+    return tid < 0 ? -EAGAIN : tid;
+}
\ No newline at end of file
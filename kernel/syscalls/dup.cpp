@@ -3,21 +3,17 @@
 #include <kernel/syscalls/handlers.h>
 
 int64_t influx::syscalls::handlers::dup(size_t oldfd, size_t newfd) {
-    vfs::open_file file;
-
-    uint64_t fd;
+    int64_t fd;
 
 	if (oldfd == newfd) {
 		return newfd;
 	}
 
-    // Verify valid old file descriptor
-    if (kernel::scheduler()->get_file_descriptor(oldfd, file) != vfs::error::success) {
+	// Duplicate the file descriptor, the old file descriptor is verified while it's duplicated
+    if ((fd = kernel::scheduler()->duplicate_file_descriptor(
+             oldfd, newfd == (size_t)-1 ? -1 : (int64_t)newfd)) < 0) {
         return -EBADF;
     }
 
-	// Duplicate the file descriptor
-    fd = kernel::scheduler()->duplicate_file_descriptor(oldfd, newfd == (size_t)-1 ? -1 : newfd);
-
 	return fd;
 }
\ No newline at end of file
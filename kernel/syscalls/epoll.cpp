@@ -0,0 +1,70 @@
+#include <kernel/algorithm.h>
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::epoll_create(int64_t size) {
+    uint64_t fd = 0;
+
+    // The size is only a hint but it must be positive
+    if (size <= 0) {
+        return -EINVAL;
+    }
+
+    // Create the epoll instance
+    if (!kernel::vfs()->epoll_handler()->create_instance(&fd)) {
+        return -ENOMEM;
+    }
+
+    return (int64_t)fd;
+}
+
+int64_t influx::syscalls::handlers::epoll_ctl(size_t epfd, int op, size_t fd,
+                                              const influx::vfs::epoll_event *event) {
+    vfs::epoll_event kernel_event{.events = 0, .data = 0};
+
+    // Copy the event, it isn't used when removing a file
+    if (op != EPOLL_CTL_DEL) {
+        if (!utils::copy_from_user(&kernel_event, event, sizeof(vfs::epoll_event))) {
+            return -EFAULT;
+        }
+    }
+
+    return utils::convert_vfs_error(
+        kernel::vfs()->epoll_handler()->control(epfd, op, fd, kernel_event));
+}
+
+int64_t influx::syscalls::handlers::epoll_wait(size_t epfd, influx::vfs::epoll_event *events,
+                                               int64_t maxevents, int64_t timeout_ms) {
+    structures::vector<vfs::epoll_event> kernel_events;
+    int64_t amount = 0;
+
+    // Verify the amount of events
+    if (maxevents <= 0) {
+        return -EINVAL;
+    }
+
+    // Check if the events buffer is in the user memory
+    if (!utils::is_range_in_user_memory(events, sizeof(vfs::epoll_event) * (uint64_t)maxevents)) {
+        return -EFAULT;
+    }
+
+    // Wait for events in the instance
+    kernel_events = structures::vector<vfs::epoll_event>(
+        algorithm::min<size_t>((size_t)maxevents, EPOLL_MAX_EVENTS));
+    amount = kernel::vfs()->epoll_handler()->wait(epfd, kernel_events.data(), kernel_events.size(),
+                                                  timeout_ms < 0 ? POLL_INFINITE_TIMEOUT
+                                                                 : timeout_ms);
+    if (amount < 0) {
+        return utils::convert_vfs_error((vfs::error)amount);
+    }
+
+    // Copy the events to the user
+    if (!utils::copy_to_user(events, kernel_events.data(),
+                             sizeof(vfs::epoll_event) * (uint64_t)amount)) {
+        return -EFAULT;
+    }
+
+    return amount;
+}
\ No newline at end of file
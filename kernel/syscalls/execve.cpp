@@ -1,48 +1,37 @@
 #include <kernel/kernel.h>
-#include <kernel/memory/paging_manager.h>
 #include <kernel/syscalls/error.h>
 #include <kernel/syscalls/handlers.h>
 #include <kernel/syscalls/utils.h>
 
-bool convert_string_array_to_vector(const char **arr,
+int64_t copy_string_array_from_user(const char **arr,
                                     influx::structures::vector<influx::structures::string> &vec) {
-    uint64_t current_page = (uint64_t)arr / PAGE_SIZE;
+    const char *str = nullptr;
+    influx::structures::string copied_str;
 
-    // Check if surpassing the userland memory barrier
-    if ((uint64_t)arr > USERLAND_MEMORY_BARRIER) {
-        return false;
-    }
+    int64_t err = 0;
 
-    // Check initial page of the array
-    if (!(influx::memory::paging_manager::get_pte_permissions((uint64_t)arr) & PROT_READ)) {
-        return false;
-    }
+    while (true) {
+        // Copy the pointer of the next string
+        if (!influx::syscalls::utils::copy_from_user(&str, arr, sizeof(const char *))) {
+            return -EFAULT;
+        }
 
-    // While we didn't reach the end of the array
-    while (*arr) {
-        // Check the string
-        if (!influx::syscalls::utils::is_string_in_user_memory(*arr)) {
-            return false;
+        // Stop at the end of the array
+        if (str == nullptr) {
+            break;
         }
 
-        // Insert the string to the array
-        vec.push_back(influx::structures::string(*arr));
+        // Copy the string and insert it to the array
+        if ((err = influx::syscalls::utils::copy_string_from_user(str, copied_str)) < 0) {
+            return err;
+        }
+        vec.push_back(copied_str);
 
         // Move to the next string
         arr++;
-
-        // Check every new page
-        if ((uint64_t)arr / PAGE_SIZE != current_page) {
-            current_page = (uint64_t)arr / PAGE_SIZE;
-
-            if ((uint64_t)arr > USERLAND_MEMORY_BARRIER ||
-                !(influx::memory::paging_manager::get_pte_permissions((uint64_t)arr) & PROT_READ)) {
-                return false;
-            }
-        }
     }
 
-    return true;
+    return 0;
 }
 
 int64_t influx::syscalls::handlers::execve(const char *exec_path, const char **argv,
@@ -50,16 +39,18 @@ int64_t influx::syscalls::handlers::execve(const char *exec_path, const char **a
     int64_t err = 0, fd = 0;
     vfs::file_info file;
 
+    structures::string path;
     structures::vector<structures::string> args, env;
 
-    // Verify exec path string, args and env
-    if (!utils::is_string_in_user_memory(exec_path) ||
-        !convert_string_array_to_vector(argv, args) || !convert_string_array_to_vector(envp, env)) {
-        return -EFAULT;
+    // Copy exec path string, args and env
+    if ((err = utils::copy_string_from_user(exec_path, path)) < 0 ||
+        (err = copy_string_array_from_user(argv, args)) < 0 ||
+        (err = copy_string_array_from_user(envp, env)) < 0) {
+        return err;
     }
 
     // Try to open the file
-    fd = kernel::vfs()->open(exec_path, vfs::open_flags::read);
+    fd = kernel::vfs()->open(path, vfs::open_flags::read);
 
     // Handle errors
     if (fd < 0) {
@@ -72,7 +63,7 @@ int64_t influx::syscalls::handlers::execve(const char *exec_path, const char **a
     }
 
     // Execute the file
-    kernel::scheduler()->exec(fd, vfs::path(exec_path).base_name(), args, env);
+    kernel::scheduler()->exec(fd, vfs::path(path).base_name(), args, env);
 
     return -EFAULT;
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/fcntl.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::fcntl(size_t fd, int cmd, uint64_t arg) {
+    vfs::open_file_ref file;
+
+    // Verify valid file descriptor
+    if (kernel::vfs()->get_open_file_for_fd((int64_t)fd, file) != vfs::error::success) {
+        return -EBADF;
+    }
+
+    switch (cmd) {
+        case F_GETFL:
+            return utils::convert_vfs_open_flags(file->flags);
+
+        case F_SETFL:
+            // Only the append and non-blocking flags can be changed, for every shared fd
+            file->flags = (vfs::open_flags)((file->flags & ~(vfs::open_flags::append |
+                                                             vfs::open_flags::non_blocking)) |
+                                            (utils::convert_open_flags((int)arg) &
+                                             (vfs::open_flags::append |
+                                              vfs::open_flags::non_blocking)));
+            return 0;
+
+        default:
+            return -EINVAL;
+    }
+}
\ No newline at end of file
@@ -81,19 +81,18 @@ influx::syscalls::stat convert_file_info_to_stat(influx::vfs::file_info &info) {
 
 int64_t influx::syscalls::handlers::fstat(size_t fd, influx::syscalls::stat *stat) {
     vfs::file_info info;
+    syscalls::stat file_stat;
     vfs::error err;
 
-    // Check valid file info
-    if (!utils::is_buffer_in_user_memory(stat, sizeof(stat), PROT_READ | PROT_WRITE)) {
-        return -EFAULT;
-    }
-
     // Try to get the stat of the file
     err = (vfs::error)kernel::vfs()->stat(fd, info);
 
-    // Convert file info to stat struct
+    // Convert file info to stat struct and copy it to the user
     if (err == vfs::error::success) {
-        *stat = convert_file_info_to_stat(info);
+        file_stat = convert_file_info_to_stat(info);
+        if (!utils::copy_to_user(stat, &file_stat, sizeof(syscalls::stat))) {
+            return -EFAULT;
+        }
     }
 
     return utils::convert_vfs_error(err);
@@ -0,0 +1,13 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::fsync(size_t fd) {
+    vfs::error err;
+
+    // Try to sync the file
+    err = (vfs::error)kernel::vfs()->sync(fd);
+
+    return utils::convert_vfs_error(err);
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+#include <kernel/threading/futex_manager.h>
+
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+#define FUTEX_REQUEUE 3
+#define FUTEX_CMP_REQUEUE 4
+#define FUTEX_WAIT_BITSET 9
+#define FUTEX_WAKE_BITSET 10
+
+#define FUTEX_PRIVATE_FLAG 128
+#define FUTEX_CLOCK_REALTIME 256
+#define FUTEX_CMD_MASK ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME)
+
+bool is_futex_word_in_user_memory(const uint32_t *address) {
+    uint32_t value = 0;
+
+    // The futex word must be aligned
+    if ((uint64_t)address % sizeof(uint32_t) != 0) {
+        return false;
+    }
+
+    // Read the word so it will be mapped when its physical address is used as the futex key
+    return influx::syscalls::utils::copy_from_user(&value, address, sizeof(uint32_t));
+}
+
+int64_t convert_timeout(const influx::time::timespec *timeout, bool absolute, bool realtime,
+                        uint64_t &timeout_ms) {
+    influx::time::timespec ts;
+    uint64_t now_ms = 0;
+
+    // No timeout
+    if (timeout == nullptr) {
+        timeout_ms = FUTEX_NO_TIMEOUT;
+        return 0;
+    }
+
+    // Copy the timeout from the user
+    if (!influx::syscalls::utils::copy_from_user(&ts, timeout, sizeof(influx::time::timespec))) {
+        return -EFAULT;
+    }
+
+    // Verify the timeout
+    if (ts.nseconds >= NSECONDS_IN_SECOND) {
+        return -EINVAL;
+    }
+
+    // Round the timeout up to the next millisecond
+    timeout_ms = ts.seconds * 1000 + ts.nseconds / 1000000 + (ts.nseconds % 1000000 ? 1 : 0);
+
+    // Convert an absolute timeout to a relative timeout
+    if (absolute) {
+        now_ms = realtime ? influx::kernel::time_manager()->unix_timestamp_ms()
+                          : influx::kernel::time_manager()->milliseconds();
+        timeout_ms = timeout_ms > now_ms ? timeout_ms - now_ms : 0;
+    }
+
+    return 0;
+}
+
+int64_t influx::syscalls::handlers::futex(uint32_t *address, int op, uint32_t value,
+                                          const time::timespec *timeout, uint32_t *address2,
+                                          uint32_t value3) {
+    int cmd = op & FUTEX_CMD_MASK;
+    uint64_t timeout_ms = 0;
+    int64_t err = 0;
+
+    // Verify the futex word
+    if (!is_futex_word_in_user_memory(address)) {
+        return -EFAULT;
+    }
+
+    // The realtime clock can only be used with absolute timeouts
+    if ((op & FUTEX_CLOCK_REALTIME) && cmd != FUTEX_WAIT_BITSET) {
+        return -ENOSYS;
+    }
+
+    switch (cmd) {
+        case FUTEX_WAIT:
+        case FUTEX_WAIT_BITSET:
+            // Verify the bitset
+            if (cmd == FUTEX_WAIT_BITSET && value3 == 0) {
+                return -EINVAL;
+            }
+
+            // Get the timeout, FUTEX_WAIT_BITSET uses an absolute timeout
+            if ((err = convert_timeout(timeout, cmd == FUTEX_WAIT_BITSET,
+                                       (op & FUTEX_CLOCK_REALTIME) != 0, timeout_ms)) < 0) {
+                return err;
+            }
+
+            // Wait on the futex
+            switch (kernel::futex_manager()->wait(
+                address, value, timeout_ms,
+                cmd == FUTEX_WAIT_BITSET ? value3 : FUTEX_BITSET_MATCH_ANY)) {
+                case threading::futex_error::success:
+                    return 0;
+
+                case threading::futex_error::value_mismatch:
+                    return -EAGAIN;
+
+                case threading::futex_error::timed_out:
+                    return -ETIMEDOUT;
+
+                case threading::futex_error::fault:
+                    return -EFAULT;
+
+                case threading::futex_error::interrupted:
+                default:
+                    return -EINTR;
+            }
+
+        case FUTEX_WAKE:
+        case FUTEX_WAKE_BITSET:
+            // Verify the bitset
+            if (cmd == FUTEX_WAKE_BITSET && value3 == 0) {
+                return -EINVAL;
+            }
+
+            return kernel::futex_manager()->wake(
+                address, value, cmd == FUTEX_WAKE_BITSET ? value3 : FUTEX_BITSET_MATCH_ANY);
+
+        case FUTEX_REQUEUE:
+        case FUTEX_CMP_REQUEUE:
+            // Verify the second futex word
+            if (!is_futex_word_in_user_memory(address2)) {
+                return -EFAULT;
+            }
+
+            // The amount of tasks to requeue is sent in the timeout argument
+            err = kernel::futex_manager()->requeue(address, value, address2, (uint64_t)timeout,
+                                                   cmd == FUTEX_CMP_REQUEUE, value3);
+
+            if (err == (int64_t)threading::futex_error::value_mismatch) {
+                return -EAGAIN;
+            } else if (err == (int64_t)threading::futex_error::fault) {
+                return -EFAULT;
+            }
+
+            return err;
+
+        default:
+            return -ENOSYS;
+    }
+}
\ No newline at end of file
@@ -38,9 +38,11 @@ int64_t influx::syscalls::handlers::getdents(size_t fd, dirent* dirp, uint64_t c
     structures::vector<vfs::dir_entry> entries;
 
     uint64_t buf_use_amount = 0;
+    uint8_t* buf = nullptr;
+    dirent* current = nullptr;
 
-    // Check valid buffer
-    if (!utils::is_buffer_in_user_memory(dirp, count, PROT_WRITE)) {
+    // Check valid buffer range, the entries are copied to it at once
+    if (!utils::is_range_in_user_memory(dirp, count)) {
         return -EFAULT;
     }
 
@@ -52,20 +54,33 @@ int64_t influx::syscalls::handlers::getdents(size_t fd, dirent* dirp, uint64_t c
         return utils::convert_vfs_error((vfs::error)read);
     }
 
+    // Calculate the size of the dirent structs
+    for (auto& entry : entries) {
+        buf_use_amount += vfs::vfs::dirent_size_for_dir_entry(entry);
+    }
+    buf = new uint8_t[buf_use_amount];
+    current = (dirent*)buf;
+
     // For each VFS dir entry, create dirent struct
     for (const auto& entry : entries) {
-        dirp->d_ino = entry.inode;
-        dirp->d_type = convert_vfs_file_type(entry.type);
-        dirp->d_reclen = (unsigned short)(sizeof(dirent) + entry.name.size() + 1);
-        dirp->d_off = dirp->d_reclen;
-        buf_use_amount += dirp->d_reclen;
+        current->d_ino = entry.inode;
+        current->d_type = convert_vfs_file_type(entry.type);
+        current->d_reclen = (unsigned short)(sizeof(dirent) + entry.name.size() + 1);
+        current->d_off = current->d_reclen;
 
         // Copy entry name
-        memory::utils::memcpy(dirp->d_name, entry.name.c_str(), entry.name.size() + 1);
+        memory::utils::memcpy(current->d_name, entry.name.c_str(), entry.name.size() + 1);
 
         // Increase directory ptr
-        dirp = (dirent*)((uint8_t*)dirp + dirp->d_off);
+        current = (dirent*)((uint8_t*)current + current->d_off);
+    }
+
+    // Copy the dirent structs to the user buffer
+    if (!utils::copy_to_user(dirp, buf, buf_use_amount)) {
+        buf_use_amount = 0;
+        read = -EFAULT;
     }
+    delete[] buf;
 
-    return buf_use_amount;
+    return read < 0 ? read : (int64_t)buf_use_amount;
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::getrusage(int who, influx::syscalls::rusage *usage) {
+    syscalls::rusage resource_usage;
+
+    // Get the usage of the requested target
+    switch (who) {
+        case RUSAGE_SELF:
+            resource_usage = utils::convert_cpu_usage(kernel::scheduler()->get_process_cpu_usage());
+            break;
+
+        case RUSAGE_CHILDREN:
+            resource_usage =
+                utils::convert_cpu_usage(kernel::scheduler()->get_children_cpu_usage());
+            break;
+
+        case RUSAGE_THREAD:
+            resource_usage = utils::convert_cpu_usage(kernel::scheduler()->get_thread_cpu_usage());
+            break;
+
+        default:
+            return -EINVAL;
+    }
+
+    // Copy the usage to the user
+    if (!utils::copy_to_user(usage, &resource_usage, sizeof(syscalls::rusage))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/handlers.h>
+
+int64_t influx::syscalls::handlers::io_ring_setup(uint32_t entries) {
+    return kernel::syscall_manager()->io_rings().setup(entries);
+}
+
+int64_t influx::syscalls::handlers::io_ring_enter(uint32_t to_submit) {
+    return kernel::syscall_manager()->io_rings().enter(to_submit);
+}
\ No newline at end of file
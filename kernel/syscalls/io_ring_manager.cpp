@@ -0,0 +1,234 @@
+#include <kernel/syscalls/io_ring_manager.h>
+
+#include <kernel/kernel.h>
+#include <kernel/memory/paging_manager.h>
+#include <kernel/memory/utils.h>
+#include <kernel/memory/virtual_allocator.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+#include <kernel/threading/lock_guard.h>
+#include <kernel/threading/unique_lock.h>
+#include <kernel/vfs/poll_set.h>
+
+static_assert(IO_RING_ADDRESS + IO_RING_SIZE <= USER_THREAD_STACKS_BOTTOM,
+              "The IO ring overlaps the user thread stacks");
+
+influx::syscalls::io_ring_manager::io_ring_manager() : _mutex("io_rings"), _rings(nullptr) {}
+
+int64_t influx::syscalls::io_ring_manager::setup(uint32_t entries) {
+    uint64_t pid = kernel::scheduler()->get_current_process_id();
+    io_ring_t *ring = nullptr;
+    io_ring_context *context = nullptr;
+
+    // The amount of entries must be a power of 2 so the indices can wrap around
+    if (entries == 0 || entries > IO_RING_MAX_ENTRIES || (entries & (entries - 1)) != 0) {
+        return -EINVAL;
+    }
+
+    threading::lock_guard lk(_mutex);
+
+    // Each process can have only one ring since it's mapped in a fixed address
+    if (_rings.at(pid) != nullptr) {
+        return -EBUSY;
+    }
+
+    // Allocate the ring in the kernel so it can be accessed safely from the kernel
+    ring = (io_ring_t *)memory::virtual_allocator::allocate(IO_RING_SIZE, PROT_READ | PROT_WRITE);
+    if (ring == nullptr) {
+        return -ENOMEM;
+    }
+    memory::utils::memset(ring, 0, IO_RING_SIZE);
+    ring->sq_entries = entries;
+    ring->cq_entries = entries * 2;
+
+    // Map the pages of the ring to the process
+    for (uint64_t offset = 0; offset < IO_RING_SIZE; offset += PAGE_SIZE) {
+        if (!memory::paging_manager::map_page(
+                IO_RING_ADDRESS + offset,
+                (int64_t)(memory::paging_manager::get_physical_address((uint64_t)ring + offset) /
+                          PAGE_SIZE))) {
+            unmap_ring(ring, offset);
+            memory::virtual_allocator::free(ring, IO_RING_SIZE);
+            return -ENOMEM;
+        }
+
+        memory::paging_manager::set_pte_permissions(IO_RING_ADDRESS + offset,
+                                                    PROT_READ | PROT_WRITE, true);
+    }
+
+    // Save the ring of the process
+    context = new io_ring_context();
+    context->ring = ring;
+    context->sq_head = 0;
+    context->cq_tail = 0;
+    context->references = 1;
+    _rings[pid] = context;
+
+    return IO_RING_ADDRESS;
+}
+
+int64_t influx::syscalls::io_ring_manager::enter(uint32_t to_submit) {
+    io_ring_context *context = nullptr;
+    int64_t submitted = 0;
+
+    // Get the ring of the process and take a reference of it so it won't be freed while it's used
+    threading::unique_lock lk(_mutex);
+    context = _rings.at(kernel::scheduler()->get_current_process_id());
+    if (context == nullptr) {
+        return -EINVAL;
+    }
+    context->references++;
+    lk.unlock();
+
+    // Submit the entries and release the reference
+    submitted = submit(context, to_submit);
+    put_context(context);
+
+    return submitted;
+}
+
+void influx::syscalls::io_ring_manager::release() {
+    uint64_t pid = kernel::scheduler()->get_current_process_id();
+    io_ring_context *context = nullptr;
+
+    threading::unique_lock lk(_mutex);
+
+    // Check if the process has a ring
+    context = _rings.at(pid);
+    if (context == nullptr) {
+        return;
+    }
+    _rings.erase(pid);
+    lk.unlock();
+
+    // Unmap the ring before the process' memory is freed since the pages are owned by the kernel
+    unmap_ring(context->ring, IO_RING_SIZE);
+
+    // Release the reference of the process, the ring is freed when running submissions end
+    put_context(context);
+}
+
+int64_t influx::syscalls::io_ring_manager::submit(influx::syscalls::io_ring_context *context,
+                                                  uint32_t to_submit) {
+    io_ring_t *ring = context->ring;
+    io_ring_sqe_t sqe;
+    uint32_t available = 0, submitted = 0;
+    int64_t result = 0;
+
+    threading::lock_guard ring_lk(context->mutex);
+
+    // The tail is written by userland so it must be verified
+    available = ring->sq_tail - context->sq_head;
+    if (available > ring->sq_entries) {
+        return -EINVAL;
+    }
+
+    while (submitted < to_submit && submitted < available) {
+        // Stop when the completion queue is full, the rest are submitted in the next call
+        if (context->cq_tail - ring->cq_head >= ring->cq_entries) {
+            break;
+        }
+
+        // Copy the entry so it can't be changed while it's executed
+        sqe = ring->sqes[context->sq_head & (ring->sq_entries - 1)];
+        context->sq_head++;
+        ring->sq_head = context->sq_head;
+
+        // Execute the entry
+        result = execute(sqe);
+
+        // Post the completion and only then publish the new tail
+        ring->cqes[context->cq_tail & (ring->cq_entries - 1)] =
+            io_ring_cqe_t{.user_data = sqe.user_data, .result = result};
+        __asm__ __volatile__("" ::: "memory");
+        context->cq_tail++;
+        ring->cq_tail = context->cq_tail;
+
+        submitted++;
+
+        // Let the signal be handled before submitting more entries
+        if (kernel::scheduler()->interrupted()) {
+            break;
+        }
+    }
+
+    return submitted;
+}
+
+void influx::syscalls::io_ring_manager::put_context(influx::syscalls::io_ring_context *context) {
+    threading::unique_lock lk(_mutex);
+
+    // Free the ring when its last reference is released
+    if (--context->references != 0) {
+        return;
+    }
+    lk.unlock();
+
+    memory::virtual_allocator::free(context->ring, IO_RING_SIZE);
+    delete context;
+}
+
+int64_t influx::syscalls::io_ring_manager::execute(const io_ring_sqe_t &sqe) {
+    switch (sqe.opcode) {
+        case IO_RING_OP_NOP:
+            return 0;
+
+        case IO_RING_OP_READ:
+            return handlers::read((size_t)sqe.fd, (void *)sqe.addr, sqe.length);
+
+        case IO_RING_OP_WRITE:
+            return handlers::write((size_t)sqe.fd, (const void *)sqe.addr, sqe.length);
+
+        case IO_RING_OP_PREAD:
+            return handlers::pread64((size_t)sqe.fd, (void *)sqe.addr, sqe.length,
+                                     (int64_t)sqe.offset);
+
+        case IO_RING_OP_PWRITE:
+            return handlers::pwrite64((size_t)sqe.fd, (const void *)sqe.addr, sqe.length,
+                                      (int64_t)sqe.offset);
+
+        case IO_RING_OP_OPEN:
+            return handlers::open((const char *)sqe.addr, (int)sqe.op_flags, (int)sqe.length);
+
+        case IO_RING_OP_CLOSE:
+            return handlers::close((size_t)sqe.fd);
+
+        case IO_RING_OP_FSYNC:
+            return handlers::fsync((size_t)sqe.fd);
+
+        case IO_RING_OP_POLL:
+            return poll(sqe);
+
+        default:
+            return -EINVAL;
+    }
+}
+
+void influx::syscalls::io_ring_manager::unmap_ring(const io_ring_t *ring, uint64_t size) {
+    for (uint64_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        // Only unmap the pages if they are still mapped to the ring
+        if (memory::paging_manager::get_physical_address(IO_RING_ADDRESS + offset) ==
+            memory::paging_manager::get_physical_address((uint64_t)ring + offset)) {
+            memory::paging_manager::unmap_page(IO_RING_ADDRESS + offset);
+        }
+    }
+}
+
+int64_t influx::syscalls::io_ring_manager::poll(const io_ring_sqe_t &sqe) {
+    vfs::poll_request request{.fd = sqe.fd, .events = (uint16_t)sqe.op_flags, .revents = 0};
+    vfs::poll_set set(&request, 1);
+    int64_t ready = 0;
+
+    // Wait until the file is ready for the requested events
+    if ((ready = set.wait(POLL_INFINITE_TIMEOUT)) < 0) {
+        return utils::convert_vfs_error((vfs::error)ready);
+    }
+
+    // Closed file descriptors are reported like in poll
+    if (request.revents & VFS_POLL_INVALID) {
+        return -EBADF;
+    }
+
+    return request.revents;
+}
\ No newline at end of file
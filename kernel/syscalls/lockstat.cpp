@@ -0,0 +1,23 @@
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/threading/lockstat.h>
+
+int64_t influx::syscalls::handlers::lockstat(uint64_t op) {
+#ifdef LOCKSTAT
+    switch (op) {
+        case LOCKSTAT_DUMP:
+            threading::lockstat::dump();
+            return 0;
+
+        case LOCKSTAT_RESET:
+            threading::lockstat::reset();
+            return 0;
+
+        default:
+            return -EINVAL;
+    }
+#else
+    // The kernel wasn't built with lockstat enabled
+    return -ENOSYS;
+#endif
+}
\ No newline at end of file
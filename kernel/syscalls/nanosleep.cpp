@@ -0,0 +1,45 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::nanosleep(const influx::time::timespec *req,
+                                              influx::time::timespec *rem) {
+    time::timespec ts, remaining_ts;
+    uint64_t deadline = 0, now = 0, remaining = 0;
+
+    // Copy the requested time from the user
+    if (!utils::copy_from_user(&ts, req, sizeof(time::timespec))) {
+        return -EFAULT;
+    }
+
+    // Verify the requested time
+    if (ts.nseconds >= NSECONDS_IN_SECOND) {
+        return -EINVAL;
+    }
+
+    // Sleep until the deadline since the scheduler only sleeps for whole ticks
+    deadline = kernel::time_manager()->monotonic_ns() + ts.seconds * NSECONDS_IN_SECOND +
+               ts.nseconds;
+    while ((now = kernel::time_manager()->monotonic_ns()) < deadline) {
+        // Round the remaining time up to the next millisecond
+        remaining = deadline - now;
+        kernel::scheduler()->sleep((remaining + NSECONDS_IN_MILLISECOND - 1) /
+                                   NSECONDS_IN_MILLISECOND);
+        if (kernel::scheduler()->interrupted()) {
+            // Return the remaining time if requested
+            now = kernel::time_manager()->monotonic_ns();
+            remaining = deadline > now ? deadline - now : 0;
+            remaining_ts = time::timespec{.seconds = remaining / NSECONDS_IN_SECOND,
+                                          .nseconds = remaining % NSECONDS_IN_SECOND};
+            if (rem != nullptr &&
+                !utils::copy_to_user(rem, &remaining_ts, sizeof(time::timespec))) {
+                return -EFAULT;
+            }
+
+            return -EINTR;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -1,24 +1,54 @@
 #include <kernel/kernel.h>
 #include <kernel/syscalls/error.h>
+#include <kernel/syscalls/fcntl.h>
 #include <kernel/syscalls/handlers.h>
 #include <kernel/syscalls/utils.h>
 
 int64_t influx::syscalls::handlers::pipe(int *pipefd) {
     uint64_t read_fd = 0, write_fd = 0;
+    int fds[2] = {0, 0};
 
-    // Check if the buffer is in the user memory
-    if (!utils::is_buffer_in_user_memory(pipefd, sizeof(int) * 2, PROT_WRITE)) {
+    // Create the pipe
+    if (!kernel::vfs()->pipe_handler()->create_pipe(&read_fd, &write_fd)) {
         return -EFAULT;
     }
 
+    // Copy the file descriptors to the user, close the pipe if they can't be returned
+    fds[0] = (int)read_fd;
+    fds[1] = (int)write_fd;
+    if (!utils::copy_to_user(pipefd, fds, sizeof(fds))) {
+        kernel::vfs()->close(read_fd);
+        kernel::vfs()->close(write_fd);
+        return -EFAULT;
+    }
+
+    return 0;
+}
+
+int64_t influx::syscalls::handlers::pipe2(int *pipefd, int flags) {
+    uint64_t read_fd = 0, write_fd = 0;
+    int fds[2] = {0, 0};
+
+    // Verify the flags
+    if (flags & ~O_NONBLOCK) {
+        return -EINVAL;
+    }
+
     // Create the pipe
-    if (!kernel::vfs()->pipe_handler()->create_pipe(&read_fd, &write_fd)) {
+    if (!kernel::vfs()->pipe_handler()->create_pipe(
+            &read_fd, &write_fd,
+            (flags & O_NONBLOCK) ? vfs::open_flags::non_blocking : (vfs::open_flags)0)) {
         return -EFAULT;
     }
 
-    // Set file descriptors
-    pipefd[0] = (int)read_fd;
-    pipefd[1] = (int)write_fd;
+    // Copy the file descriptors to the user, close the pipe if they can't be returned
+    fds[0] = (int)read_fd;
+    fds[1] = (int)write_fd;
+    if (!utils::copy_to_user(pipefd, fds, sizeof(fds))) {
+        kernel::vfs()->close(read_fd);
+        kernel::vfs()->close(write_fd);
+        return -EFAULT;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <kernel/kernel.h>
+#include <kernel/structures/vector.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+#include <kernel/vfs/poll_set.h>
+
+int64_t influx::syscalls::handlers::poll(influx::syscalls::pollfd *fds, uint64_t nfds,
+                                         int64_t timeout_ms) {
+    structures::vector<pollfd> user_fds;
+    structures::vector<vfs::poll_request> requests;
+    int64_t ready = 0;
+
+    // Verify the amount of file descriptors
+    if (nfds > POLL_MAX_FDS) {
+        return -EINVAL;
+    }
+
+    // Copy the file descriptors from the user
+    user_fds = structures::vector<pollfd>(nfds);
+    if (!utils::copy_from_user(user_fds.data(), fds, sizeof(pollfd) * nfds)) {
+        return -EFAULT;
+    }
+
+    // Create the requests
+    requests = structures::vector<vfs::poll_request>(nfds);
+    for (uint64_t i = 0; i < nfds; i++) {
+        requests[i] = vfs::poll_request{
+            .fd = user_fds[i].fd, .events = (uint16_t)user_fds[i].events, .revents = 0};
+    }
+
+    // Wait for the files to become ready
+    {
+        vfs::poll_set set(requests.data(), nfds);
+        ready = set.wait(timeout_ms < 0 ? POLL_INFINITE_TIMEOUT : timeout_ms);
+    }
+    if (ready < 0) {
+        return utils::convert_vfs_error((vfs::error)ready);
+    }
+
+    // Return the events of each file
+    for (uint64_t i = 0; i < nfds; i++) {
+        user_fds[i].revents = (short)requests[i].revents;
+    }
+    if (!utils::copy_to_user(fds, user_fds.data(), sizeof(pollfd) * nfds)) {
+        return -EFAULT;
+    }
+
+    return ready;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::pread64(size_t fd, void *buf, size_t count, int64_t offset) {
+    int64_t read;
+
+    // Check valid buffer range, faults in the buffer are handled by the filesystems
+    if (!utils::is_range_in_user_memory(buf, count)) {
+        return -EFAULT;
+    }
+
+    // Verify valid offset
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    // Try to read from the offset in the file
+    read = kernel::vfs()->read(fd, buf, count, offset);
+
+    // Handle errors
+    if (read < 0) {
+        return utils::convert_vfs_error((vfs::error)read);
+    }
+
+    return read;
+}
+
+int64_t influx::syscalls::handlers::preadv(size_t fd, const vfs::io_vector *iov, int64_t iovcnt,
+                                           int64_t offset) {
+    structures::vector<vfs::io_vector> vectors;
+    int64_t read;
+
+    // Copy and check the vectors
+    if ((read = utils::copy_io_vectors_from_user(iov, iovcnt, vectors)) < 0) {
+        return read;
+    }
+
+    // Verify valid offset
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    // Try to read from the offset in the file to the vectors
+    read = kernel::vfs()->readv(fd, vectors.data(), vectors.size(), offset);
+
+    // Handle errors
+    if (read < 0) {
+        return utils::convert_vfs_error((vfs::error)read);
+    }
+
+    return read;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::pwrite64(size_t fd, const void *buf, size_t count,
+                                             int64_t offset) {
+    int64_t write;
+
+    // Check valid buffer range, faults in the buffer are handled by the filesystems
+    if (!utils::is_range_in_user_memory(buf, count)) {
+        return -EFAULT;
+    }
+
+    // Verify valid offset
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    // Try to write to the offset in the file
+    write = kernel::vfs()->write(fd, buf, count, offset);
+
+    // Handle errors
+    if (write < 0) {
+        return utils::convert_vfs_error((vfs::error)write);
+    }
+
+    return write;
+}
+
+int64_t influx::syscalls::handlers::pwritev(size_t fd, const vfs::io_vector *iov, int64_t iovcnt,
+                                            int64_t offset) {
+    structures::vector<vfs::io_vector> vectors;
+    int64_t write;
+
+    // Copy and check the vectors
+    if ((write = utils::copy_io_vectors_from_user(iov, iovcnt, vectors)) < 0) {
+        return write;
+    }
+
+    // Verify valid offset
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    // Try to write the vectors to the offset in the file
+    write = kernel::vfs()->writev(fd, vectors.data(), vectors.size(), offset);
+
+    // Handle errors
+    if (write < 0) {
+        return utils::convert_vfs_error((vfs::error)write);
+    }
+
+    return write;
+}
\ No newline at end of file
@@ -6,8 +6,8 @@
 int64_t influx::syscalls::handlers::read(size_t fd, void *buf, size_t count) {
     int64_t read;
 
-    // Check valid buffer
-    if (!utils::is_buffer_in_user_memory(buf, count, PROT_WRITE)) {
+    // Check valid buffer range, faults in the buffer are handled by the filesystems
+    if (!utils::is_range_in_user_memory(buf, count)) {
         return -EFAULT;
     }
 
@@ -0,0 +1,24 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::readv(size_t fd, const vfs::io_vector *iov, int64_t iovcnt) {
+    structures::vector<vfs::io_vector> vectors;
+    int64_t read;
+
+    // Copy and check the vectors
+    if ((read = utils::copy_io_vectors_from_user(iov, iovcnt, vectors)) < 0) {
+        return read;
+    }
+
+    // Try to read from the file to the vectors
+    read = kernel::vfs()->readv(fd, vectors.data(), vectors.size());
+
+    // Handle errors
+    if (read < 0) {
+        return utils::convert_vfs_error((vfs::error)read);
+    }
+
+    return read;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <kernel/kernel.h>
+#include <kernel/memory/utils.h>
+#include <kernel/structures/vector.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+#include <kernel/vfs/poll_set.h>
+
+namespace {
+bool is_fd_set(const uint64_t *set, uint64_t fd) {
+    return set != nullptr &&
+           (set[fd / SELECT_BITS_PER_WORD] & ((uint64_t)1 << (fd % SELECT_BITS_PER_WORD)));
+}
+};  // namespace
+
+int64_t influx::syscalls::handlers::select(uint64_t nfds, uint64_t *readfds, uint64_t *writefds,
+                                           uint64_t *exceptfds, influx::time::timeval *timeout) {
+    uint64_t words = (nfds + SELECT_BITS_PER_WORD - 1) / SELECT_BITS_PER_WORD;
+    uint64_t *user_sets[] = {readfds, writefds, exceptfds};
+    uint64_t kernel_sets[3][SELECT_MAX_FDS / SELECT_BITS_PER_WORD];
+    uint64_t *sets[] = {nullptr, nullptr, nullptr};
+    structures::vector<vfs::poll_request> requests;
+    time::timeval kernel_timeout;
+    int64_t timeout_ms = POLL_INFINITE_TIMEOUT, ready = 0;
+    uint16_t events = 0;
+
+    // Verify the amount of file descriptors
+    if (nfds > SELECT_MAX_FDS) {
+        return -EINVAL;
+    }
+
+    // Copy the sets from the user
+    for (uint64_t i = 0; i < 3; i++) {
+        if (user_sets[i] != nullptr) {
+            if (!utils::copy_from_user(kernel_sets[i], user_sets[i], sizeof(uint64_t) * words)) {
+                return -EFAULT;
+            }
+            sets[i] = kernel_sets[i];
+        }
+    }
+
+    // Get the timeout in milliseconds
+    if (timeout != nullptr) {
+        if (!utils::copy_from_user(&kernel_timeout, timeout, sizeof(time::timeval))) {
+            return -EFAULT;
+        }
+        timeout_ms = (int64_t)(kernel_timeout.seconds * 1000 + kernel_timeout.useconds / 1000);
+    }
+
+    // Create a request for each file descriptor in the sets
+    for (uint64_t fd = 0; fd < nfds; fd++) {
+        events = (uint16_t)((is_fd_set(sets[0], fd) ? VFS_POLL_IN : 0) |
+                            (is_fd_set(sets[1], fd) ? VFS_POLL_OUT : 0) |
+                            (is_fd_set(sets[2], fd) ? VFS_POLL_PRIORITY : 0));
+        if (events != 0) {
+            requests.push_back(
+                vfs::poll_request{.fd = (int64_t)fd, .events = events, .revents = 0});
+        }
+    }
+
+    // Wait for the files to become ready
+    {
+        vfs::poll_set set(requests.data(), requests.size());
+        ready = set.wait(timeout_ms);
+    }
+    if (ready < 0) {
+        return utils::convert_vfs_error((vfs::error)ready);
+    }
+
+    // Select fails on closed file descriptors
+    for (const auto &request : requests) {
+        if (request.revents & VFS_POLL_INVALID) {
+            return -EBADF;
+        }
+    }
+
+    // Clear the sets and mark the ready files
+    for (uint64_t *set : sets) {
+        if (set != nullptr) {
+            memory::utils::memset(set, 0, sizeof(uint64_t) * words);
+        }
+    }
+    ready = 0;
+    for (const auto &request : requests) {
+        if (sets[0] != nullptr &&
+            (request.revents & (VFS_POLL_IN | VFS_POLL_HANG_UP | VFS_POLL_ERROR))) {
+            sets[0][request.fd / SELECT_BITS_PER_WORD] |=
+                (uint64_t)1 << (request.fd % SELECT_BITS_PER_WORD);
+            ready++;
+        }
+        if (sets[1] != nullptr && (request.revents & (VFS_POLL_OUT | VFS_POLL_ERROR))) {
+            sets[1][request.fd / SELECT_BITS_PER_WORD] |=
+                (uint64_t)1 << (request.fd % SELECT_BITS_PER_WORD);
+            ready++;
+        }
+        if (sets[2] != nullptr && (request.revents & VFS_POLL_PRIORITY)) {
+            sets[2][request.fd / SELECT_BITS_PER_WORD] |=
+                (uint64_t)1 << (request.fd % SELECT_BITS_PER_WORD);
+            ready++;
+        }
+    }
+
+    // Copy the sets to the user
+    for (uint64_t i = 0; i < 3; i++) {
+        if (sets[i] != nullptr &&
+            !utils::copy_to_user(user_sets[i], sets[i], sizeof(uint64_t) * words)) {
+            return -EFAULT;
+        }
+    }
+
+    return ready;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::sendfile(size_t out_fd, size_t in_fd, int64_t *offset,
+                                             size_t count) {
+    int64_t in_offset = VFS_CURRENT_POSITION, transferred;
+
+    // Read the offset of the input file if given
+    if (offset != nullptr) {
+        if (!utils::copy_from_user(&in_offset, offset, sizeof(int64_t))) {
+            return -EFAULT;
+        }
+
+        // Verify valid offset
+        if (in_offset < 0) {
+            return -EINVAL;
+        }
+    }
+
+    // Move the data between the files
+    transferred = kernel::vfs()->splice(in_fd, in_offset, out_fd, VFS_CURRENT_POSITION, count);
+
+    // Handle errors
+    if (transferred < 0) {
+        return utils::convert_vfs_error((vfs::error)transferred);
+    }
+
+    // Return the offset after the last byte that was read
+    in_offset += transferred;
+    if (offset != nullptr && !utils::copy_to_user(offset, &in_offset, sizeof(int64_t))) {
+        return -EFAULT;
+    }
+
+    return transferred;
+}
\ No newline at end of file
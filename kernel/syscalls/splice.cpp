@@ -0,0 +1,51 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::splice(size_t fd_in, int64_t *off_in, size_t fd_out,
+                                           int64_t *off_out, size_t len, uint64_t flags) {
+    int64_t in_offset = VFS_CURRENT_POSITION, out_offset = VFS_CURRENT_POSITION, transferred;
+
+    // Read the offset of the input file if given
+    if (off_in != nullptr) {
+        if (!utils::copy_from_user(&in_offset, off_in, sizeof(int64_t))) {
+            return -EFAULT;
+        }
+
+        // Verify valid offset
+        if (in_offset < 0) {
+            return -EINVAL;
+        }
+    }
+
+    // Read the offset of the output file if given
+    if (off_out != nullptr) {
+        if (!utils::copy_from_user(&out_offset, off_out, sizeof(int64_t))) {
+            return -EFAULT;
+        }
+
+        // Verify valid offset
+        if (out_offset < 0) {
+            return -EINVAL;
+        }
+    }
+
+    // Move the data between the files
+    transferred = kernel::vfs()->splice(fd_in, in_offset, fd_out, out_offset, len);
+
+    // Handle errors
+    if (transferred < 0) {
+        return utils::convert_vfs_error((vfs::error)transferred);
+    }
+
+    // Advance the given offsets instead of the positions of the files
+    in_offset += transferred;
+    out_offset += transferred;
+    if ((off_in != nullptr && !utils::copy_to_user(off_in, &in_offset, sizeof(int64_t))) ||
+        (off_out != nullptr && !utils::copy_to_user(off_out, &out_offset, sizeof(int64_t)))) {
+        return -EFAULT;
+    }
+
+    return transferred;
+}
\ No newline at end of file
@@ -6,28 +6,34 @@
 influx::syscalls::stat convert_file_info_to_stat(influx::vfs::file_info &info);
 
 int64_t influx::syscalls::handlers::stat(const char *file_name, influx::syscalls::stat *stat) {
+    structures::string name;
     vfs::path file_path;
     vfs::file_info info;
+    syscalls::stat file_stat;
     vfs::error err;
 
-    // Check valid file path and file info
-    if (!utils::is_string_in_user_memory(file_name) ||
-        !utils::is_buffer_in_user_memory(stat, sizeof(stat), PROT_READ | PROT_WRITE)) {
-        return -EFAULT;
+    int64_t copy_err;
+
+    // Copy the file path
+    if ((copy_err = utils::copy_string_from_user(file_name, name)) < 0) {
+        return copy_err;
     }
 
     // If the file path is relative, try to make it absolute
-    file_path = vfs::path(file_name);
+    file_path = vfs::path(name);
     if (file_path.is_relative()) {
-        file_path = kernel::scheduler()->get_working_dir() + file_name;
+        file_path = kernel::scheduler()->get_working_dir() + name;
     }
 
     // Try to get the stat of the file
     err = (vfs::error)kernel::vfs()->stat(file_path, info);
 
-    // Convert file info to stat struct
+    // Convert file info to stat struct and copy it to the user
     if (err == vfs::error::success) {
-        *stat = convert_file_info_to_stat(info);
+        file_stat = convert_file_info_to_stat(info);
+        if (!utils::copy_to_user(stat, &file_stat, sizeof(syscalls::stat))) {
+            return -EFAULT;
+        }
     }
 
     return utils::convert_vfs_error(err);
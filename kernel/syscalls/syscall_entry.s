@@ -0,0 +1,74 @@
+%include "macros.s"
+
+%define SYSCALL_INTERRUPT 0x80
+
+%define USER_DATA_SELECTOR 0x18 + 11b
+%define USER_CODE_SELECTOR 0x20 + 11b
+
+%define REGS_RIP_OFFSET 0
+%define REGS_RFLAGS_OFFSET 16
+%define REGS_RSP_OFFSET 24
+
+extern isr_handler
+
+section .bss
+global syscall_kernel_stack
+syscall_kernel_stack:
+    resq 1
+syscall_user_stack:
+    resq 1
+
+section .text
+global syscall_entry
+
+;   The entry point of the SYSCALL instruction
+
+;   rax = syscall number
+;   rcx = return address
+;   r11 = user RFLAGS
+;   rdx, rdi, rsi, r10, r8, r9 = arguments
+syscall_entry:
+;   Switch to the kernel stack of the current thread (interrupts are masked by SFMASK)
+    mov [rel syscall_user_stack], rsp
+    mov rsp, [rel syscall_kernel_stack]
+    and rsp, ~0xF
+
+;   Build the same stack frame as the syscall interrupt so signals and fork can use it
+    push USER_DATA_SELECTOR
+    push qword [rel syscall_user_stack]
+    push r11
+    push USER_CODE_SELECTOR
+    push rcx
+    push 0
+    push SYSCALL_INTERRUPT
+
+;   Save the current context
+    save_context
+
+;   Syscalls run with interrupts enabled like the syscall interrupt
+    sti
+
+;   Call the ISR handler in the interrupt manager
+    mov rdi, rsp
+    call isr_handler
+
+    cli
+
+;   Restore the context
+    restore_context
+
+;	Clean error code and interrupt number
+    add rsp, 16
+
+;   If a signal changed the return frame, return with IRETQ since SYSRET overrides RCX and R11
+    cmp rcx, [rsp + REGS_RIP_OFFSET]
+    jne .iret
+    cmp r11, [rsp + REGS_RFLAGS_OFFSET]
+    jne .iret
+
+;   Return to the user stack
+    mov rsp, [rsp + REGS_RSP_OFFSET]
+    o64 sysret
+
+.iret:
+    iretq
\ No newline at end of file
@@ -1,16 +1,31 @@
 #include <kernel/syscalls/syscall_manager.h>
 
+#include <kernel/gdt.h>
 #include <kernel/interrupts/interrupt_manager.h>
 #include <kernel/kernel.h>
+#include <kernel/msr.h>
 #include <kernel/syscalls/error.h>
 #include <kernel/syscalls/handlers.h>
+#include <kernel/time/tsc_clocksource.h>
 
 void influx::syscalls::syscall_interrupt_handler(influx::interrupts::regs *context) {
     threading::signal before_signal = kernel::syscall_manager()->get_signal();
+    syscall_tracer &tracer = kernel::syscall_manager()->tracer();
+    syscall number = (syscall)context->rax;
+    uint64_t args[SYSCALL_TRACER_ARGUMENTS] = {context->rdx, context->rdi, context->rsi,
+                                               context->r10, context->r8,  context->r9};
+    bool traced = tracer.enabled();
+    uint64_t start_time = traced ? time::tsc_clocksource::rdtsc() : 0;
 
     // Handle the syscall and return result in RAX
-    context->rax = kernel::syscall_manager()->handle_syscall(
-        (syscall)context->rax, context->rdx, context->rdi, context->rsi, context->r10, context);
+    context->rax = kernel::syscall_manager()->handle_syscall(number, args[0], args[1], args[2],
+                                                             args[3], context);
+
+    // Record the syscall if the tracer was enabled when it was called
+    if (traced) {
+        tracer.record(number, args, (int64_t)context->rax,
+                      time::tsc_clocksource::rdtsc() - start_time);
+    }
 
     // If the syscall interrupted (the signal had changed during execution), save the return code
     if (before_signal != kernel::syscall_manager()->get_signal() && before_signal == SIGINVL) {
@@ -26,6 +41,28 @@ influx::syscalls::syscall_manager::syscall_manager()
     kernel::interrupt_manager()->set_interrupt_service_routine(SYSCALL_INTERRUPT,
                                                                (uint64_t)syscall_interrupt_handler);
     kernel::interrupt_manager()->set_interrupt_privilege_level(SYSCALL_INTERRUPT, 3);
+
+    // Enable the SYSCALL instruction which skips the IDT
+    _log("Enabling the SYSCALL instruction..\n");
+    init_syscall_instruction();
+}
+
+void influx::syscalls::syscall_manager::init_syscall_instruction() {
+    // SYSCALL loads the kernel selectors and SYSRET loads the user data selector + 8 and
+    // user code selector + 16
+    msr::write(MSR_STAR,
+               ((uint64_t)gdt_selector_types::code_descriptor << STAR_KERNEL_SELECTORS_SHIFT) |
+                   (((uint64_t)gdt_selector_types::user_data_descriptor - 8)
+                    << STAR_USER_SELECTORS_SHIFT));
+
+    // Set the entry point of the SYSCALL instruction
+    msr::write(MSR_LSTAR, (uint64_t)syscall_entry);
+
+    // Mask interrupts until the entry switches to the kernel stack
+    msr::write(MSR_SFMASK, RFLAGS_INTERRUPT_FLAG | RFLAGS_TRAP_FLAG | RFLAGS_DIRECTION_FLAG);
+
+    // Enable the SYSCALL instruction
+    msr::write(MSR_EFER, msr::read(MSR_EFER) | EFER_SYSCALL_ENABLE);
 }
 
 int64_t influx::syscalls::syscall_manager::handle_syscall(influx::syscalls::syscall syscall,
@@ -37,7 +74,7 @@ int64_t influx::syscalls::syscall_manager::handle_syscall(influx::syscalls::sysc
     // Call the syscall handler for the wanted syscall
     switch (syscall) {
         case syscall::exit:
-            kernel::scheduler()->exit((uint8_t)arg1);
+            kernel::scheduler()->exit_thread((uint8_t)arg1);
             return 0;
 
         case syscall::close:
@@ -82,8 +119,7 @@ int64_t influx::syscalls::syscall_manager::handle_syscall(influx::syscalls::sysc
             return handlers::stat((const char *)arg1, (stat *)arg2);
 
         case syscall::times:
-            // TODO: Implement
-            return -EFAULT;
+            return handlers::times((tms *)arg1);
 
         case syscall::unlink:
             return handlers::unlink((const char *)arg1);
@@ -149,6 +185,104 @@ int64_t influx::syscalls::syscall_manager::handle_syscall(influx::syscalls::sysc
             return handlers::sigprocmask((int)arg1, (const threading::signal_mask *)arg2,
                                          (threading::signal_mask *)arg3);
 
+        case syscall::clone:
+            return handlers::clone(arg1, arg2, arg3, arg4, (uint32_t *)context->r8);
+
+        case syscall::gettid:
+            return kernel::scheduler()->get_current_task_id();
+
+        case syscall::arch_prctl:
+            return handlers::arch_prctl(arg1, arg2);
+
+        case syscall::exit_group:
+            kernel::scheduler()->exit((uint8_t)arg1);
+            return 0;
+
+        case syscall::futex:
+            return handlers::futex((uint32_t *)arg1, (int)arg2, (uint32_t)arg3,
+                                   (const time::timespec *)arg4, (uint32_t *)context->r8,
+                                   (uint32_t)context->r9);
+
+        case syscall::lockstat:
+            return handlers::lockstat(arg1);
+
+        case syscall::clock_gettime:
+            return handlers::clock_gettime(arg1, (time::timespec *)arg2);
+
+        case syscall::clock_getres:
+            return handlers::clock_getres(arg1, (time::timespec *)arg2);
+
+        case syscall::nanosleep:
+            return handlers::nanosleep((const time::timespec *)arg1, (time::timespec *)arg2);
+
+        case syscall::systrace:
+            return handlers::systrace(arg1, arg2);
+
+        case syscall::pread64:
+            return handlers::pread64(arg1, (void *)arg2, arg3, (int64_t)arg4);
+
+        case syscall::pwrite64:
+            return handlers::pwrite64(arg1, (const void *)arg2, arg3, (int64_t)arg4);
+
+        case syscall::readv:
+            return handlers::readv(arg1, (const vfs::io_vector *)arg2, (int64_t)arg3);
+
+        case syscall::writev:
+            return handlers::writev(arg1, (const vfs::io_vector *)arg2, (int64_t)arg3);
+
+        case syscall::preadv:
+            return handlers::preadv(arg1, (const vfs::io_vector *)arg2, (int64_t)arg3,
+                                    (int64_t)arg4);
+
+        case syscall::pwritev:
+            return handlers::pwritev(arg1, (const vfs::io_vector *)arg2, (int64_t)arg3,
+                                     (int64_t)arg4);
+
+        case syscall::fsync:
+            return handlers::fsync(arg1);
+
+        case syscall::io_ring_setup:
+            return handlers::io_ring_setup((uint32_t)arg1);
+
+        case syscall::io_ring_enter:
+            return handlers::io_ring_enter((uint32_t)arg1);
+
+        case syscall::poll:
+            return handlers::poll((pollfd *)arg1, arg2, (int64_t)arg3);
+
+        case syscall::select:
+            return handlers::select(arg1, (uint64_t *)arg2, (uint64_t *)arg3, (uint64_t *)arg4,
+                                    (time::timeval *)context->r8);
+
+        case syscall::epoll_create:
+            return handlers::epoll_create((int64_t)arg1);
+
+        case syscall::epoll_ctl:
+            return handlers::epoll_ctl(arg1, (int)arg2, arg3, (const vfs::epoll_event *)arg4);
+
+        case syscall::epoll_wait:
+            return handlers::epoll_wait(arg1, (vfs::epoll_event *)arg2, (int64_t)arg3,
+                                        (int64_t)arg4);
+
+        case syscall::sendfile:
+            return handlers::sendfile(arg1, arg2, (int64_t *)arg3, arg4);
+
+        case syscall::splice:
+            return handlers::splice(arg1, (int64_t *)arg2, arg3, (int64_t *)arg4, context->r8,
+                                    context->r9);
+
+        case syscall::fcntl:
+            return handlers::fcntl(arg1, (int)arg2, arg3);
+
+        case syscall::pipe2:
+            return handlers::pipe2((int *)arg1, (int)arg2);
+
+        case syscall::getrusage:
+            return handlers::getrusage((int)arg1, (rusage *)arg2);
+
+        case syscall::wait4:
+            return handlers::wait4(arg1, (int *)arg2, arg3, (rusage *)arg4);
+
         default:
             return -EINVAL;
     }
@@ -0,0 +1,205 @@
+#include <kernel/syscalls/syscall_tracer.h>
+
+#include <kernel/kernel.h>
+#include <kernel/memory/utils.h>
+#include <kernel/threading/lock_guard.h>
+
+influx::syscalls::syscall_tracer::syscall_tracer()
+    : _log("Syscall Tracer", console_color::pink),
+      _mutex("syscall_tracer"),
+      _enabled(false),
+      _traced_pid(SYSTRACE_NO_PROCESS),
+      _process_stats(nullptr),
+      _ring_head(0),
+      _ring_count(0) {
+    memory::utils::memset(_stats, 0, sizeof(_stats));
+    memory::utils::memset(_ring, 0, sizeof(_ring));
+}
+
+influx::syscalls::syscall_tracer::~syscall_tracer() { clear_process_stats(); }
+
+void influx::syscalls::syscall_tracer::enable() { _enabled = true; }
+
+void influx::syscalls::syscall_tracer::disable() { _enabled = false; }
+
+void influx::syscalls::syscall_tracer::reset() {
+    threading::lock_guard lk(_mutex);
+
+    // Reset the global statistics and the trace ring
+    memory::utils::memset(_stats, 0, sizeof(_stats));
+    _ring_head = 0;
+    _ring_count = 0;
+
+    // Free the statistics of all processes
+    clear_process_stats();
+}
+
+void influx::syscalls::syscall_tracer::trace_process(uint64_t pid) {
+    threading::lock_guard lk(_mutex);
+
+    // Start a new trace for the process
+    _traced_pid = pid;
+    _ring_head = 0;
+    _ring_count = 0;
+}
+
+void influx::syscalls::syscall_tracer::record(influx::syscalls::syscall number,
+                                              const uint64_t args[SYSCALL_TRACER_ARGUMENTS],
+                                              int64_t return_value, uint64_t cycles) {
+    uint64_t pid = kernel::scheduler()->get_current_process_id();
+    syscall_stats *process_stats = nullptr;
+    syscall_trace_entry *entry = nullptr;
+
+    // Ignore syscalls that aren't in the table
+    if ((uint64_t)number >= SYSCALL_TRACER_MAX_SYSCALLS) {
+        return;
+    }
+
+    threading::lock_guard lk(_mutex);
+
+    // The tracer might have been disabled while waiting for the lock
+    if (!_enabled) {
+        return;
+    }
+
+    // Update the global statistics of the syscall
+    update_stats(_stats[(uint64_t)number], return_value, cycles);
+
+    // Get the statistics of the process and allocate them on it's first syscall
+    process_stats = _process_stats.at(pid);
+    if (process_stats == nullptr) {
+        process_stats = new syscall_stats[SYSCALL_TRACER_MAX_SYSCALLS];
+        memory::utils::memset(process_stats, 0,
+                              sizeof(syscall_stats) * SYSCALL_TRACER_MAX_SYSCALLS);
+        _process_stats[pid] = process_stats;
+    }
+    update_stats(process_stats[(uint64_t)number], return_value, cycles);
+
+    // Log the syscall in the ring if the process is traced, overwriting the oldest entry if full
+    if (pid == _traced_pid) {
+        entry = &_ring[(_ring_head + _ring_count) % SYSCALL_TRACER_RING_SIZE];
+        *entry = syscall_trace_entry{.tid = kernel::scheduler()->get_current_task_id(),
+                                     .number = number,
+                                     .args = {},
+                                     .return_value = return_value,
+                                     .cycles = cycles};
+        memory::utils::memcpy(entry->args, args, sizeof(entry->args));
+
+        if (_ring_count < SYSCALL_TRACER_RING_SIZE) {
+            _ring_count++;
+        } else {
+            _ring_head = (_ring_head + 1) % SYSCALL_TRACER_RING_SIZE;
+        }
+    }
+}
+
+bool influx::syscalls::syscall_tracer::dump(uint64_t pid) {
+    threading::lock_guard lk(_mutex);
+
+    // Dump the global statistics
+    if (pid == SYSTRACE_ALL_PROCESSES) {
+        _log("Syscall statistics of all processes (times are in TSC cycles):\n");
+        dump_stats(_stats);
+
+        return true;
+    }
+
+    // Check that the process made syscalls since the last reset
+    if (_process_stats.at(pid) == nullptr) {
+        return false;
+    }
+
+    _log("Syscall statistics of process %ld (times are in TSC cycles):\n", pid);
+    dump_stats(_process_stats.at(pid));
+
+    return true;
+}
+
+void influx::syscalls::syscall_tracer::dump_trace() {
+    const syscall_trace_entry *entry = nullptr;
+
+    threading::lock_guard lk(_mutex);
+
+    _log("Syscall trace of process %ld (%ld entries):\n", _traced_pid, _ring_count);
+    for (uint64_t i = 0; i < _ring_count; i++) {
+        entry = &_ring[(_ring_head + i) % SYSCALL_TRACER_RING_SIZE];
+
+        _log("[%ld] %s(%p, %p, %p, %p, %p, %p) = %ld <%ld>\n", entry->tid,
+             syscall_name(entry->number), entry->args[0], entry->args[1], entry->args[2],
+             entry->args[3], entry->args[4], entry->args[5], entry->return_value, entry->cycles);
+    }
+
+    // Entries are only printed once
+    _ring_head = 0;
+    _ring_count = 0;
+}
+
+void influx::syscalls::syscall_tracer::clear_process_stats() {
+    for (auto &process : _process_stats) {
+        delete[] process.second;
+    }
+
+    _process_stats.clear();
+}
+
+void influx::syscalls::syscall_tracer::update_stats(influx::syscalls::syscall_stats &stats,
+                                                    int64_t return_value, uint64_t cycles) {
+    uint64_t bucket = 0;
+
+    // Error codes are returned as small negative values
+    stats.calls++;
+    if (return_value < 0 && return_value >= -SYSCALL_TRACER_MAX_ERROR) {
+        stats.errors++;
+    }
+    stats.total_cycles += cycles;
+
+    // Each bucket holds the calls that took [2^bucket, 2^(bucket + 1)) cycles
+    if (cycles != 0) {
+        bucket = 63 - (uint64_t)__builtin_clzll(cycles);
+    }
+    if (bucket >= SYSCALL_TRACER_LATENCY_BUCKETS) {
+        bucket = SYSCALL_TRACER_LATENCY_BUCKETS - 1;
+    }
+    stats.latency_buckets[bucket]++;
+}
+
+void influx::syscalls::syscall_tracer::dump_stats(const influx::syscalls::syscall_stats *stats) {
+    for (uint64_t i = 0; i < SYSCALL_TRACER_MAX_SYSCALLS; i++) {
+        // Skip syscalls that weren't called
+        if (stats[i].calls == 0) {
+            continue;
+        }
+
+        _log("%s: %ld calls, %ld errors, %ld average\n", syscall_name((syscall)i), stats[i].calls,
+             stats[i].errors, stats[i].total_cycles / stats[i].calls);
+
+        // Print the non-empty buckets of the latency histogram
+        for (uint64_t bucket = 0; bucket < SYSCALL_TRACER_LATENCY_BUCKETS; bucket++) {
+            if (stats[i].latency_buckets[bucket] != 0) {
+                _log("    >= 2^%ld: %ld\n", bucket, stats[i].latency_buckets[bucket]);
+            }
+        }
+    }
+}
+
+const char *influx::syscalls::syscall_tracer::syscall_name(influx::syscalls::syscall number) {
+    static const char *const names[] = {
+        "exit",         "close",       "execve",     "fork",          "fstat",
+        "getpid",       "isatty",      "kill",       "link",          "lseek",
+        "open",         "read",        "sbrk",       "stat",          "times",
+        "unlink",       "waitpid",     "write",      "sigaction",     "gettimeofday",
+        "gethostname",  "sigreturn",   "sleep",      "getdents",      "chdir",
+        "getcwd",       "mkdir",       "ttyname",    "getppid",       "getuid",
+        "geteuid",      "dup",         "alarm",      "pipe",          "sigprocmask",
+        "clone",        "gettid",      "arch_prctl", "exit_group",    "futex",
+        "lockstat",     "clock_gettime", "clock_getres", "nanosleep", "systrace",
+        "pread64",      "pwrite64",    "readv",      "writev",        "preadv",
+        "pwritev",      "fsync",       "io_ring_setup", "io_ring_enter",
+        "poll",         "select",      "epoll_create", "epoll_ctl",   "epoll_wait",
+        "sendfile",     "splice",      "fcntl",      "pipe2",         "getrusage",
+        "wait4"};
+    static_assert(sizeof(names) / sizeof(const char *) == SYSCALL_TRACER_MAX_SYSCALLS,
+                  "Every syscall must have a name");
+
+    return (uint64_t)number < SYSCALL_TRACER_MAX_SYSCALLS ? names[(uint64_t)number] : "unknown";
+}
\ No newline at end of file
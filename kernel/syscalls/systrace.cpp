@@ -0,0 +1,36 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+
+int64_t influx::syscalls::handlers::systrace(uint64_t op, uint64_t arg) {
+    syscall_tracer &tracer = kernel::syscall_manager()->tracer();
+
+    switch (op) {
+        case SYSTRACE_ENABLE:
+            tracer.enable();
+            return 0;
+
+        case SYSTRACE_DISABLE:
+            tracer.disable();
+            return 0;
+
+        case SYSTRACE_RESET:
+            tracer.reset();
+            return 0;
+
+        case SYSTRACE_DUMP:
+            // The process must have made syscalls while the tracer was enabled
+            return tracer.dump(arg) ? 0 : -ESRCH;
+
+        case SYSTRACE_TRACE_PID:
+            tracer.trace_process(arg);
+            return 0;
+
+        case SYSTRACE_DUMP_TRACE:
+            tracer.dump_trace();
+            return 0;
+
+        default:
+            return -EINVAL;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+uint64_t tsc_to_clock_ticks(uint64_t cycles) {
+    return influx::kernel::time_manager()->tsc_to_nanoseconds(cycles) /
+           (NSECONDS_IN_SECOND / TIMES_CLOCKS_PER_SECOND);
+}
+
+int64_t influx::syscalls::handlers::times(influx::syscalls::tms *buf) {
+    threading::cpu_usage usage = kernel::scheduler()->get_process_cpu_usage();
+    threading::cpu_usage children_usage = kernel::scheduler()->get_children_cpu_usage();
+
+    tms process_times{.user_time = tsc_to_clock_ticks(usage.user_time),
+                      .system_time = tsc_to_clock_ticks(usage.system_time),
+                      .children_user_time = tsc_to_clock_ticks(children_usage.user_time),
+                      .children_system_time = tsc_to_clock_ticks(children_usage.system_time)};
+
+    // Copy the times to the user
+    if (!utils::copy_to_user(buf, &process_times, sizeof(tms))) {
+        return -EFAULT;
+    }
+
+    // Return the elapsed time since boot in clock ticks
+    return (int64_t)(kernel::time_manager()->monotonic_ns() /
+                     (NSECONDS_IN_SECOND / TIMES_CLOCKS_PER_SECOND));
+}
\ No newline at end of file
@@ -1,5 +1,9 @@
+#include <kernel/algorithm.h>
+#include <kernel/kernel.h>
 #include <kernel/memory/paging_manager.h>
+#include <kernel/memory/utils.h>
 #include <kernel/syscalls/error.h>
+#include <kernel/syscalls/fcntl.h>
 #include <kernel/syscalls/utils.h>
 
 int64_t influx::syscalls::utils::convert_vfs_error(influx::vfs::error err) {
@@ -46,6 +50,12 @@ int64_t influx::syscalls::utils::convert_vfs_error(influx::vfs::error err) {
         case vfs::error::pipe_closed:
             return -EPIPE;
 
+        case vfs::error::bad_address:
+            return -EFAULT;
+
+        case vfs::error::would_block:
+            return -EAGAIN;
+
         case vfs::error::unknown_error:
         case vfs::error::io_error:
         default:
@@ -53,6 +63,84 @@ int64_t influx::syscalls::utils::convert_vfs_error(influx::vfs::error err) {
     }
 }
 
+influx::vfs::open_flags influx::syscalls::utils::convert_open_flags(int flags) {
+    vfs::open_flags f = (vfs::open_flags)0;
+
+    if (flags & O_WRONLY) {
+        f = (vfs::open_flags)(f | vfs::open_flags::write);
+    } else if (flags & O_RDWR) {
+        f = (vfs::open_flags)(f | vfs::open_flags::read | vfs::open_flags::write);
+    } else {
+        f = (vfs::open_flags)(f | vfs::open_flags::read);
+    }
+
+    if (flags & O_APPEND) {
+        f = (vfs::open_flags)(f | vfs::open_flags::append);
+    }
+
+    if (flags & O_CREAT) {
+        f = (vfs::open_flags)(f | vfs::open_flags::create);
+    }
+
+    if (flags & O_DIRECTORY) {
+        f = (vfs::open_flags)(f | vfs::open_flags::directory);
+    }
+
+    if (flags & O_NONBLOCK) {
+        f = (vfs::open_flags)(f | vfs::open_flags::non_blocking);
+    }
+
+    return f;
+}
+
+int influx::syscalls::utils::convert_vfs_open_flags(influx::vfs::open_flags flags) {
+    int f = 0;
+
+    if ((flags & vfs::open_flags::read) && (flags & vfs::open_flags::write)) {
+        f |= O_RDWR;
+    } else if (flags & vfs::open_flags::write) {
+        f |= O_WRONLY;
+    } else {
+        f |= O_RDONLY;
+    }
+
+    if (flags & vfs::open_flags::append) {
+        f |= O_APPEND;
+    }
+
+    if (flags & vfs::open_flags::non_blocking) {
+        f |= O_NONBLOCK;
+    }
+
+    return f;
+}
+
+influx::syscalls::rusage influx::syscalls::utils::convert_cpu_usage(
+    const influx::threading::cpu_usage &usage) {
+    uint64_t user_ns = kernel::time_manager()->tsc_to_nanoseconds(usage.user_time);
+    uint64_t system_ns = kernel::time_manager()->tsc_to_nanoseconds(usage.system_time);
+
+    // All page faults are minor since there is no swap
+    return rusage{.user_time = time::timeval{.seconds = user_ns / NSECONDS_IN_SECOND,
+                                             .useconds = (user_ns % NSECONDS_IN_SECOND) / 1000},
+                  .system_time = time::timeval{.seconds = system_ns / NSECONDS_IN_SECOND,
+                                               .useconds = (system_ns % NSECONDS_IN_SECOND) / 1000},
+                  .max_rss = (int64_t)(usage.max_rss / 1024),
+                  .shared_memory_size = 0,
+                  .unshared_data_size = 0,
+                  .unshared_stack_size = 0,
+                  .minor_page_faults = (int64_t)usage.page_faults,
+                  .major_page_faults = 0,
+                  .swaps = 0,
+                  .block_input_operations = 0,
+                  .block_output_operations = 0,
+                  .messages_sent = 0,
+                  .messages_received = 0,
+                  .signals_received = 0,
+                  .voluntary_switches = (int64_t)usage.voluntary_switches,
+                  .involuntary_switches = (int64_t)usage.involuntary_switches};
+}
+
 bool influx::syscalls::utils::is_string_in_user_memory(const char *str) {
     // Check if surpassing the userland memory barrier
     if ((uint64_t)str > USERLAND_MEMORY_BARRIER) {
@@ -98,4 +186,90 @@ bool influx::syscalls::utils::is_buffer_in_user_memory(const void *buf, uint64_t
     }
 
     return true;
+}
+
+bool influx::syscalls::utils::is_range_in_user_memory(const void *buf, uint64_t size) {
+    // Only the range is checked, faults in the buffer are handled when it's accessed
+    return (uint64_t)buf <= USERLAND_MEMORY_BARRIER &&
+           size <= USERLAND_MEMORY_BARRIER - (uint64_t)buf;
+}
+
+bool influx::syscalls::utils::copy_from_user(void *dst, const void *user_src, uint64_t size) {
+    return is_range_in_user_memory(user_src, size) &&
+           memory::utils::memcpy_fault_safe(dst, user_src, size) == 0;
+}
+
+bool influx::syscalls::utils::copy_to_user(void *user_dst, const void *src, uint64_t size) {
+    return is_range_in_user_memory(user_dst, size) &&
+           memory::utils::memcpy_fault_safe(user_dst, src, size) == 0;
+}
+
+int64_t influx::syscalls::utils::strncpy_from_user(char *dst, const char *user_src,
+                                                   uint64_t size) {
+    uint64_t limit = 0;
+    int64_t length = 0;
+
+    // Check if surpassing the userland memory barrier
+    if ((uint64_t)user_src >= USERLAND_MEMORY_BARRIER) {
+        return -EFAULT;
+    }
+
+    // Copy the string without crossing the userland memory barrier
+    limit = algorithm::min<uint64_t>(size, USERLAND_MEMORY_BARRIER - (uint64_t)user_src);
+    length = memory::utils::strncpy_fault_safe(dst, user_src, limit);
+    if (length < 0) {
+        return -EFAULT;
+    } else if ((uint64_t)length == limit) {
+        // The string wasn't terminated before the limit
+        return limit < size ? -EFAULT : -ENAMETOOLONG;
+    }
+
+    return length;
+}
+
+int64_t influx::syscalls::utils::copy_string_from_user(const char *user_str,
+                                                       influx::structures::string &str) {
+    char *buffer = new char[USER_STRING_MAX];
+    int64_t length = strncpy_from_user(buffer, user_str, USER_STRING_MAX);
+
+    // Create the string if it was copied
+    if (length >= 0) {
+        str = structures::string(buffer, (size_t)length);
+    }
+    delete[] buffer;
+
+    return length < 0 ? length : 0;
+}
+
+int64_t influx::syscalls::utils::copy_io_vectors_from_user(
+    const influx::vfs::io_vector *user_vectors, int64_t vector_count,
+    influx::structures::vector<influx::vfs::io_vector> &vectors) {
+    uint64_t total_length = 0;
+
+    // Verify valid amount of vectors
+    if (vector_count < 0 || vector_count > IOV_MAX) {
+        return -EINVAL;
+    }
+
+    // Copy the vectors so they can't be changed after they were checked
+    vectors = structures::vector<vfs::io_vector>((size_t)vector_count);
+    if (!copy_from_user(vectors.data(), user_vectors,
+                        (uint64_t)vector_count * sizeof(vfs::io_vector))) {
+        return -EFAULT;
+    }
+
+    for (const auto &vector : vectors) {
+        // The total length must fit in the return value
+        if (vector.length > (uint64_t)INT64_MAX - total_length) {
+            return -EINVAL;
+        }
+        total_length += vector.length;
+
+        // Check valid buffer, faults in it are handled by the filesystems
+        if (!is_range_in_user_memory(vector.base, vector.length)) {
+            return -EFAULT;
+        }
+    }
+
+    return 0;
 }
\ No newline at end of file
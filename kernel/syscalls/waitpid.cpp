@@ -7,25 +7,46 @@
 #define WUNTRACED 2
 
 int64_t influx::syscalls::handlers::waitpid(int64_t pid, int *wait_status, uint64_t flags) {
+    return wait4(pid, wait_status, flags, nullptr);
+}
+
+int64_t influx::syscalls::handlers::wait4(int64_t pid, int *wait_status, uint64_t flags,
+                                          influx::syscalls::rusage *usage) {
     int64_t ret = 0;
     uint16_t kernel_wstatus = 0;
+    int user_wstatus = 0;
+    threading::cpu_usage child_usage = {};
+    syscalls::rusage child_rusage;
 
-    // Check valid wait status variable
-    if (wait_status != nullptr &&
-        !utils::is_buffer_in_user_memory(wait_status, sizeof(int), PROT_WRITE)) {
+    // Check valid wait status and usage variables
+    if ((wait_status != nullptr && !utils::is_range_in_user_memory(wait_status, sizeof(int))) ||
+        (usage != nullptr && !utils::is_range_in_user_memory(usage, sizeof(syscalls::rusage)))) {
         return -EFAULT;
     }
 
     // Wait for the child
-    ret = kernel::scheduler()->wait_for_child(
-        pid, wait_status == nullptr ? nullptr : &kernel_wstatus, (flags & WNOHANG) > 0);
+    ret = kernel::scheduler()->wait_for_child(pid, &kernel_wstatus, (flags & WNOHANG) > 0,
+                                              &child_usage);
     if (ret < 0) {
         return kernel::scheduler()->interrupted() ? -EINTR : -ECHILD;
     }
 
+    // No child has terminated
+    if (ret == 0) {
+        return 0;
+    }
+
     // Set wait status
-    if (wait_status != nullptr) {
-        *wait_status = kernel_wstatus;
+    user_wstatus = kernel_wstatus;
+    if (wait_status != nullptr && !utils::copy_to_user(wait_status, &user_wstatus, sizeof(int))) {
+        return -EFAULT;
+    }
+
+    // Set the resource usage of the child
+    child_rusage = utils::convert_cpu_usage(child_usage);
+    if (usage != nullptr &&
+        !utils::copy_to_user(usage, &child_rusage, sizeof(syscalls::rusage))) {
+        return -EFAULT;
     }
 
     return ret;
@@ -6,8 +6,8 @@
 int64_t influx::syscalls::handlers::write(size_t fd, const void *buf, size_t count) {
     int64_t write;
 
-    // Check valid buffer
-    if (!utils::is_buffer_in_user_memory(buf, count, PROT_READ)) {
+    // Check valid buffer range, faults in the buffer are handled by the filesystems
+    if (!utils::is_range_in_user_memory(buf, count)) {
         return -EFAULT;
     }
 
@@ -0,0 +1,24 @@
+#include <kernel/kernel.h>
+#include <kernel/syscalls/error.h>
+#include <kernel/syscalls/handlers.h>
+#include <kernel/syscalls/utils.h>
+
+int64_t influx::syscalls::handlers::writev(size_t fd, const vfs::io_vector *iov, int64_t iovcnt) {
+    structures::vector<vfs::io_vector> vectors;
+    int64_t write;
+
+    // Copy and check the vectors
+    if ((write = utils::copy_io_vectors_from_user(iov, iovcnt, vectors)) < 0) {
+        return write;
+    }
+
+    // Try to write the vectors to the file
+    write = kernel::vfs()->writev(fd, vectors.data(), vectors.size());
+
+    // Handle errors
+    if (write < 0) {
+        return utils::convert_vfs_error((vfs::error)write);
+    }
+
+    return write;
+}
\ No newline at end of file
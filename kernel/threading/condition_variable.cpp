@@ -1,7 +1,9 @@
 #include <kernel/threading/condition_variable.h>
 
 #include <kernel/kernel.h>
+#include <kernel/threading/interrupts_lock.h>
 #include <kernel/threading/scheduler.h>
+#include <kernel/time/time_manager.h>
 
 influx::threading::condition_variable::condition_variable() {}
 
@@ -63,4 +65,45 @@ bool influx::threading::condition_variable::wait_interruptible(
     lock.lock();
 
     return true;
+}
+
+influx::threading::cv_status influx::threading::condition_variable::wait_for(
+    influx::threading::unique_lock<influx::threading::mutex> &lock, uint64_t timeout_ms) {
+    interrupts_lock int_lk;
+
+    tcb *current_task = kernel::scheduler()->get_current_task();
+    bool timed_out = false;
+
+    // If the timeout had already passed
+    if (timeout_ms == 0) {
+        return cv_status::timeout;
+    }
+
+    // Add the current thread to task queue list and put it to sleep until the timeout, a notify
+    // will wake it before the sleep ends
+    _wait_queue.enqueue(current_task);
+    kernel::scheduler()->sleep_task(current_task, timeout_ms);
+
+    // Unlock the thread's lock
+    lock.unlock();
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+    int_lk.unlock();
+
+    // If the task is still in the queue, it wasn't notified
+    timed_out = _wait_queue.remove_task(current_task);
+
+    // Reacquire the lock
+    lock.lock();
+
+    return timed_out ? cv_status::timeout : cv_status::no_timeout;
+}
+
+influx::threading::cv_status influx::threading::condition_variable::wait_until(
+    influx::threading::unique_lock<influx::threading::mutex> &lock, uint64_t deadline_ms) {
+    uint64_t current_time = kernel::time_manager()->milliseconds();
+
+    // Wait for the time left until the deadline
+    return wait_for(lock, deadline_ms > current_time ? deadline_ms - current_time : 0);
 }
\ No newline at end of file
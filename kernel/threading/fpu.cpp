@@ -0,0 +1,137 @@
+#include <kernel/threading/fpu.h>
+
+#include <kernel/memory/utils.h>
+
+void influx::threading::fpu::init(const char *cmdline) {
+    uint32_t eax, ebx, ecx, edx;
+    uint64_t cr4;
+
+    // Eager switching is only used when it was requested in the kernel command line
+    _mode = cmdline_has_option(cmdline, FPU_EAGER_CMDLINE_OPTION) ? fpu_switch_mode::eager
+                                                                  : fpu_switch_mode::lazy;
+    _save_instruction = fpu_save_instruction::fxsave;
+    _state_size = FXSAVE_AREA_SIZE;
+
+    // The lazy mode only restores the state when needed so FXSAVE is enough
+    if (_mode == fpu_switch_mode::lazy) {
+        return;
+    }
+
+    // Check if the CPU supports XSAVE
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+    if (!(ecx & CPUID_FEATURES_XSAVE)) {
+        return;
+    }
+
+    // Enable XSAVE and set it to manage only the x87 and SSE states
+    __asm__ __volatile__("mov %0, cr4" : "=r"(cr4));
+    __asm__ __volatile__("mov cr4, %0" : : "r"(cr4 | CR4_OSXSAVE));
+    __asm__ __volatile__("xsetbv" : : "c"(0), "a"(XCR0_X87_SSE), "d"(0));
+
+    // Get the size of the XSAVE area for the enabled states
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0xD), "c"(0));
+    _state_size = ebx;
+
+    // Use XSAVEOPT if supported since it skips states that weren't modified since the last restore
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0xD), "c"(1));
+    _save_instruction = (eax & CPUID_XSAVE_FEATURES_XSAVEOPT) ? fpu_save_instruction::xsaveopt
+                                                              : fpu_save_instruction::xsave;
+}
+
+void *influx::threading::fpu::create_state() {
+    // Allocate the state with room for the alignment and the original pointer
+    uint8_t *buffer = new uint8_t[_state_size + FPU_STATE_ALIGNMENT + sizeof(uint8_t *)];
+    uint8_t *state =
+        (uint8_t *)(((uint64_t)buffer + sizeof(uint8_t *) + FPU_STATE_ALIGNMENT - 1) &
+                    ~((uint64_t)FPU_STATE_ALIGNMENT - 1));
+
+    // Save the original pointer before the state
+    *((uint8_t **)state - 1) = buffer;
+
+    // Set the state to the initial FPU state
+    memory::utils::memset(state, 0, _state_size);
+    *(uint16_t *)(state + FPU_STATE_FCW_OFFSET) = FPU_DEFAULT_FCW;
+    *(uint32_t *)(state + FPU_STATE_MXCSR_OFFSET) = FPU_DEFAULT_MXCSR;
+    if (_save_instruction != fpu_save_instruction::fxsave) {
+        *(uint64_t *)(state + FPU_STATE_XSTATE_BV_OFFSET) = XCR0_X87_SSE;
+    }
+
+    return state;
+}
+
+void influx::threading::fpu::free_state(void *state) {
+    if (state != nullptr) {
+        delete[] *((uint8_t **)state - 1);
+    }
+}
+
+void influx::threading::fpu::save(void *state) {
+    switch (_save_instruction) {
+        case fpu_save_instruction::fxsave:
+            __asm__ __volatile__("fxsave64 [%0]" : : "r"(state) : "memory");
+            break;
+
+        case fpu_save_instruction::xsave:
+            __asm__ __volatile__("xsave64 [%0]"
+                                 :
+                                 : "r"(state), "a"(XCR0_X87_SSE), "d"(0)
+                                 : "memory");
+            break;
+
+        case fpu_save_instruction::xsaveopt:
+            __asm__ __volatile__("xsaveopt64 [%0]"
+                                 :
+                                 : "r"(state), "a"(XCR0_X87_SSE), "d"(0)
+                                 : "memory");
+            break;
+    }
+}
+
+void influx::threading::fpu::restore(const void *state) {
+    if (_save_instruction == fpu_save_instruction::fxsave) {
+        __asm__ __volatile__("fxrstor64 [%0]" : : "r"(state) : "memory");
+    } else {
+        __asm__ __volatile__("xrstor64 [%0]"
+                             :
+                             : "r"(state), "a"(XCR0_X87_SSE), "d"(0)
+                             : "memory");
+    }
+}
+
+void influx::threading::fpu::set_task_switched() {
+    uint64_t cr0;
+
+    // Writing CR0 is expensive, so only write it if the flag isn't already set
+    __asm__ __volatile__("mov %0, cr0" : "=r"(cr0));
+    if (!(cr0 & CR0_TASK_SWITCHED)) {
+        __asm__ __volatile__("mov cr0, %0" : : "r"(cr0 | CR0_TASK_SWITCHED));
+    }
+}
+
+void influx::threading::fpu::clear_task_switched() { __asm__ __volatile__("clts"); }
+
+bool influx::threading::fpu::cmdline_has_option(const char *cmdline, const char *option) {
+    uint64_t i = 0;
+
+    if (cmdline == nullptr) {
+        return false;
+    }
+
+    // Search for the option in the start of each word in the command line
+    for (const char *word = cmdline; *word != '\0'; word++) {
+        if (word != cmdline && *(word - 1) != ' ') {
+            continue;
+        }
+
+        // Compare the word to the option
+        for (i = 0; option[i] != '\0' && word[i] == option[i]; i++) {
+        }
+
+        // If the whole option matched and the word ended
+        if (option[i] == '\0' && (word[i] == ' ' || word[i] == '\0')) {
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <kernel/threading/futex_manager.h>
+
+#include <kernel/kernel.h>
+#include <kernel/memory/paging_manager.h>
+#include <kernel/memory/utils.h>
+#include <kernel/threading/lock_guard.h>
+#include <kernel/threading/scheduler.h>
+#include <kernel/threading/unique_lock.h>
+
+influx::threading::futex_manager::futex_manager() : _futexes(nullptr) {}
+
+influx::threading::futex_error influx::threading::futex_manager::wait(uint32_t *address,
+                                                                      uint32_t value,
+                                                                      uint64_t timeout_ms,
+                                                                      uint32_t bitset) {
+    tcb *task = kernel::scheduler()->get_current_task();
+    uint64_t key = get_futex_key(address);
+    uint32_t current_value = 0;
+
+    unique_lock lk(_futexes_mutex);
+
+    // The futex word may have been unmapped since it was checked
+    if (memory::utils::memcpy_fault_safe(&current_value, address, sizeof(uint32_t)) != 0) {
+        return futex_error::fault;
+    }
+
+    // If the value had already changed, the waker already ran
+    if (current_value != value) {
+        return futex_error::value_mismatch;
+    }
+
+    // If the timeout had already passed
+    if (timeout_ms == 0) {
+        return futex_error::timed_out;
+    }
+
+    // Save the futex of the task and the wanted wake bitset
+    task->value().futex_key = key;
+    task->value().futex_bitset = bitset;
+
+    // Set the task as interruptible
+    task->value().signal_interruptible = true;
+
+    // Add the task to the wait queue of the futex and put it to sleep if there is a timeout
+    get_futex_queue(key)->enqueue(task);
+    if (timeout_ms != FUTEX_NO_TIMEOUT) {
+        kernel::scheduler()->sleep_task(task, timeout_ms);
+    }
+
+    // Unlock the futexes lock only after the task was queued so no wake will be missed
+    lk.unlock();
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+
+    // Set the task as uninterruptible
+    task->value().signal_interruptible = false;
+
+    // If the task is still in the wait queue, it wasn't woken by the futex
+    lk.lock();
+    if (_futexes.count(task->value().futex_key) &&
+        _futexes[task->value().futex_key]->remove_task(task)) {
+        release_futex_queue(task->value().futex_key);
+
+        return task->value().signal_interrupted ? futex_error::interrupted
+                                                : futex_error::timed_out;
+    }
+
+    return futex_error::success;
+}
+
+int64_t influx::threading::futex_manager::wake(uint32_t *address, uint64_t count,
+                                               uint32_t bitset) {
+    uint64_t key = get_futex_key(address);
+    int64_t woken = 0;
+
+    lock_guard lk(_futexes_mutex);
+
+    // If there are no waiters for the futex
+    if (_futexes.count(key) == 0) {
+        return 0;
+    }
+
+    // Wake tasks that wait for one of the bits in the bitset
+    while ((uint64_t)woken < count && _futexes[key]->dequeue(bitset_filter, &bitset) != nullptr) {
+        woken++;
+    }
+
+    // Free the futex if it has no waiters left
+    release_futex_queue(key);
+
+    return woken;
+}
+
+int64_t influx::threading::futex_manager::requeue(uint32_t *address, uint64_t wake_count,
+                                                  uint32_t *requeue_address,
+                                                  uint64_t requeue_count, bool compare,
+                                                  uint32_t value) {
+    uint64_t key = get_futex_key(address), requeue_key = get_futex_key(requeue_address);
+    uint32_t bitset = FUTEX_BITSET_MATCH_ANY, current_value = 0;
+    int64_t woken = 0;
+
+    structures::vector<tcb *> requeued_tasks;
+
+    lock_guard lk(_futexes_mutex);
+
+    // The futex word may have been unmapped since it was checked
+    if (compare &&
+        memory::utils::memcpy_fault_safe(&current_value, address, sizeof(uint32_t)) != 0) {
+        return (int64_t)futex_error::fault;
+    }
+
+    // If the value had changed, the caller should retry
+    if (compare && current_value != value) {
+        return (int64_t)futex_error::value_mismatch;
+    }
+
+    // If there are no waiters for the futex
+    if (_futexes.count(key) == 0) {
+        return 0;
+    }
+
+    // Wake the wanted amount of tasks
+    while ((uint64_t)woken < wake_count &&
+           _futexes[key]->dequeue(bitset_filter, &bitset) != nullptr) {
+        woken++;
+    }
+
+    // Move the rest of the tasks to the wait queue of the other futex without waking them
+    if (requeue_count > 0 && key != requeue_key && !_futexes[key]->empty()) {
+        requeued_tasks = _futexes[key]->requeue(*get_futex_queue(requeue_key), requeue_count);
+
+        // Update the futex of each requeued task
+        for (tcb *task : requeued_tasks) {
+            task->value().futex_key = requeue_key;
+        }
+    }
+
+    // Free the futex if it has no waiters left
+    release_futex_queue(key);
+
+    return woken + (int64_t)requeued_tasks.size();
+}
+
+uint64_t influx::threading::futex_manager::get_futex_key(uint32_t *address) const {
+    // Use the physical address so the futex is shared between all mappings of the word
+    return memory::paging_manager::get_physical_address((uint64_t)address);
+}
+
+influx::threading::task_wait_queue *influx::threading::futex_manager::get_futex_queue(
+    uint64_t key) {
+    // ** The futexes mutex should be locked here **
+
+    // Create the wait queue of the futex if it has no waiters yet
+    if (_futexes.count(key) == 0) {
+        _futexes[key] = new task_wait_queue();
+    }
+
+    return _futexes[key];
+}
+
+void influx::threading::futex_manager::release_futex_queue(uint64_t key) {
+    // ** The futexes mutex should be locked here **
+
+    // If the futex has no waiters left, free it's wait queue
+    if (_futexes.count(key) != 0 && _futexes[key]->empty()) {
+        delete _futexes[key];
+        _futexes.erase(key);
+    }
+}
+
+bool influx::threading::futex_manager::bitset_filter(influx::threading::tcb *task, void *bitset) {
+    return (task->value().futex_bitset & *(uint32_t *)bitset) != 0;
+}
\ No newline at end of file
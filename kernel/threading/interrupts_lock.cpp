@@ -3,32 +3,48 @@
 #include <kernel/interrupts/interrupt_manager.h>
 #include <kernel/kernel.h>
 
-influx::threading::interrupts_lock::interrupts_lock(bool lock) : _locked(lock) {
+influx::threading::interrupts_lock::interrupts_lock(bool lock)
+    : _locked(false), _interrupts_enabled(false) {
+#ifdef LOCKSTAT
+    // Acquisitions are recorded by the site that created the lock
+    _lockstat_site = __builtin_return_address(0);
+    _lockstat_entry = nullptr;
+    _lockstat_acquire_time = 0;
+#endif
+
     // Disable interrupts if the lock need to be locked
     if (lock) {
-        kernel::interrupt_manager()->disable_interrupts();
+        this->lock();
     }
 }
 
-influx::threading::interrupts_lock::~interrupts_lock() {
-    // If the lock is locked, re-enable interrupts
-    if (_locked) {
-        kernel::interrupt_manager()->enable_interrupts();
-    }
-}
+influx::threading::interrupts_lock::~interrupts_lock() { unlock(); }
 
 void influx::threading::interrupts_lock::lock() {
-    // If not locked, disable interrupts
+    // If not locked, save the interrupts state and disable interrupts
     if (!_locked) {
+        _interrupts_enabled = kernel::interrupt_manager()->interrupts_enabled();
         kernel::interrupt_manager()->disable_interrupts();
         _locked = true;
+
+#ifdef LOCKSTAT
+        _lockstat_entry = lockstat::get_entry(lock_type::interrupts_lock, nullptr, _lockstat_site);
+        lockstat::record_acquisition(_lockstat_entry, false, 0);
+        _lockstat_acquire_time = lockstat::timestamp();
+#endif
     }
 }
 
 void influx::threading::interrupts_lock::unlock() {
-    // If locked, enable interrupts
+    // If locked, re-enable interrupts only if they were enabled before so nested locks are safe
     if (_locked) {
-        kernel::interrupt_manager()->enable_interrupts();
+#ifdef LOCKSTAT
+        lockstat::record_release(_lockstat_entry, lockstat::timestamp() - _lockstat_acquire_time);
+#endif
+
+        if (_interrupts_enabled) {
+            kernel::interrupt_manager()->enable_interrupts();
+        }
         _locked = false;
     }
 }
\ No newline at end of file
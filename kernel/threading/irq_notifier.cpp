@@ -0,0 +1,110 @@
+#include <kernel/threading/irq_notifier.h>
+
+#include <kernel/kernel.h>
+#include <kernel/threading/interrupts_lock.h>
+#include <kernel/threading/scheduler.h>
+
+influx::threading::irq_notifier::irq_notifier()
+    : _pending(0), _waiters_head(nullptr), _waiters_tail(nullptr) {}
+
+void influx::threading::irq_notifier::notify() {
+    // ** This can be called from an IRQ handler **
+    interrupts_lock int_lk;
+
+    irq_waiter *waiter = _waiters_head;
+
+    // Wake the first waiting task directly, or count the notification so it won't be lost
+    if (waiter != nullptr) {
+        remove_waiter(waiter);
+        waiter->notified = true;
+        kernel::scheduler()->unblock_task(waiter->task);
+    } else {
+        _pending++;
+    }
+}
+
+bool influx::threading::irq_notifier::wait(bool interruptible, uint64_t timeout_ms) {
+    interrupts_lock int_lk;
+
+    tcb *current_task = kernel::scheduler()->get_current_task();
+    irq_waiter waiter = {.task = current_task, .next = nullptr, .notified = false};
+
+    // If a notification is already pending, consume it
+    if (_pending > 0) {
+        _pending--;
+        return true;
+    }
+
+    // If the timeout had already passed
+    if (timeout_ms == 0) {
+        return false;
+    }
+
+    // Set the task as interruptible if needed
+    current_task->value().signal_interruptible = interruptible;
+
+    // Add the task to the waiters, block it and put it to sleep if there is a timeout
+    add_waiter(&waiter);
+    kernel::scheduler()->block_task(current_task);
+    if (timeout_ms != IRQ_NO_TIMEOUT) {
+        kernel::scheduler()->sleep_task(current_task, timeout_ms);
+    }
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+
+    // Set the task as uninterruptible
+    current_task->value().signal_interruptible = false;
+
+    // If the task wasn't notified, it was interrupted by a signal or timed out
+    if (!waiter.notified) {
+        remove_waiter(&waiter);
+        return false;
+    }
+
+    return true;
+}
+
+void influx::threading::irq_notifier::reset() {
+    interrupts_lock int_lk;
+
+    // Drop notifications that no one waited for
+    _pending = 0;
+}
+
+void influx::threading::irq_notifier::add_waiter(influx::threading::irq_waiter *waiter) {
+    // ** The interrupts lock should be locked here **
+
+    // Add the waiter to the end of the list
+    if (_waiters_tail == nullptr) {
+        _waiters_head = waiter;
+    } else {
+        _waiters_tail->next = waiter;
+    }
+    _waiters_tail = waiter;
+}
+
+void influx::threading::irq_notifier::remove_waiter(influx::threading::irq_waiter *waiter) {
+    // ** The interrupts lock should be locked here **
+    irq_waiter *prev = nullptr;
+
+    // Find the waiter that precedes the waiter
+    for (irq_waiter *current = _waiters_head; current != waiter; current = current->next) {
+        if (current == nullptr) {
+            return;
+        }
+
+        prev = current;
+    }
+
+    // Unlink the waiter from the list
+    if (prev == nullptr) {
+        _waiters_head = waiter->next;
+    } else {
+        prev->next = waiter->next;
+    }
+    if (_waiters_tail == waiter) {
+        _waiters_tail = prev;
+    }
+    waiter->next = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <kernel/threading/lockstat.h>
+
+// The statistics are only collected when the kernel is built with lockstat enabled
+#ifdef LOCKSTAT
+#include <kernel/interrupts/interrupt_manager.h>
+#include <kernel/logger.h>
+
+uint64_t influx::threading::lockstat::timestamp() {
+    uint32_t low, high;
+
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+
+    return ((uint64_t)high << 32) | low;
+}
+
+influx::threading::lockstat_entry *influx::threading::lockstat::get_entry(
+    influx::threading::lock_type type, const char *name, const void *site) {
+    // Named locks are grouped by their name, other locks by their acquisition site
+    const void *key = name != nullptr ? (const void *)name : site;
+    uint64_t index = ((uint64_t)key >> 3) % LOCKSTAT_MAX_ENTRIES;
+    lockstat_entry *entry = nullptr;
+
+    // The statistics are updated by locks so they can't be protected by a lock
+    uint64_t rflags = disable_interrupts();
+
+    // Search for the entry of the key or for a free entry
+    for (uint64_t i = 0; i < LOCKSTAT_MAX_ENTRIES; i++) {
+        entry = &_entries[(index + i) % LOCKSTAT_MAX_ENTRIES];
+
+        if (entry->key == key && entry->type == type) {
+            break;
+        } else if (entry->key == nullptr) {
+            *entry = lockstat_entry{.key = key,
+                                    .name = name,
+                                    .type = type,
+                                    .acquisitions = 0,
+                                    .contentions = 0,
+                                    .total_wait_time = 0,
+                                    .max_hold_time = 0};
+            break;
+        }
+
+        entry = nullptr;
+    }
+
+    // If the table is full, count the lock as dropped
+    if (entry == nullptr) {
+        _dropped_entries++;
+    }
+
+    restore_interrupts(rflags);
+
+    return entry;
+}
+
+void influx::threading::lockstat::record_acquisition(influx::threading::lockstat_entry *entry,
+                                                     bool contended, uint64_t wait_time) {
+    // Ignore locks without an entry and locks taken while the report is printed
+    if (entry == nullptr || _paused) {
+        return;
+    }
+
+    uint64_t rflags = disable_interrupts();
+
+    entry->acquisitions++;
+    if (contended) {
+        entry->contentions++;
+        entry->total_wait_time += wait_time;
+    }
+
+    restore_interrupts(rflags);
+}
+
+void influx::threading::lockstat::record_release(influx::threading::lockstat_entry *entry,
+                                                 uint64_t hold_time) {
+    // Ignore locks without an entry and locks taken while the report is printed
+    if (entry == nullptr || _paused) {
+        return;
+    }
+
+    uint64_t rflags = disable_interrupts();
+
+    if (hold_time > entry->max_hold_time) {
+        entry->max_hold_time = hold_time;
+    }
+
+    restore_interrupts(rflags);
+}
+
+void influx::threading::lockstat::dump() {
+    logger log("Lockstat", console_color::pink);
+    const char *type_names[] = {"mutex", "spinlock", "interrupts_lock"};
+
+    // Printing takes locks too, so stop recording until the report is printed
+    _paused = true;
+
+    log("Lock statistics (times are in TSC cycles):\n");
+    for (const auto &entry : _entries) {
+        // Skip free entries and entries of locks that weren't taken since the last reset
+        if (entry.key == nullptr || entry.acquisitions == 0) {
+            continue;
+        }
+
+        // Print the statistics by the name of the lock or by it's acquisition site
+        if (entry.name != nullptr) {
+            log("%s '%s': %ld acquisitions, %ld contended, %ld total wait, %ld max hold\n",
+                type_names[(int)entry.type], entry.name, entry.acquisitions, entry.contentions,
+                entry.total_wait_time, entry.max_hold_time);
+        } else {
+            log("%s at %p: %ld acquisitions, %ld contended, %ld total wait, %ld max hold\n",
+                type_names[(int)entry.type], entry.key, entry.acquisitions, entry.contentions,
+                entry.total_wait_time, entry.max_hold_time);
+        }
+    }
+
+    // Report locks that didn't fit in the table
+    if (_dropped_entries != 0) {
+        log("%ld acquisitions weren't recorded since the table is full.\n", _dropped_entries);
+    }
+
+    _paused = false;
+}
+
+void influx::threading::lockstat::reset() {
+    uint64_t rflags = disable_interrupts();
+
+    // Reset the counters but keep the entries since locks hold pointers to them
+    for (auto &entry : _entries) {
+        entry.acquisitions = 0;
+        entry.contentions = 0;
+        entry.total_wait_time = 0;
+        entry.max_hold_time = 0;
+    }
+    _dropped_entries = 0;
+
+    restore_interrupts(rflags);
+}
+
+uint64_t influx::threading::lockstat::disable_interrupts() {
+    uint64_t rflags;
+
+    __asm__ __volatile__("pushfq; pop %0; cli" : "=r"(rflags) : : "memory");
+
+    return rflags;
+}
+
+void influx::threading::lockstat::restore_interrupts(uint64_t rflags) {
+    if (rflags & RFLAGS_INTERRUPT_FLAG) {
+        __asm__ __volatile__("sti" : : : "memory");
+    }
+}
+#endif
\ No newline at end of file
@@ -1,70 +1,114 @@
 #include <kernel/threading/mutex.h>
 
 #include <kernel/kernel.h>
-#include <kernel/threading/lock_guard.h>
+#include <kernel/threading/interrupts_lock.h>
 #include <kernel/threading/scheduler.h>
-#include <kernel/threading/unique_lock.h>
 
-influx::threading::mutex::mutex() : _value(0) {}
+influx::threading::mutex::mutex(const char *name)
+    : _value(0), _owner(nullptr), _next_held(nullptr) {
+#ifdef LOCKSTAT
+    _name = name;
+    _lockstat_entry = nullptr;
+    _lockstat_acquire_time = 0;
+#endif
+}
 
 void influx::threading::mutex::lock() {
-    unique_lock lk(_value_lock);
+#ifdef LOCKSTAT
+    uint64_t wait_start = lockstat::timestamp();
+#endif
+
+    interrupts_lock int_lk;
+
+    tcb *current_task =
+        kernel::scheduler() != nullptr ? kernel::scheduler()->get_current_task() : nullptr;
 
     // If the mutex is unlocked, lock it
     if (_value == 0) {
-        _value = 1;
-    } else {
-        // Unlock the value lock
-        lk.unlock();
+        acquire(current_task);
+#ifdef LOCKSTAT
+        lockstat_acquired(__builtin_return_address(0), false, wait_start);
+#endif
+        return;
+    }
 
-        // Add the task to the wait queue
-        _wait_queue.enqueue(kernel::scheduler()->get_current_task());
+    // Add the task to the wait queue
+    current_task->value().blocked_mutex = this;
+    _wait_queue.enqueue(current_task);
 
-        // Reschedule to another task
-        kernel::scheduler()->reschedule();
-    }
+    // Let the owner of the mutex inherit the priority of the task
+    update_priority(_owner);
+
+    // Reschedule to another task, the mutex will be handed to the task when it's unlocked
+    kernel::scheduler()->reschedule();
+
+#ifdef LOCKSTAT
+    lockstat_acquired(__builtin_return_address(0), true, wait_start);
+#endif
 }
 
 bool influx::threading::mutex::lock_interruptible() {
-    unique_lock lk(_value_lock);
+#ifdef LOCKSTAT
+    uint64_t wait_start = lockstat::timestamp();
+#endif
+
+    interrupts_lock int_lk;
+
+    tcb *current_task =
+        kernel::scheduler() != nullptr ? kernel::scheduler()->get_current_task() : nullptr;
 
     // If the mutex is unlocked, lock it
     if (_value == 0) {
-        _value = 1;
-    } else {
-        // Unlock the value lock
-        lk.unlock();
+        acquire(current_task);
+#ifdef LOCKSTAT
+        lockstat_acquired(__builtin_return_address(0), false, wait_start);
+#endif
+        return true;
+    }
 
-        // Set the task as interruptible
-        kernel::scheduler()->get_current_task()->value().signal_interruptible = true;
+    // Set the task as interruptible
+    current_task->value().signal_interruptible = true;
 
-        // Add the task to the wait queue
-        _wait_queue.enqueue(kernel::scheduler()->get_current_task());
+    // Add the task to the wait queue
+    current_task->value().blocked_mutex = this;
+    _wait_queue.enqueue(current_task);
 
-        // Reschedule to another task
-        kernel::scheduler()->reschedule();
+    // Let the owner of the mutex inherit the priority of the task
+    update_priority(_owner);
 
-        // Set the task as uninterruptible
-        kernel::scheduler()->get_current_task()->value().signal_interruptible = false;
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
 
-        // If the task was interrupted by a signal return false
-        if (kernel::scheduler()->get_current_task()->value().signal_interrupted) {
-            // Remove the task from the queue if it's in the queue
-            _wait_queue.remove_task(kernel::scheduler()->get_current_task());
+    // Set the task as uninterruptible
+    current_task->value().signal_interruptible = false;
 
-            return false;
-        }
+    // If the task was interrupted by a signal before the mutex was handed to it, return false
+    if (current_task->value().signal_interrupted && _wait_queue.remove_task(current_task)) {
+        current_task->value().blocked_mutex = nullptr;
+
+        // The owner no longer inherits the priority of the task
+        update_priority(_owner);
+
+        return false;
     }
 
+#ifdef LOCKSTAT
+    lockstat_acquired(__builtin_return_address(0), true, wait_start);
+#endif
+
     return true;
 }
 
 bool influx::threading::mutex::try_lock() {
-    lock_guard lk(_value_lock);
+    interrupts_lock int_lk;
 
     // If the mutex is unlocked, lock it
     if (_value == 0) {
-        _value = 1;
+        acquire(kernel::scheduler() != nullptr ? kernel::scheduler()->get_current_task()
+                                               : nullptr);
+#ifdef LOCKSTAT
+        lockstat_acquired(__builtin_return_address(0), false, 0);
+#endif
 
         return true;
     }
@@ -72,15 +116,168 @@ bool influx::threading::mutex::try_lock() {
     return false;
 }
 
+bool influx::threading::mutex::try_lock_for(uint64_t timeout_ms) {
+#ifdef LOCKSTAT
+    uint64_t wait_start = lockstat::timestamp();
+#endif
+
+    interrupts_lock int_lk;
+
+    tcb *current_task =
+        kernel::scheduler() != nullptr ? kernel::scheduler()->get_current_task() : nullptr;
+
+    // If the mutex is unlocked, lock it
+    if (_value == 0) {
+        acquire(current_task);
+#ifdef LOCKSTAT
+        lockstat_acquired(__builtin_return_address(0), false, wait_start);
+#endif
+        return true;
+    }
+
+    // If the timeout had already passed
+    if (timeout_ms == 0) {
+        return false;
+    }
+
+    // Add the task to the wait queue and put it to sleep until the timeout, an unlock will wake
+    // it before the sleep ends
+    current_task->value().blocked_mutex = this;
+    _wait_queue.enqueue(current_task);
+    kernel::scheduler()->sleep_task(current_task, timeout_ms);
+
+    // Let the owner of the mutex inherit the priority of the task
+    update_priority(_owner);
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+
+    // If the task is still in the queue, the mutex wasn't handed to it before the timeout
+    if (_wait_queue.remove_task(current_task)) {
+        current_task->value().blocked_mutex = nullptr;
+
+        // The owner no longer inherits the priority of the task
+        update_priority(_owner);
+
+        return false;
+    }
+
+#ifdef LOCKSTAT
+    lockstat_acquired(__builtin_return_address(0), true, wait_start);
+#endif
+
+    return true;
+}
+
 void influx::threading::mutex::unlock() {
-    unique_lock lk(_value_lock, defer_lock);
+    interrupts_lock int_lk;
+
+    tcb *old_owner = _owner, *new_owner = nullptr;
 
-    // Dequeue task from waiting list if not empty
+#ifdef LOCKSTAT
+    lockstat::record_release(_lockstat_entry, lockstat::timestamp() - _lockstat_acquire_time);
+#endif
+
+    // Remove the mutex from the held mutexes of the owner
+    release();
+
+    // Hand the mutex to the highest priority waiting task if there is one, otherwise unlock it
     if (!_wait_queue.empty()) {
-        _wait_queue.dequeue();
+        new_owner = _wait_queue.dequeue();
+        new_owner->value().blocked_mutex = nullptr;
+        acquire(new_owner);
+
+        // The new owner inherits the priority of the tasks that are still waiting
+        update_priority(new_owner);
     } else {
-        // Unlock the mutex
-        lk.lock();
         _value = 0;
     }
+
+    // Undo the priority boost of the old owner
+    update_priority(old_owner);
+
+    // If the new owner has a higher priority than the current task, let it run
+    if (new_owner != nullptr &&
+        new_owner->value().priority > kernel::scheduler()->get_current_task()->value().priority) {
+        kernel::scheduler()->reschedule();
+    }
+}
+
+#ifdef LOCKSTAT
+void influx::threading::mutex::lockstat_acquired(const void *site, bool contended,
+                                                 uint64_t wait_start) {
+    // Record the acquisition by the name of the mutex or by the acquisition site
+    _lockstat_entry = lockstat::get_entry(lock_type::mutex, _name, site);
+    lockstat::record_acquisition(_lockstat_entry, contended,
+                                 contended ? lockstat::timestamp() - wait_start : 0);
+    _lockstat_acquire_time = lockstat::timestamp();
+}
+#endif
+
+void influx::threading::mutex::acquire(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+    _value = 1;
+    _owner = task;
+
+    // Add the mutex to the held mutexes of the task
+    if (task != nullptr) {
+        _next_held = task->value().held_mutexes;
+        task->value().held_mutexes = this;
+    }
+}
+
+void influx::threading::mutex::release() {
+    // ** Interrupts should be locked here **
+    mutex **held_mutex = nullptr;
+
+    // Remove the mutex from the held mutexes list of the owner
+    if (_owner != nullptr) {
+        for (held_mutex = &_owner->value().held_mutexes; *held_mutex != nullptr;
+             held_mutex = &(*held_mutex)->_next_held) {
+            if (*held_mutex == this) {
+                *held_mutex = _next_held;
+                break;
+            }
+        }
+    }
+
+    _owner = nullptr;
+    _next_held = nullptr;
+}
+
+void influx::threading::mutex::update_priority(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+    uint8_t priority = 0;
+    tcb *waiting_task = nullptr;
+
+    // Propagate the priority through the chain of blocked owners
+    while (task != nullptr && task->value().state != thread_state::killed) {
+        // The effective priority is the highest of the process priority and the priorities of the
+        // tasks waiting for mutexes held by the task
+        priority = kernel::scheduler()->_processes[task->value().pid].priority;
+        for (mutex *held_mutex = task->value().held_mutexes; held_mutex != nullptr;
+             held_mutex = held_mutex->_next_held) {
+            waiting_task = held_mutex->_wait_queue.front();
+            if (waiting_task != nullptr && waiting_task->value().priority > priority) {
+                priority = waiting_task->value().priority;
+            }
+        }
+
+        // If the priority wasn't changed, the rest of the chain isn't affected
+        if (priority == task->value().priority) {
+            break;
+        }
+
+        // Move the task to it's new priority queue
+        kernel::scheduler()->set_task_priority(task, priority);
+
+        // If the task isn't waiting for a mutex, the chain ends here
+        if (task->value().blocked_mutex == nullptr) {
+            break;
+        }
+
+        // Re-order the task in the wait queue of the mutex and continue to it's owner
+        task->value().blocked_mutex->_wait_queue.reposition(task);
+        task = task->value().blocked_mutex->_owner;
+    }
 }
\ No newline at end of file
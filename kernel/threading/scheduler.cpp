@@ -2,13 +2,19 @@
 
 #include <kernel/algorithm.h>
 #include <kernel/assert.h>
+#include <kernel/gdt.h>
 #include <kernel/kernel.h>
 #include <kernel/memory/paging_manager.h>
 #include <kernel/memory/virtual_allocator.h>
+#include <kernel/msr.h>
+#include <kernel/syscalls/utils.h>
+#include <kernel/threading/fpu.h>
+#include <kernel/threading/futex_manager.h>
 #include <kernel/threading/interrupts_lock.h>
 #include <kernel/threading/scheduler_started.h>
 #include <kernel/threading/scheduler_utils.h>
 #include <kernel/time/time_manager.h>
+#include <kernel/time/tsc_clocksource.h>
 #include <kernel/utils.h>
 #include <memory/protection_flags.h>
 
@@ -119,6 +125,12 @@ void influx::threading::new_user_process_wrapper(influx::threading::executable *
             PROT_READ | PROT_WRITE, true);
     }
 
+    // Map the time page for the syscall-free clocks
+    if (!kernel::time_manager()->map_time_page()) {
+        delete exec;
+        kernel::scheduler()->kill_current_task();
+    }
+
     // Align the end of the exeuctable
     end_of_executable +=
         end_of_executable % PAGE_SIZE ? (PAGE_SIZE - (end_of_executable % PAGE_SIZE)) : 0;
@@ -127,9 +139,12 @@ void influx::threading::new_user_process_wrapper(influx::threading::executable *
     process.program_break_start = end_of_executable;
     process.program_break_end = end_of_executable;
 
-    // Set args size
+    // Set args size and user stack address
     int_lk.lock();
     kernel::scheduler()->_current_task->value().args_size = argv_envp_pages * PAGE_SIZE;
+    kernel::scheduler()->_current_task->value().user_stack_address =
+        DEFAULT_USER_STACK_ADDRESS - (argv_envp_pages * PAGE_SIZE);
+    kernel::scheduler()->update_max_rss(process);
     int_lk.unlock();
 
     // Free executable object
@@ -139,7 +154,8 @@ void influx::threading::new_user_process_wrapper(influx::threading::executable *
     scheduler_utils::jump_to_ring_3(entry,
                                     (void *)(DEFAULT_USER_STACK_ADDRESS + DEFAULT_USER_STACK_SIZE -
                                              8 - (argv_envp_pages * PAGE_SIZE)),
-                                    argc, function_ptrs.first, function_ptrs.second);
+                                    argc, function_ptrs.first, function_ptrs.second,
+                                    kernel::scheduler()->_current_task->value().fs_base);
 }
 
 void influx::threading::new_fork_process_wrapper(
@@ -148,10 +164,9 @@ void influx::threading::new_fork_process_wrapper(
     // Re-enable interrupts since they were disabled in the reschedule function
     kernel::interrupt_manager()->enable_interrupts();
 
-    uint64_t user_stack_virtual_address =
-        (uint64_t)kernel::scheduler()->_current_task->value().user_stack;
+    thread &current_thread = kernel::scheduler()->_current_task->value();
 
-    uint64_t argv_envp_pages = kernel::scheduler()->_current_task->value().args_size / PAGE_SIZE;
+    interrupts_lock int_lk(false);
 
     // Create a stack copy of the old context
     interrupts::regs old_context_var = *old_context;
@@ -187,12 +202,17 @@ void influx::threading::new_fork_process_wrapper(
     // Free segments vector and old context
     delete segments;
 
-    // Map user stack
-    for (uint64_t stack_offset = 0; stack_offset < DEFAULT_USER_STACK_SIZE;
+    // Map the time page for the syscall-free clocks
+    if (!kernel::time_manager()->map_time_page()) {
+        kernel::scheduler()->kill_current_task();
+    }
+
+    // Map user stack in the address of the user stack of the forked thread
+    for (uint64_t stack_offset = 0; stack_offset < current_thread.user_stack_size;
          stack_offset += PAGE_SIZE) {
         if (!memory::paging_manager::map_page(
-                DEFAULT_USER_STACK_ADDRESS + stack_offset - (argv_envp_pages * PAGE_SIZE),
-                memory::paging_manager::get_physical_address(user_stack_virtual_address +
+                current_thread.user_stack_address + stack_offset,
+                memory::paging_manager::get_physical_address((uint64_t)current_thread.user_stack +
                                                              stack_offset) /
                     PAGE_SIZE)) {
             kernel::scheduler()->kill_current_task();
@@ -200,12 +220,46 @@ void influx::threading::new_fork_process_wrapper(
 
         // Set R/W permission and DPL of ring 3
         memory::paging_manager::set_pte_permissions(
-            DEFAULT_USER_STACK_ADDRESS + stack_offset - (argv_envp_pages * PAGE_SIZE),
-            PROT_READ | PROT_WRITE, true);
+            current_thread.user_stack_address + stack_offset, PROT_READ | PROT_WRITE, true);
     }
 
+    // The forked process starts with a copy of the whole memory of its parent
+    int_lk.lock();
+    kernel::scheduler()->update_max_rss(
+        kernel::scheduler()->_processes[kernel::scheduler()->_current_task->value().pid]);
+    int_lk.unlock();
+
     // Return to the new process
-    scheduler_utils::return_to_fork_process(old_context_var);
+    scheduler_utils::return_to_fork_process(current_thread.fs_base, old_context_var);
+}
+
+void influx::threading::new_user_thread_wrapper(uint64_t entry, uint64_t arg) {
+    // Re-enable interrupts since they were disabled in the reschedule function
+    kernel::interrupt_manager()->enable_interrupts();
+
+    thread &current_thread = kernel::scheduler()->_current_task->value();
+
+    // Map the user stack of the thread in it's stack slot
+    for (uint64_t stack_offset = 0; stack_offset < current_thread.user_stack_size;
+         stack_offset += PAGE_SIZE) {
+        if (!memory::paging_manager::map_page(
+                current_thread.user_stack_address + stack_offset,
+                memory::paging_manager::get_physical_address((uint64_t)current_thread.user_stack +
+                                                             stack_offset) /
+                    PAGE_SIZE)) {
+            kernel::scheduler()->kill_current_task();
+        }
+
+        // Set R/W permission and DPL of ring 3
+        memory::paging_manager::set_pte_permissions(
+            current_thread.user_stack_address + stack_offset, PROT_READ | PROT_WRITE, true);
+    }
+
+    // Jump to the thread entry point with it's argument
+    scheduler_utils::jump_to_ring_3(
+        entry,
+        (void *)(current_thread.user_stack_address + current_thread.user_stack_size - 8), arg,
+        nullptr, nullptr, current_thread.fs_base);
 }
 
 void influx::threading::terminate_thread() {
@@ -213,10 +267,17 @@ void influx::threading::terminate_thread() {
     kernel::scheduler()->kill_current_task();
 }
 
+void influx::threading::device_not_available_handler(influx::interrupts::regs *context) {
+    // Load the FPU state of the current task
+    kernel::scheduler()->load_fpu_context();
+}
+
 influx::threading::scheduler::scheduler(uint64_t tss_addr)
     : _log("Scheduler", console_color::blue),
       _priority_queues(MAX_PRIORITY_LEVEL + 1),
       _current_task(nullptr),
+      _fpu_owner(nullptr),
+      _loaded_fs_base(0),
       _max_quantum((kernel::time_manager()->timer_frequency() / 1000) * TASK_MAX_TIME_SLICE),
       _tss((tss_t *)tss_addr),
       _init_process(this) {
@@ -236,14 +297,15 @@ influx::threading::scheduler::scheduler(uint64_t tss_addr)
                               .working_dir = "/",
                               .threads = structures::unique_vector(),
                               .child_processes = structures::vector<uint64_t>(),
-                              .open_files = structures::unique_hash_map<vfs::open_file>(),
                               .file_descriptors = structures::unique_hash_map<vfs::file_descriptor>(
-                                  vfs::file_descriptor{.open_file_index = UINT64_MAX}),
+                                  vfs::file_descriptor{.file = nullptr}),
                               .name = "kernel",
                               .segments = structures::vector<segment>(),
                               .signal_dispositions = create_default_signal_dispositions(),
                               .pending_std_signals = structures::vector<signal_info>(),
                               .tty = KERNEL_TTY,
+                              .usage = cpu_usage(),
+                              .children_usage = cpu_usage(),
                               .exit_code = CLD_EXITED,
                               .exit_status = 0,
                               .terminated = false,
@@ -257,11 +319,27 @@ influx::threading::scheduler::scheduler(uint64_t tss_addr)
                        .context = nullptr,
                        .kernel_stack = (void *)get_stack_pointer(),
                        .user_stack = nullptr,
+                       .user_stack_address = 0,
+                       .user_stack_size = 0,
                        .args_size = 0,
+                       .fs_base = 0,
+                       .fpu_state = nullptr,
+                       .old_fpu_state = nullptr,
                        .state = thread_state::running,
+                       .priority = _processes[KERNEL_PID].priority,
                        .quantum = 0,
                        .sleep_quantum = 0,
+                       .usage = cpu_usage(),
+                       .usage_timestamp = time::tsc_clocksource::rdtsc(),
                        .child_wait_pid = 0,
+                       .futex_key = 0,
+                       .futex_bitset = 0,
+                       .clear_child_tid = nullptr,
+                       .blocked_mutex = nullptr,
+                       .held_mutexes = nullptr,
+                       .wait_queue = nullptr,
+                       .wait_prev = nullptr,
+                       .wait_next = nullptr,
                        .signal_interruptible = false,
                        .signal_interrupted = false,
                        .sig_queue = structures::vector<signal_info>(),
@@ -281,11 +359,27 @@ influx::threading::scheduler::scheduler(uint64_t tss_addr)
                                 .kernel_stack = memory::virtual_allocator::allocate(
                                     DEFAULT_KERNEL_STACK_SIZE, PROT_READ | PROT_WRITE),
                                 .user_stack = nullptr,
+                                .user_stack_address = 0,
+                                .user_stack_size = 0,
                                 .args_size = 0,
+                                .fs_base = 0,
+                                .fpu_state = nullptr,
+                                .old_fpu_state = nullptr,
                                 .state = thread_state::ready,
+                                .priority = _processes[KERNEL_PID].priority,
                                 .quantum = 0,
                                 .sleep_quantum = 0,
+                                .usage = cpu_usage(),
+                                .usage_timestamp = time::tsc_clocksource::rdtsc(),
                                 .child_wait_pid = 0,
+                                .futex_key = 0,
+                                .futex_bitset = 0,
+                                .clear_child_tid = nullptr,
+                                .blocked_mutex = nullptr,
+                                .held_mutexes = nullptr,
+                                .wait_queue = nullptr,
+                                .wait_prev = nullptr,
+                                .wait_next = nullptr,
                                 .signal_interruptible = false,
                                 .signal_interrupted = false,
                                 .sig_queue = structures::vector<signal_info>(),
@@ -325,14 +419,15 @@ influx::threading::scheduler::scheduler(uint64_t tss_addr)
                               .working_dir = "/",
                               .threads = structures::unique_vector(),
                               .child_processes = structures::vector<uint64_t>(),
-                              .open_files = structures::unique_hash_map<vfs::open_file>(),
                               .file_descriptors = structures::unique_hash_map<vfs::file_descriptor>(
-                                  vfs::file_descriptor{.open_file_index = UINT64_MAX}),
+                                  vfs::file_descriptor{.file = nullptr}),
                               .name = "init",
                               .segments = structures::vector<segment>(),
                               .signal_dispositions = create_default_signal_dispositions(),
                               .pending_std_signals = structures::vector<signal_info>(),
                               .tty = INIT_PROCESS_TTY,
+                              .usage = cpu_usage(),
+                              .children_usage = cpu_usage(),
                               .exit_code = CLD_EXITED,
                               .exit_status = 0,
                               .terminated = false,
@@ -342,6 +437,12 @@ influx::threading::scheduler::scheduler(uint64_t tss_addr)
     _log("Starting init process..\n");
     _init_process.start();
 
+    // Register the FPU device not available handler for lazy FPU context switching
+    _log("Registering FPU handler (%s FPU context switching)..\n",
+         fpu::mode() == fpu_switch_mode::lazy ? "lazy" : "eager");
+    kernel::interrupt_manager()->set_interrupt_service_routine(
+        DEVICE_NOT_AVAILABLE_INTERRUPT, (uint64_t)device_not_available_handler);
+
     // Register tick handler
     _log("Registering tick handler..\n");
     kernel::time_manager()->register_tick_handler(
@@ -368,11 +469,27 @@ influx::threading::tcb *influx::threading::scheduler::create_kernel_thread(void
                                    .context = context,
                                    .kernel_stack = stack,
                                    .user_stack = nullptr,
+                                   .user_stack_address = 0,
+                                   .user_stack_size = 0,
                                    .args_size = 0,
+                                   .fs_base = 0,
+                                   .fpu_state = nullptr,
+                                   .old_fpu_state = nullptr,
                                    .state = blocked ? thread_state::blocked : thread_state::ready,
+                                   .priority = _processes[pid].priority,
                                    .quantum = 0,
                                    .sleep_quantum = 0,
+                                   .usage = cpu_usage(),
+                                   .usage_timestamp = time::tsc_clocksource::rdtsc(),
                                    .child_wait_pid = 0,
+                                   .futex_key = 0,
+                                   .futex_bitset = 0,
+                                   .clear_child_tid = nullptr,
+                                   .blocked_mutex = nullptr,
+                                   .held_mutexes = nullptr,
+                                   .wait_queue = nullptr,
+                                   .wait_prev = nullptr,
+                                   .wait_next = nullptr,
                                    .signal_interruptible = false,
                                    .signal_interrupted = false,
                                    .sig_queue = structures::vector<signal_info>(),
@@ -408,6 +525,9 @@ void influx::threading::scheduler::reschedule() {
     tcb *current_task = _current_task;
     tcb *next_task = get_next_task();
 
+    bool preempted = current_task->value().state == thread_state::running;
+    uint64_t now = 0;
+
     // If there isn't a next task and the current task isn't blocked, keep running it
     if (next_task == nullptr && current_task->value().state == thread_state::running) {
         next_task = current_task;
@@ -432,10 +552,34 @@ void influx::threading::scheduler::reschedule() {
 
     // Don't switch tasks if the new task is the current task
     if (next_task != current_task) {
+        // Charge the current task for the time since its last accounting, which it spent in the
+        // kernel since it's switching tasks, and start the accounting of the new task
+        now = time::tsc_clocksource::rdtsc();
+        current_task->value().usage.system_time += now - current_task->value().usage_timestamp;
+        next_task->value().usage_timestamp = now;
+
+        // A task that was still running was preempted, otherwise it gave up the CPU by itself
+        if (preempted) {
+            current_task->value().usage.involuntary_switches++;
+        } else {
+            current_task->value().usage.voluntary_switches++;
+        }
+
         // Set TSS kernel stack pointer for userspace programs
         if (!_processes[next_task->value().pid].system) {
             _tss->rsp0_low = (uint64_t)next_task->value().context & 0xFFFFFFFF;
             _tss->rsp0_high = ((uint64_t)next_task->value().context >> 32) & 0xFFFFFFFF;
+            syscall_kernel_stack = (uint64_t)next_task->value().context;
+        }
+
+        // Switch the FPU context to the new task
+        switch_fpu_context(next_task);
+
+        // Load the FS base of the new task if it's a user task that uses a different FS base
+        if (!_processes[next_task->value().pid].system &&
+            next_task->value().fs_base != _loaded_fs_base) {
+            msr::write(MSR_FS_BASE, next_task->value().fs_base);
+            _loaded_fs_base = next_task->value().fs_base;
         }
 
         // Switch to the new task
@@ -568,22 +712,11 @@ uint64_t influx::threading::scheduler::sleep(uint64_t ms) {
 
     interrupts_lock int_lk;
 
-    process &current_process = _processes[_current_task->value().pid];
-    priority_tcb_queue &task_priority_queue = _priority_queues[current_process.priority];
-
     // Set the task as interruptible
     _current_task->value().signal_interruptible = true;
 
-    // Set the task's sleep quantum
-    _current_task->value().sleep_quantum = ms * (kernel::time_manager()->timer_frequency() / 1000);
-
-    // Set the task's state to sleeping
-    _current_task->value().state = thread_state::sleeping;
-
-    // If it is the next task, set the next task as null
-    if (task_priority_queue.next_task == _current_task) {
-        task_priority_queue.next_task = nullptr;
-    }
+    // Put the task to sleep
+    sleep_task(_current_task, ms);
     int_lk.unlock();
 
     // Re-schedule to another task
@@ -597,8 +730,28 @@ uint64_t influx::threading::scheduler::sleep(uint64_t ms) {
            (kernel::time_manager()->timer_frequency() / 1000);
 }
 
+void influx::threading::scheduler::sleep_task(influx::threading::tcb *task, uint64_t ms) {
+    kassert(ms != 0);
+
+    interrupts_lock int_lk;
+
+    priority_tcb_queue &task_priority_queue = _priority_queues[task->value().priority];
+
+    // Set the task's sleep quantum
+    task->value().sleep_quantum = ms * (kernel::time_manager()->timer_frequency() / 1000);
+
+    // Set the task's state to sleeping
+    task->value().state = thread_state::sleeping;
+
+    // If it is the next task, set the next task as null
+    if (task_priority_queue.next_task == task) {
+        task_priority_queue.next_task = nullptr;
+    }
+}
+
 int64_t influx::threading::scheduler::wait_for_child(int64_t child_pid, uint16_t *wait_status,
-                                                     bool no_hang) {
+                                                     bool no_hang,
+                                                     influx::threading::cpu_usage *child_usage) {
     // ** -1 for all children **
 
     // Verify child pid
@@ -609,7 +762,7 @@ int64_t influx::threading::scheduler::wait_for_child(int64_t child_pid, uint16_t
     interrupts_lock int_lk;
 
     process &current_process = _processes[_current_task->value().pid];
-    priority_tcb_queue &task_priority_queue = _priority_queues[current_process.priority];
+    priority_tcb_queue &task_priority_queue = _priority_queues[_current_task->value().priority];
 
     // If the task was interrupted
     if (_current_task->value().signal_interrupted) {
@@ -639,6 +792,9 @@ int64_t influx::threading::scheduler::wait_for_child(int64_t child_pid, uint16_t
         // Create wait status
         create_wait_status(wait_status, _processes[child_pid]);
 
+        // Add the CPU usage of the child to the current process
+        reap_child_cpu_usage(current_process, _processes[child_pid], child_usage);
+
         // Remove the process object
         _processes.erase(child_pid);
 
@@ -664,6 +820,9 @@ int64_t influx::threading::scheduler::wait_for_child(int64_t child_pid, uint16_t
                 // Create wait status
                 create_wait_status(wait_status, _processes[pid]);
 
+                // Add the CPU usage of the child to the current process
+                reap_child_cpu_usage(current_process, _processes[pid], child_usage);
+
                 // Remove the process object
                 _processes.erase(pid);
 
@@ -709,8 +868,10 @@ int64_t influx::threading::scheduler::wait_for_child(int64_t child_pid, uint16_t
     // Create wait status
     create_wait_status(wait_status, _processes[_current_task->value().child_wait_pid]);
 
-    // Remove process
+    // Add the CPU usage of the child to the current process and remove it
     int_lk.lock();
+    reap_child_cpu_usage(_processes[_current_task->value().pid],
+                         _processes[_current_task->value().child_wait_pid], child_usage);
     _processes.erase(_current_task->value().child_wait_pid);
     int_lk.unlock();
 
@@ -721,13 +882,22 @@ void influx::threading::scheduler::kill_current_task() {
     interrupts_lock int_lk;
 
     process &current_process = _processes[_current_task->value().pid];
-    priority_tcb_queue &task_priority_queue = _priority_queues[current_process.priority];
+    priority_tcb_queue &task_priority_queue = _priority_queues[_current_task->value().priority];
 
-    // If it's the last thread of the user process, free it's memory
-    if (!current_process.system && current_process.threads.size() == 1) {
+    // If it's the last thread of the user process, free it's memory, otherwise only unmap the
+    // thread's user stack since it's freed with the thread
+    if (!current_process.system && is_last_thread(_current_task)) {
         int_lk.unlock();
+        kernel::time_manager()->unmap_time_page();
+        kernel::syscall_manager()->io_rings().release();
         memory::paging_manager::free_user_process_paging();
         int_lk.lock();
+    } else if (!current_process.system && _current_task->value().user_stack != nullptr) {
+        for (uint64_t stack_offset = 0; stack_offset < _current_task->value().user_stack_size;
+             stack_offset += PAGE_SIZE) {
+            memory::paging_manager::unmap_page(_current_task->value().user_stack_address +
+                                               stack_offset);
+        }
     }
 
     // If the current task is the first task in the priority queue, set the start as the next task
@@ -744,6 +914,11 @@ void influx::threading::scheduler::kill_current_task() {
     // Add the task to the killed tasks queue
     _killed_tasks_queue.push_back(_current_task);
 
+    // The FPU state of the task is no longer needed
+    if (_fpu_owner == _current_task) {
+        _fpu_owner = nullptr;
+    }
+
     // If it is the next task, set the next task as null
     if (task_priority_queue.next_task == _current_task) {
         task_priority_queue.next_task = nullptr;
@@ -762,8 +937,7 @@ void influx::threading::scheduler::kill_current_task() {
 void influx::threading::scheduler::block_task(influx::threading::tcb *task) {
     interrupts_lock int_lk;
 
-    process &task_process = _processes[task->value().pid];
-    priority_tcb_queue &task_priority_queue = _priority_queues[task_process.priority];
+    priority_tcb_queue &task_priority_queue = _priority_queues[task->value().priority];
 
     // If the task isn't already blocked
     if (task->value().state != thread_state::blocked) {
@@ -772,7 +946,7 @@ void influx::threading::scheduler::block_task(influx::threading::tcb *task) {
 
         if (task_priority_queue.next_task == task) {
             // Remove the task as the next task and update the priority queue
-            update_priority_queue_next_task(task_process.priority);
+            update_priority_queue_next_task(task->value().priority);
         }
     }
 }
@@ -786,8 +960,7 @@ void influx::threading::scheduler::block_current_task() {
 void influx::threading::scheduler::unblock_task(influx::threading::tcb *task) {
     interrupts_lock int_lk;
 
-    process &task_process = _processes[task->value().pid];
-    priority_tcb_queue &task_priority_queue = _priority_queues[task_process.priority];
+    priority_tcb_queue &task_priority_queue = _priority_queues[task->value().priority];
 
     // If the task is blocked
     if (task->value().state == thread_state::blocked ||
@@ -817,6 +990,28 @@ void influx::threading::scheduler::exit(uint8_t code) {
     kill_all_tasks(_current_task->value().pid);
 }
 
+void influx::threading::scheduler::exit_thread(uint8_t code) {
+    interrupts_lock int_lk;
+    process &process = _processes[_current_task->value().pid];
+
+    uint32_t *clear_child_tid = _current_task->value().clear_child_tid;
+    uint32_t cleared_tid = 0;
+
+    // Set the error code in case it's the last thread of the process
+    process.exit_code = CLD_EXITED;
+    process.exit_status = code;
+    int_lk.unlock();
+
+    // Clear the thread id in the user memory and wake a thread that waits for this thread to exit
+    if (clear_child_tid != nullptr &&
+        syscalls::utils::copy_to_user(clear_child_tid, &cleared_tid, sizeof(uint32_t))) {
+        kernel::futex_manager()->wake(clear_child_tid, 1, FUTEX_BITSET_MATCH_ANY);
+    }
+
+    // Kill only the current task
+    kill_current_task();
+}
+
 uint64_t influx::threading::scheduler::exec(
     size_t fd, const influx::structures::string &name,
     const influx::structures::vector<influx::structures::string> &args,
@@ -839,6 +1034,11 @@ uint64_t influx::threading::scheduler::exec(
         return 0;
     }
 
+    // The arguments and environment variables must fit below the user stack
+    if (pages_for_argv_envp(exec) * PAGE_SIZE > MAX_USER_ARGS_SIZE) {
+        return 0;
+    }
+
     // If the kernel is requesting to start a process, queue it in the init process
     if (_current_task->value().pid == KERNEL_PID) {
         _init_process.queue_exec(exec);
@@ -847,6 +1047,9 @@ uint64_t influx::threading::scheduler::exec(
 
     // TODO: Kill all other threads
 
+    // The IO ring isn't kept across exec
+    kernel::syscall_manager()->io_rings().release();
+
     // Set the process as new exec process
     process.new_exec_process = true;
 
@@ -871,6 +1074,8 @@ uint64_t influx::threading::scheduler::fork(influx::interrupts::regs old_context
 
     void *kernel_stack = nullptr;
     void *user_stack = nullptr;
+    void *fpu_state = nullptr;
+    void *old_fpu_state = nullptr;
     regs *context = nullptr;
     tcb *task = nullptr;
 
@@ -921,9 +1126,6 @@ uint64_t influx::threading::scheduler::fork(influx::interrupts::regs old_context
                           _current_task->value().args_size);
     segments += seg;
 
-    // Fork the file descriptors
-    kernel::vfs()->fork_file_descriptors(parent_process.open_files);
-
     // Create the fork process
     int_lk.lock();
     pid = _processes.insert_unique(
@@ -939,22 +1141,24 @@ uint64_t influx::threading::scheduler::fork(influx::interrupts::regs old_context
                 .working_dir = parent_process.working_dir,
                 .threads = structures::unique_vector(),
                 .child_processes = structures::vector<uint64_t>(),
-                .open_files = structures::unique_hash_map<vfs::open_file>(),
                 .file_descriptors = structures::unique_hash_map<vfs::file_descriptor>(
-                    vfs::file_descriptor{.open_file_index = UINT64_MAX}),
+                    vfs::file_descriptor{.file = nullptr}),
                 .name = parent_process.name,
                 .segments = parent_process.segments,
                 .signal_dispositions = parent_process.signal_dispositions,
                 .pending_std_signals = structures::vector<signal_info>(),
                 .tty = parent_process.tty,
+                .usage = cpu_usage(),
+                .children_usage = cpu_usage(),
                 .exit_code = CLD_EXITED,
                 .exit_status = 0,
                 .terminated = false,
                 .new_exec_process = false});
     _processes[pid].pid = pid;
 
-    // Recreate file descriptors
+    // Share the open files of the parent with the file descriptors of the fork
     for (auto &fd : parent_process.file_descriptors) {
+        __sync_add_and_fetch(&fd.second.file->references, 1);
         _processes[pid].file_descriptors[fd.first] = fd.second;
     }
 
@@ -973,27 +1177,52 @@ uint64_t influx::threading::scheduler::fork(influx::interrupts::regs old_context
                        sizeof(uint64_t));
 
     // Allocate user stack for main process task
-    user_stack =
-        memory::virtual_allocator::allocate(DEFAULT_USER_STACK_SIZE, PROT_READ | PROT_WRITE);
+    user_stack = memory::virtual_allocator::allocate(_current_task->value().user_stack_size,
+                                                     PROT_READ | PROT_WRITE);
     if (!user_stack) {
         memory::virtual_allocator::free(kernel_stack, DEFAULT_KERNEL_STACK_SIZE);
         _processes.erase(pid);
         return 0;
     }
-    memory::utils::memcpy(user_stack, _current_task->value().user_stack, DEFAULT_USER_STACK_SIZE);
+    memory::utils::memcpy(user_stack, _current_task->value().user_stack,
+                          _current_task->value().user_stack_size);
+
+    // Allocate FPU states for main process task
+    fpu_state = fpu::create_state();
+    old_fpu_state = fpu::create_state();
 
     // Create main task for the process
     int_lk.lock();
+
+    // Copy the current FPU state of the task
+    sync_fpu_state(_current_task);
+    memory::utils::memcpy(fpu_state, _current_task->value().fpu_state, fpu::state_size());
     task = new tcb(thread{.tid = _processes[pid].threads.insert_unique(),
                           .pid = pid,
                           .context = context,
                           .kernel_stack = kernel_stack,
                           .user_stack = user_stack,
+                          .user_stack_address = _current_task->value().user_stack_address,
+                          .user_stack_size = _current_task->value().user_stack_size,
                           .args_size = _current_task->value().args_size,
+                          .fs_base = _current_task->value().fs_base,
+                          .fpu_state = fpu_state,
+                          .old_fpu_state = old_fpu_state,
                           .state = thread_state::ready,
+                          .priority = _processes[pid].priority,
                           .quantum = 0,
                           .sleep_quantum = 0,
+                          .usage = cpu_usage(),
+                          .usage_timestamp = time::tsc_clocksource::rdtsc(),
                           .child_wait_pid = 0,
+                          .futex_key = 0,
+                          .futex_bitset = 0,
+                          .clear_child_tid = nullptr,
+                          .blocked_mutex = nullptr,
+                          .held_mutexes = nullptr,
+                          .wait_queue = nullptr,
+                          .wait_prev = nullptr,
+                          .wait_next = nullptr,
                           .signal_interruptible = false,
                           .signal_interrupted = false,
                           .sig_queue = structures::vector<signal_info>(),
@@ -1019,6 +1248,135 @@ uint64_t influx::threading::scheduler::fork(influx::interrupts::regs old_context
     return pid;
 }
 
+int64_t influx::threading::scheduler::clone(uint64_t entry, uint64_t arg, uint64_t fs_base,
+                                            uint32_t *clear_child_tid) {
+    uint64_t tid = 0, user_stack_address = 0, pid = _current_task->value().pid;
+    structures::vector<uint64_t> used_slot_tids;
+
+    void *kernel_stack = nullptr;
+    void *user_stack = nullptr;
+    void *fpu_state = nullptr;
+    void *old_fpu_state = nullptr;
+    regs *context = nullptr;
+    tcb *task = nullptr;
+
+    interrupts_lock int_lk;
+    process *current_process = &_processes[pid];
+
+    // Only user processes can create user threads
+    if (current_process->system) {
+        return -1;
+    }
+
+    // Reserve a thread id for the new thread, which also selects it's user stack slot. The main
+    // thread of a process that was forked by another thread keeps the stack in that thread's slot,
+    // so thread ids of slots that are still used are skipped
+    while ((tid = current_process->threads.insert_unique()) < MAX_USER_THREADS &&
+           is_user_stack_slot_used(pid, USER_THREAD_STACK_ADDRESS(tid))) {
+        used_slot_tids.push_back(tid);
+    }
+    for (const auto &used_slot_tid : used_slot_tids) {
+        current_process->threads.erase(algorithm::find(current_process->threads.begin(),
+                                                       current_process->threads.end(),
+                                                       used_slot_tid));
+    }
+    if (tid >= MAX_USER_THREADS) {
+        current_process->threads.erase(algorithm::find(current_process->threads.begin(),
+                                                       current_process->threads.end(), tid));
+        return -1;
+    }
+    int_lk.unlock();
+
+    // Get the address of the user stack in the thread's stack slot (above it's guard page)
+    user_stack_address = USER_THREAD_STACK_ADDRESS(tid);
+
+    // Allocate kernel stack for the thread
+    kernel_stack =
+        memory::virtual_allocator::allocate(DEFAULT_KERNEL_STACK_SIZE, PROT_READ | PROT_WRITE);
+    if (!kernel_stack) {
+        int_lk.lock();
+        current_process = &_processes[pid];
+        current_process->threads.erase(algorithm::find(current_process->threads.begin(),
+                                                       current_process->threads.end(), tid));
+        return -1;
+    }
+    context = (regs *)((uint8_t *)kernel_stack + DEFAULT_KERNEL_STACK_SIZE - sizeof(regs) -
+                       sizeof(uint64_t));
+
+    // Allocate user stack for the thread
+    user_stack = memory::virtual_allocator::allocate(DEFAULT_USER_THREAD_STACK_SIZE,
+                                                     PROT_READ | PROT_WRITE);
+    if (!user_stack) {
+        memory::virtual_allocator::free(kernel_stack, DEFAULT_KERNEL_STACK_SIZE);
+        int_lk.lock();
+        current_process = &_processes[pid];
+        current_process->threads.erase(algorithm::find(current_process->threads.begin(),
+                                                       current_process->threads.end(), tid));
+        return -1;
+    }
+
+    // Allocate FPU states for the thread
+    fpu_state = fpu::create_state();
+    old_fpu_state = fpu::create_state();
+
+    // Create the thread in the address space of the process, the process may have moved while
+    // the lock was released
+    int_lk.lock();
+    current_process = &_processes[pid];
+    task = new tcb(thread{.tid = tid,
+                          .pid = pid,
+                          .context = context,
+                          .kernel_stack = kernel_stack,
+                          .user_stack = user_stack,
+                          .user_stack_address = user_stack_address,
+                          .user_stack_size = DEFAULT_USER_THREAD_STACK_SIZE,
+                          .args_size = _current_task->value().args_size,
+                          .fs_base = fs_base,
+                          .fpu_state = fpu_state,
+                          .old_fpu_state = old_fpu_state,
+                          .state = thread_state::ready,
+                          .priority = current_process->priority,
+                          .quantum = 0,
+                          .sleep_quantum = 0,
+                          .usage = cpu_usage(),
+                          .usage_timestamp = time::tsc_clocksource::rdtsc(),
+                          .child_wait_pid = 0,
+                          .futex_key = 0,
+                          .futex_bitset = 0,
+                          .clear_child_tid = clear_child_tid,
+                          .blocked_mutex = nullptr,
+                          .held_mutexes = nullptr,
+                          .wait_queue = nullptr,
+                          .wait_prev = nullptr,
+                          .wait_next = nullptr,
+                          .signal_interruptible = false,
+                          .signal_interrupted = false,
+                          .sig_queue = structures::vector<signal_info>(),
+                          .current_sig = SIGINVL,
+                          .sig_mask = _current_task->value().sig_mask,
+                          .old_interrupt_regs = {},
+                          .old_sig_mask = 0});
+    int_lk.unlock();
+
+    // Set the RIP to return to when the thread is selected
+    *(uint64_t *)((uint8_t *)kernel_stack + DEFAULT_KERNEL_STACK_SIZE - sizeof(uint64_t)) =
+        (uint64_t)new_user_thread_wrapper;
+
+    // Send to the new user thread wrapper the entry point and it's argument
+    context->rdi = entry;
+    context->rsi = arg;
+
+    // Queue the task
+    queue_task(task);
+
+    // Count the user stack of the new thread
+    int_lk.lock();
+    update_max_rss(_processes[pid]);
+    int_lk.unlock();
+
+    return (int64_t)tid;
+}
+
 uint64_t influx::threading::scheduler::sbrk(int64_t inc) {
     interrupts_lock int_lk;
 
@@ -1031,7 +1389,7 @@ uint64_t influx::threading::scheduler::sbrk(int64_t inc) {
 
     // Verify the new program break
     if (task_process.program_break_end + inc < task_process.program_break_start ||
-        task_process.program_break_end + inc >= DEFAULT_USER_STACK_ADDRESS) {
+        task_process.program_break_end + inc >= USER_THREAD_STACKS_BOTTOM) {
         return 0;
     }
 
@@ -1066,6 +1424,7 @@ uint64_t influx::threading::scheduler::sbrk(int64_t inc) {
 
     // Set new program break end
     task_process.program_break_end += inc;
+    update_max_rss(task_process);
 
     return task_process.program_break_end - inc;
 }
@@ -1213,22 +1572,97 @@ uint64_t influx::threading::scheduler::get_current_parent_process_id() {
     return _processes[_current_task->value().pid].ppid;
 }
 
+uint64_t influx::threading::scheduler::get_fs_base() const {
+    return _current_task->value().fs_base;
+}
+
+void influx::threading::scheduler::set_fs_base(uint64_t fs_base) {
+    interrupts_lock int_lk;
+
+    // Set the FS base of the task and load it
+    _current_task->value().fs_base = fs_base;
+    msr::write(MSR_FS_BASE, fs_base);
+    _loaded_fs_base = fs_base;
+}
+
 bool influx::threading::scheduler::interrupted() const {
     return _current_task->value().signal_interrupted;
 }
 
-uint64_t influx::threading::scheduler::add_file_descriptor(const influx::vfs::open_file &file) {
+void influx::threading::scheduler::account_user_time() {
     interrupts_lock int_lk;
-    process &process = _processes[_current_task->value().pid];
 
-    uint64_t open_file_index = process.open_files.insert_unique(file);
+    uint64_t now = time::tsc_clocksource::rdtsc();
+
+    // The task was in userland since its last accounting
+    _current_task->value().usage.user_time += now - _current_task->value().usage_timestamp;
+    _current_task->value().usage_timestamp = now;
+}
+
+void influx::threading::scheduler::account_system_time() {
+    interrupts_lock int_lk;
+
+    uint64_t now = time::tsc_clocksource::rdtsc();
+
+    // The task was in the kernel since its last accounting
+    _current_task->value().usage.system_time += now - _current_task->value().usage_timestamp;
+    _current_task->value().usage_timestamp = now;
+}
+
+void influx::threading::scheduler::count_page_fault() {
+    interrupts_lock int_lk;
 
-    return process.file_descriptors.insert_unique(
-        vfs::file_descriptor{.open_file_index = open_file_index});
+    _current_task->value().usage.page_faults++;
 }
 
-influx::vfs::error influx::threading::scheduler::get_file_descriptor(uint64_t fd,
-                                                                     influx::vfs::open_file &file) {
+influx::threading::cpu_usage influx::threading::scheduler::get_thread_cpu_usage() {
+    interrupts_lock int_lk;
+
+    cpu_usage usage;
+
+    // Charge the time of the current syscall so far
+    account_system_time();
+
+    // Threads share the memory of their process
+    usage = _current_task->value().usage;
+    usage.max_rss = _processes[_current_task->value().pid].usage.max_rss;
+
+    return usage;
+}
+
+influx::threading::cpu_usage influx::threading::scheduler::get_process_cpu_usage() {
+    interrupts_lock int_lk;
+
+    cpu_usage usage;
+
+    // Charge the time of the current syscall so far
+    account_system_time();
+
+    // The usage of the process contains the usage of its threads that were already cleaned
+    usage = _processes[_current_task->value().pid].usage;
+    for (tcb *task : get_process_tasks(_current_task->value().pid)) {
+        usage += task->value().usage;
+    }
+
+    return usage;
+}
+
+influx::threading::cpu_usage influx::threading::scheduler::get_children_cpu_usage() {
+    interrupts_lock int_lk;
+
+    return _processes[_current_task->value().pid].children_usage;
+}
+
+uint64_t influx::threading::scheduler::add_file_descriptor(influx::vfs::open_file *file) {
+    interrupts_lock int_lk;
+    process &process = _processes[_current_task->value().pid];
+
+    // The file descriptor takes the reference of the open file
+    return process.file_descriptors.insert_unique(vfs::file_descriptor{.file = file});
+}
+
+influx::vfs::error influx::threading::scheduler::get_file_descriptor(
+    uint64_t fd, influx::vfs::open_file *&file) {
     interrupts_lock int_lk;
     process &process = _processes[_current_task->value().pid];
 
@@ -1237,65 +1671,62 @@ influx::vfs::error influx::threading::scheduler::get_file_descriptor(uint64_t fd
         return vfs::error::invalid_file;
     }
 
-    // Get the file
-    file = process.open_files[process.file_descriptors[fd].open_file_index];
+    // Get the file and take a reference of it so it won't be closed while it's used
+    file = process.file_descriptors[fd].file;
+    __sync_add_and_fetch(&file->references, 1);
 
     return vfs::error::success;
 }
 
-void influx::threading::scheduler::update_file_descriptor(uint64_t fd,
-                                                          influx::vfs::open_file &file) {
+influx::vfs::open_file *influx::threading::scheduler::remove_file_descriptor(uint64_t fd) {
     interrupts_lock int_lk;
     process &process = _processes[_current_task->value().pid];
 
-    process.open_files[process.file_descriptors[fd].open_file_index] = file;
-}
-
-void influx::threading::scheduler::remove_file_descriptor(uint64_t fd) {
-    interrupts_lock int_lk;
-    process &process = _processes[_current_task->value().pid];
+    vfs::open_file *file = nullptr;
 
-    // If the open file has no file descriptors, delete it
-    if (--process.open_files[process.file_descriptors[fd].open_file_index]
-              .amount_of_file_descriptors == 0) {
-        process.open_files.erase(process.file_descriptors[fd].open_file_index);
+    // If the file descriptor isn't found
+    if (process.file_descriptors.count(fd) == 0) {
+        return nullptr;
     }
 
+    // Remove the file descriptor, the caller releases its reference of the open file
+    file = process.file_descriptors[fd].file;
     process.file_descriptors.erase(fd);
+
+    return file;
 }
 
-uint64_t influx::threading::scheduler::duplicate_file_descriptor(uint64_t oldfd, int64_t newfd) {
+int64_t influx::threading::scheduler::duplicate_file_descriptor(uint64_t oldfd, int64_t newfd) {
     interrupts_lock int_lk;
     process &process = _processes[_current_task->value().pid];
 
-    vfs::file_descriptor file_descriptor = process.file_descriptors[oldfd];
-    vfs::open_file &file = process.open_files[file_descriptor.open_file_index];
-
-    int_lk.unlock();
-    threading::unique_lock vnodes_lk(kernel::vfs()->_vnodes_mutex);
-    vfs::vnode &vn = kernel::vfs()->_vnodes[file.vnode_index];
-    vnodes_lk.unlock();
+    vfs::file_descriptor file_descriptor{.file = nullptr};
+    vfs::open_file *replaced_file = nullptr;
 
-    // Call filesystem duplicate function
-    vn.fs->duplicate_open_file(file, vn.fs_data);
-    int_lk.lock();
+    // Check that the old fd wasn't closed by another thread
+    if (process.file_descriptors.count(oldfd) == 0) {
+        return vfs::error::invalid_file;
+    }
+    file_descriptor = process.file_descriptors[oldfd];
 
-    // Increase amount of file descriptors for the open file
-    file.amount_of_file_descriptors++;
+    // The new file descriptor shares the open file of the old one
+    __sync_add_and_fetch(&file_descriptor.file->references, 1);
 
     // If no new fd was specified
     if (newfd == -1) {
-        return process.file_descriptors.insert_unique(file_descriptor);
-    } else {
-        // If the new fd is in use, close it
-        if (process.file_descriptors.count(newfd) != 0) {
-            if (--process.open_files[process.file_descriptors[newfd].open_file_index]
-                      .amount_of_file_descriptors == 0) {
-                process.open_files.erase(process.file_descriptors[newfd].open_file_index);
-            }
-        }
+        return (int64_t)process.file_descriptors.insert_unique(file_descriptor);
+    }
 
-        process.file_descriptors[newfd] = file_descriptor;
+    // If the new fd is in use, replace it
+    if (process.file_descriptors.count(newfd) != 0) {
+        replaced_file = process.file_descriptors[newfd].file;
+    }
+    process.file_descriptors[newfd] = file_descriptor;
+    int_lk.unlock();
+
+    // Close the open file of the replaced fd
+    if (replaced_file != nullptr) {
+        kernel::vfs()->release_open_file(replaced_file);
     }
 
     return newfd;
@@ -1325,9 +1756,14 @@ void influx::threading::scheduler::tasks_clean_task() {
 
             // Free the task user stack
             if (task->value().user_stack != nullptr) {
-                memory::virtual_allocator::free(task->value().user_stack, DEFAULT_USER_STACK_SIZE);
+                memory::virtual_allocator::free(task->value().user_stack,
+                                                task->value().user_stack_size);
             }
 
+            // Free the task FPU states
+            fpu::free_state(task->value().fpu_state);
+            fpu::free_state(task->value().old_fpu_state);
+
             // Remove the thread from the threads list of the process
             if (!task_process.new_exec_process) {
                 int_lk.lock();
@@ -1336,6 +1772,11 @@ void influx::threading::scheduler::tasks_clean_task() {
                 int_lk.unlock();
             }
 
+            // Add the CPU usage of the thread to its process before the process can be waited for
+            int_lk.lock();
+            task_process.usage += task->value().usage;
+            int_lk.unlock();
+
             // Free the task object
             delete task;
 
@@ -1375,11 +1816,15 @@ uint64_t influx::threading::scheduler::start_process(influx::threading::executab
 
     void *kernel_stack = nullptr;
     void *user_stack = nullptr;
+    void *fpu_state = nullptr;
+    void *old_fpu_state = nullptr;
     regs *context = nullptr;
     tcb *task = nullptr;
 
     executable *exec_copy = nullptr;
 
+    uint64_t tty_vnode_index = 0;
+
     // If the file wasn't parsed
     if (!exec.file.parsed()) {
         return 0;
@@ -1411,14 +1856,15 @@ uint64_t influx::threading::scheduler::start_process(influx::threading::executab
                     .working_dir = _processes[_current_task->value().pid].working_dir,
                     .threads = structures::unique_vector(),
                     .child_processes = structures::vector<uint64_t>(),
-                    .open_files = structures::unique_hash_map<vfs::open_file>(),
                     .file_descriptors = structures::unique_hash_map<vfs::file_descriptor>(
-                        vfs::file_descriptor{.open_file_index = UINT64_MAX}),
+                        vfs::file_descriptor{.file = nullptr}),
                     .name = exec.name,
                     .segments = structures::vector<segment>(),
                     .signal_dispositions = create_default_signal_dispositions(),
                     .pending_std_signals = structures::vector<signal_info>(),
                     .tty = _processes[_current_task->value().pid].tty,
+                    .usage = cpu_usage(),
+                    .children_usage = cpu_usage(),
                     .exit_code = CLD_EXITED,
                     .exit_status = 0,
                     .terminated = false,
@@ -1439,28 +1885,17 @@ uint64_t influx::threading::scheduler::start_process(influx::threading::executab
         _processes[pid].pending_std_signals = structures::vector<signal_info>();
     }
 
-    // Create file descriptors for stdin, stdout and stderr
-    kernel::vfs()
-        ->_vnodes[kernel::tty_manager()->get_tty_vnode(_processes[pid].tty)]
-        .amount_of_open_files += 3;
-    _processes[pid].open_files.insert_unique(
-        vfs::open_file{.vnode_index = kernel::tty_manager()->get_tty_vnode(_processes[pid].tty),
-                       .position = 0,
-                       .flags = vfs::open_flags::read,
-                       .amount_of_file_descriptors = 1});
-    _processes[pid].open_files.insert_unique(
-        vfs::open_file{.vnode_index = kernel::tty_manager()->get_tty_vnode(_processes[pid].tty),
-                       .position = 0,
-                       .flags = vfs::open_flags::write,
-                       .amount_of_file_descriptors = 1});
-    _processes[pid].open_files.insert_unique(
-        vfs::open_file{.vnode_index = kernel::tty_manager()->get_tty_vnode(_processes[pid].tty),
-                       .position = 0,
-                       .flags = vfs::open_flags::write,
-                       .amount_of_file_descriptors = 1});
-    _processes[pid].file_descriptors.insert_unique(vfs::file_descriptor{.open_file_index = 0});
-    _processes[pid].file_descriptors.insert_unique(vfs::file_descriptor{.open_file_index = 1});
-    _processes[pid].file_descriptors.insert_unique(vfs::file_descriptor{.open_file_index = 2});
+    // Create file descriptors for stdin, stdout and stderr, executed processes keep their own
+    if (_processes[pid].file_descriptors.empty()) {
+        tty_vnode_index = kernel::tty_manager()->get_tty_vnode(_processes[pid].tty);
+        kernel::vfs()->_vnodes[tty_vnode_index].amount_of_open_files += 3;
+        for (uint64_t i = 0; i < 3; i++) {
+            _processes[pid].file_descriptors.insert_unique(vfs::file_descriptor{
+                .file = new vfs::open_file(
+                    tty_vnode_index, &kernel::vfs()->_vnodes[tty_vnode_index],
+                    i == 0 ? vfs::open_flags::read : vfs::open_flags::write)});
+        }
+    }
     int_lk.unlock();
 
     // Allocate kernel stack for main process task
@@ -1482,17 +1917,37 @@ uint64_t influx::threading::scheduler::start_process(influx::threading::executab
         return 0;
     }
 
+    // Allocate FPU states for main process task
+    fpu_state = fpu::create_state();
+    old_fpu_state = fpu::create_state();
+
     // Create main task for the process
     task = new tcb(thread{.tid = _processes[pid].threads.insert_unique(),
                           .pid = (uint64_t)pid,
                           .context = context,
                           .kernel_stack = kernel_stack,
                           .user_stack = user_stack,
+                          .user_stack_address = 0,
+                          .user_stack_size = DEFAULT_USER_STACK_SIZE,
                           .args_size = 0,
+                          .fs_base = 0,
+                          .fpu_state = fpu_state,
+                          .old_fpu_state = old_fpu_state,
                           .state = thread_state::ready,
+                          .priority = _processes[pid].priority,
                           .quantum = 0,
                           .sleep_quantum = 0,
+                          .usage = cpu_usage(),
+                          .usage_timestamp = time::tsc_clocksource::rdtsc(),
                           .child_wait_pid = 0,
+                          .futex_key = 0,
+                          .futex_bitset = 0,
+                          .clear_child_tid = nullptr,
+                          .blocked_mutex = nullptr,
+                          .held_mutexes = nullptr,
+                          .wait_queue = nullptr,
+                          .wait_prev = nullptr,
+                          .wait_next = nullptr,
                           .signal_interruptible = false,
                           .signal_interrupted = false,
                           .sig_queue = structures::vector<signal_info>(),
@@ -1519,7 +1974,6 @@ void influx::threading::scheduler::clean_process(uint64_t pid, bool erase,
                                                  bool close_file_descriptors) {
     interrupts_lock int_lk(false);
 
-    tcb *start_node = nullptr, *currnet_node = nullptr;
     bool waited = false;
 
     process &process = _processes[pid];
@@ -1567,42 +2021,31 @@ void influx::threading::scheduler::clean_process(uint64_t pid, bool erase,
                                            .value_ptr = nullptr,
                                            .pad = {0}});
 
-        // Get the start node of the priority queue of the parent process
-        start_node = _priority_queues[_processes[process.ppid].priority].start;
-        currnet_node = start_node;
-
         // Search for the tasks of the parent process
-        if (currnet_node != nullptr) {
-            do {
-                // If the task belongs to the parent process and it's waiting for a
-                // child process, check if the process is the wanted process
-                if (currnet_node->value().pid == process.ppid &&
-                    currnet_node->value().state == thread_state::waiting_for_child) {
-                    if (currnet_node->value().child_wait_pid == (int64_t)pid ||
-                        currnet_node->value().child_wait_pid == WAIT_FOR_ANY_PROCESS) {
-                        // Set the pid of the process that released it
-                        currnet_node->value().child_wait_pid = pid;
-
-                        // Remove the child as a child process
-                        _processes[process.ppid].child_processes.erase(
-                            algorithm::find(_processes[process.ppid].child_processes.begin(),
-                                            _processes[process.ppid].child_processes.end(), pid));
-
-                        // Release interrupts lock
-                        int_lk.unlock();
-
-                        // Unblock the task
-                        unblock_task(currnet_node);
-
-                        // Mark the process as waited
-                        waited = true;
-                        break;
-                    }
-                }
+        for (tcb *parent_task : get_process_tasks(process.ppid)) {
+            // If the task is waiting for a child process, check if the process is the wanted
+            // process
+            if (parent_task->value().state == thread_state::waiting_for_child &&
+                (parent_task->value().child_wait_pid == (int64_t)pid ||
+                 parent_task->value().child_wait_pid == WAIT_FOR_ANY_PROCESS)) {
+                // Set the pid of the process that released it
+                parent_task->value().child_wait_pid = pid;
+
+                // Remove the child as a child process
+                _processes[process.ppid].child_processes.erase(
+                    algorithm::find(_processes[process.ppid].child_processes.begin(),
+                                    _processes[process.ppid].child_processes.end(), pid));
+
+                // Release interrupts lock
+                int_lk.unlock();
+
+                // Unblock the task
+                unblock_task(parent_task);
 
-                // Move to next node
-                currnet_node = currnet_node->next();
-            } while (currnet_node != start_node);
+                // Mark the process as waited
+                waited = true;
+                break;
+            }
         }
     }
 
@@ -1611,10 +2054,10 @@ void influx::threading::scheduler::clean_process(uint64_t pid, bool erase,
         int_lk.unlock();
     }
 
-    // Close all open files
+    // Release the open files of all file descriptors
     if (close_file_descriptors) {
-        for (const auto &file_descriptor : process.open_files) {
-            kernel::vfs()->close_open_file(file_descriptor.second);
+        for (const auto &file_descriptor : process.file_descriptors) {
+            kernel::vfs()->release_open_file(file_descriptor.second.file);
         }
     }
 
@@ -1653,43 +2096,31 @@ void influx::threading::scheduler::kill_all_tasks(uint64_t pid) {
     interrupts_lock int_lk;
 
     kassert(_processes.count(pid));
-    process &process = _processes[pid];
-    priority_tcb_queue &process_priority_queue = _priority_queues[process.priority];
-
-    tcb *current_node = process_priority_queue.start;
 
     interrupts::regs *task_regs = nullptr;
 
-    // While we didn't reach the end of the priority queue
-    do {
-        // If the current node is for the wanted process and it's not the current task, set it to be
-        // terminated
-        if (current_node->value().pid == pid) {
-            // Get the interrupt regs of the task
-            task_regs = get_task_interrupt_regs(current_node);
-
-            // Change interrupt return to terminate thread function of the scheduler
-            task_regs->cs = 0x8;
-            task_regs->ss = 0x10;
-            task_regs->rsp =
-                (uint64_t)current_node->value().kernel_stack + DEFAULT_KERNEL_STACK_SIZE;
-            task_regs->rip = (uint64_t)terminate_thread;
-
-            // Set the task as interrupted
-            current_node->value().signal_interrupted = true;
-
-            // If the task is interruptible and it's blocked, interrupt it and unblock it
-            if (current_node->value().signal_interruptible &&
-                (current_node->value().state == thread_state::blocked ||
-                 current_node->value().state == thread_state::sleeping ||
-                 current_node->value().state == thread_state::waiting_for_child)) {
-                unblock_task(current_node);
-            }
+    // For each task of the process, set it to be terminated
+    for (tcb *task : get_process_tasks(pid)) {
+        // Get the interrupt regs of the task
+        task_regs = get_task_interrupt_regs(task);
+
+        // Change interrupt return to terminate thread function of the scheduler
+        task_regs->cs = 0x8;
+        task_regs->ss = 0x10;
+        task_regs->rsp = (uint64_t)task->value().kernel_stack + DEFAULT_KERNEL_STACK_SIZE;
+        task_regs->rip = (uint64_t)terminate_thread;
+
+        // Set the task as interrupted
+        task->value().signal_interrupted = true;
+
+        // If the task is interruptible and it's blocked, interrupt it and unblock it
+        if (task->value().signal_interruptible &&
+            (task->value().state == thread_state::blocked ||
+             task->value().state == thread_state::sleeping ||
+             task->value().state == thread_state::waiting_for_child)) {
+            unblock_task(task);
         }
-
-        // Move to the next node
-        current_node = current_node->next();
-    } while (current_node != process_priority_queue.start);
+    }
 }
 
 void influx::threading::scheduler::kill_with_signal(uint64_t pid, influx::threading::signal sig) {
@@ -1706,8 +2137,7 @@ void influx::threading::scheduler::kill_with_signal(uint64_t pid, influx::thread
 void influx::threading::scheduler::queue_task(influx::threading::tcb *task) {
     interrupts_lock int_lk;
 
-    process &new_task_process = _processes[task->value().pid];
-    priority_tcb_queue &new_task_priority_queue = _priority_queues[new_task_process.priority];
+    priority_tcb_queue &new_task_priority_queue = _priority_queues[task->value().priority];
 
     // If the queue linked list is empty
     if (new_task_priority_queue.start == nullptr) {
@@ -1826,12 +2256,16 @@ void influx::threading::scheduler::prepare_signal_handle(influx::threading::tcb
                                                          influx::threading::signal_info sig_info) {
     kassert(task->value().current_sig != SIGINVL);
 
-    uint64_t user_stack_start = DEFAULT_USER_STACK_ADDRESS - task->value().args_size;
+    uint64_t user_stack_start = task->value().user_stack_address;
 
     interrupts::regs *regs = get_task_interrupt_regs(task);
 
     // Set the RIP to the handler function and save the old RIP
     task->value().old_interrupt_regs = *regs;
+
+    // Save the FPU state since the handler might change it
+    sync_fpu_state(task);
+    memory::utils::memcpy(task->value().old_fpu_state, task->value().fpu_state, fpu::state_size());
     regs->rip = _processes[task->value().pid].signal_dispositions[sig_info.sig].handler.raw;
 
     // Copy the signal info structure to the stack
@@ -1859,9 +2293,8 @@ void influx::threading::scheduler::send_signal_to_process(uint64_t pid, int64_t
     kassert(_processes.count(pid) != 0);
 
     process &process = _processes[pid];
-    priority_tcb_queue &process_priority_queue = _priority_queues[process.priority];
 
-    tcb *current_node = process_priority_queue.start;
+    tcb *current_node = nullptr;
 
     // Check valid process id
     if (pid == 0 || pid == INIT_PROCESS_PID) {
@@ -1890,40 +2323,25 @@ void influx::threading::scheduler::send_signal_to_process(uint64_t pid, int64_t
 
     // If there isn't a wanted thread
     if (tid == -1) {
-        // Search for the main thread
-        do {
-            if (current_node->value().pid == pid && current_node->value().tid == 0) {
+        structures::vector<tcb *> tasks = get_process_tasks(pid);
+
+        // Search for the main thread and check if it can handle the signal
+        for (tcb *task : tasks) {
+            if (task->value().tid == 0 && !(task->value().sig_mask & (1 << sig_info.sig)) &&
+                task->value().current_sig == SIGINVL) {
+                current_node = task;
                 break;
             }
+        }
 
-            // Move to the next node
-            current_node = current_node->next();
-        } while (current_node != process_priority_queue.start);
-
-        // If the main thread can't handle the signal
-        if (current_node->value().pid != pid || current_node->value().tid != 0 ||
-            (current_node->value().sig_mask & (1 << sig_info.sig)) ||
-            current_node->value().current_sig != SIGINVL) {
-            // Reset current node
-            current_node = process_priority_queue.start;
-
-            // Search for a thread that can handle the signal
-            do {
-                if (current_node->value().pid == pid &&
-                    !(current_node->value().sig_mask & (1 << sig_info.sig)) &&
-                    current_node->value().current_sig == SIGINVL) {
+        // If the main thread can't handle the signal, search for a thread that can handle it
+        if (current_node == nullptr) {
+            for (tcb *task : tasks) {
+                if (!(task->value().sig_mask & (1 << sig_info.sig)) &&
+                    task->value().current_sig == SIGINVL) {
+                    current_node = task;
                     break;
                 }
-
-                // Move to the next node
-                current_node = current_node->next();
-            } while (current_node != process_priority_queue.start);
-
-            // If the node can't handle the signal
-            if (current_node->value().pid != pid ||
-                (current_node->value().sig_mask & (1 << sig_info.sig)) ||
-                current_node->value().current_sig != SIGINVL) {
-                current_node = nullptr;
             }
         }
 
@@ -1935,21 +2353,18 @@ void influx::threading::scheduler::send_signal_to_process(uint64_t pid, int64_t
         }
     } else {
         // Search for the thread
-        do {
+        for (tcb *task : get_process_tasks(pid)) {
             // Check if it's the wanted thread
-            if (current_node->value().pid == pid && current_node->value().tid == (uint64_t)tid) {
+            if (task->value().tid == (uint64_t)tid) {
                 // If the thread blocks the signal or is busy with another signal
-                if ((current_node->value().sig_mask & (1 << sig_info.sig)) ||
-                    current_node->value().current_sig != SIGINVL) {
-                    current_node->value().sig_queue += sig_info;
+                if ((task->value().sig_mask & (1 << sig_info.sig)) ||
+                    task->value().current_sig != SIGINVL) {
+                    task->value().sig_queue += sig_info;
                 } else {
-                    send_signal_to_task(current_node, sig_info);
+                    send_signal_to_task(task, sig_info);
                 }
             }
-
-            // Move to the next node
-            current_node = current_node->next();
-        } while (current_node != process_priority_queue.start);
+        }
     }
 }
 
@@ -2053,6 +2468,11 @@ void influx::threading::scheduler::handle_signal_return(influx::interrupts::regs
     // Restore old regs
     *context = _current_task->value().old_interrupt_regs;
 
+    // Restore old FPU state
+    memory::utils::memcpy(_current_task->value().fpu_state, _current_task->value().old_fpu_state,
+                          fpu::state_size());
+    reload_fpu_state(_current_task);
+
     // Restore old signal mask
     _current_task->value().sig_mask = _current_task->value().old_sig_mask;
 
@@ -2135,13 +2555,198 @@ void influx::threading::scheduler::send_sigint_to_tty(uint64_t tty) {
     }
 }
 
+bool influx::threading::scheduler::is_last_thread(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+    process &process = _processes[task->value().pid];
+
+    // When a process is executing a new file, the old address space belongs to the killed task
+    if (process.new_exec_process) {
+        return true;
+    }
+
+    // Search for another task of the process
+    for (tcb *process_task : get_process_tasks(task->value().pid)) {
+        if (process_task != task) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool influx::threading::scheduler::is_user_stack_slot_used(uint64_t pid,
+                                                           uint64_t user_stack_address) {
+    // ** Interrupts should be locked here **
+
+    // Check if a thread of the process uses the stack slot
+    for (tcb *task : get_process_tasks(pid)) {
+        if (task->value().user_stack_address == user_stack_address) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+influx::structures::vector<influx::threading::tcb *>
+influx::threading::scheduler::get_process_tasks(uint64_t pid) {
+    // ** Interrupts should be locked here **
+    structures::vector<tcb *> tasks;
+    tcb *current_node = nullptr;
+
+    // Tasks can be boosted to other priority queues, so every priority queue should be searched
+    for (auto &priority_queue : _priority_queues) {
+        current_node = priority_queue.start;
+        if (current_node == nullptr) {
+            continue;
+        }
+
+        do {
+            if (current_node->value().pid == pid) {
+                tasks += current_node;
+            }
+
+            // Move to the next node
+            current_node = current_node->next();
+        } while (current_node != priority_queue.start);
+    }
+
+    return tasks;
+}
+
+void influx::threading::scheduler::set_task_priority(influx::threading::tcb *task,
+                                                     uint8_t priority) {
+    // ** Interrupts should be locked here **
+    uint8_t old_priority = task->value().priority;
+    priority_tcb_queue &old_priority_queue = _priority_queues[old_priority];
+
+    kassert(priority <= MAX_PRIORITY_LEVEL);
+
+    // If the priority isn't changed, ignore
+    if (priority == old_priority) {
+        return;
+    }
+
+    // If the task is the next task of the old priority queue, move to the next ready task
+    if (old_priority_queue.next_task == task) {
+        update_priority_queue_next_task(old_priority);
+        if (old_priority_queue.next_task == task) {
+            old_priority_queue.next_task = nullptr;
+        }
+    }
+
+    // If the task is the first task in the old priority queue, set the start as the next task
+    if (old_priority_queue.start == task && task->next() != task) {
+        old_priority_queue.start = task->next();
+    } else if (old_priority_queue.start == task) {
+        old_priority_queue.start = nullptr;
+    }
+
+    // Remove the task from the old priority queue
+    task->prev()->next() = task->next();
+    task->next()->prev() = task->prev();
+
+    // Set the new priority of the task and insert it to the new priority queue
+    task->value().priority = priority;
+    queue_task(task);
+
+    // The running task isn't set as the next task when queued, so it should be set if the new
+    // priority queue doesn't have a next task
+    if (task->value().state == thread_state::running &&
+        _priority_queues[priority].next_task == nullptr) {
+        _priority_queues[priority].next_task = task;
+    }
+}
+
+void influx::threading::scheduler::switch_fpu_context(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+
+    // Kernel tasks never use the FPU, so the state of the last user task can be kept
+    if (task->value().fpu_state == nullptr) {
+        return;
+    }
+
+    if (fpu::mode() == fpu_switch_mode::lazy) {
+        // Let the task use the FPU only if it's state is loaded, otherwise it'll be loaded on first use
+        if (task == _fpu_owner) {
+            fpu::clear_task_switched();
+        } else {
+            fpu::set_task_switched();
+        }
+    } else if (task != _fpu_owner) {
+        // Save the state of the current owner and load the state of the task
+        if (_fpu_owner != nullptr) {
+            fpu::save(_fpu_owner->value().fpu_state);
+        }
+        fpu::restore(task->value().fpu_state);
+
+        // Set the task as the owner of the FPU
+        _fpu_owner = task;
+    }
+}
+
+void influx::threading::scheduler::load_fpu_context() {
+    interrupts_lock int_lk;
+
+    // Kernel tasks shouldn't use the FPU
+    kassert(_current_task->value().fpu_state != nullptr);
+
+    // Allow the usage of the FPU
+    fpu::clear_task_switched();
+
+    // If the state of the task is already loaded
+    if (_fpu_owner == _current_task) {
+        return;
+    }
+
+    // Save the state of the current owner and load the state of the current task
+    if (_fpu_owner != nullptr) {
+        fpu::save(_fpu_owner->value().fpu_state);
+    }
+    fpu::restore(_current_task->value().fpu_state);
+
+    // Set the current task as the owner of the FPU
+    _fpu_owner = _current_task;
+}
+
+void influx::threading::scheduler::sync_fpu_state(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+
+    // If the state of the task isn't loaded, it's saved state is up-to-date
+    if (_fpu_owner != task) {
+        return;
+    }
+
+    // The FPU might be unavailable if the owner isn't the current task
+    fpu::clear_task_switched();
+    fpu::save(task->value().fpu_state);
+    if (task != _current_task && fpu::mode() == fpu_switch_mode::lazy) {
+        fpu::set_task_switched();
+    }
+}
+
+void influx::threading::scheduler::reload_fpu_state(influx::threading::tcb *task) {
+    // ** Interrupts should be locked here **
+
+    // The loaded state of the task is outdated
+    if (_fpu_owner == task) {
+        _fpu_owner = nullptr;
+    }
+
+    // Switch to the new state of the task if it's running
+    if (task == _current_task) {
+        switch_fpu_context(task);
+    }
+}
+
 influx::interrupts::regs *influx::threading::scheduler::get_task_interrupt_regs(
     influx::threading::tcb *task) {
     uint64_t *kernel_stack_ptr =
         task == _current_task ? (uint64_t *)get_stack_pointer() : (uint64_t *)task->value().context;
 
     // Find the interrupt regs
-    while (*kernel_stack_ptr != 0x1B || *(kernel_stack_ptr + 3) != 0x23) {
+    while (*kernel_stack_ptr != USER_SELECTOR(gdt_selector_types::user_code_descriptor) ||
+           *(kernel_stack_ptr + 3) != USER_SELECTOR(gdt_selector_types::user_data_descriptor)) {
         kernel_stack_ptr++;
     }
 
@@ -2164,4 +2769,38 @@ void influx::threading::scheduler::create_wait_status(uint16_t *wait_status,
     } else {
         *wait_status = 0;
     }
+}
+
+void influx::threading::scheduler::reap_child_cpu_usage(influx::threading::process &parent,
+                                                        influx::threading::process &child,
+                                                        influx::threading::cpu_usage *child_usage) {
+    // ** Interrupts should be locked here **
+    cpu_usage usage = child.usage;
+
+    // The usage of a child includes the usage of the children it waited for
+    usage += child.children_usage;
+    parent.children_usage += usage;
+
+    if (child_usage != nullptr) {
+        *child_usage = usage;
+    }
+}
+
+void influx::threading::scheduler::update_max_rss(influx::threading::process &process) {
+    // ** Interrupts should be locked here **
+    uint64_t rss = 0;
+
+    // User memory is mapped when it's allocated, so all of it is resident
+    for (const auto &seg : process.segments) {
+        rss += seg.size + (seg.size % PAGE_SIZE ? PAGE_SIZE - (seg.size % PAGE_SIZE) : 0);
+    }
+    rss += process.program_break_end - process.program_break_start;
+    for (tcb *task : get_process_tasks(process.pid)) {
+        rss += task->value().user_stack_size + task->value().args_size;
+    }
+
+    // Update the max RSS of the process
+    if (rss > process.usage.max_rss) {
+        process.usage.max_rss = rss;
+    }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 %define THREAD_CONTEXT_OFFSET 16
 %define PROCESS_CR3_OFFSET 18
 
+%define MSR_FS_BASE 0xC0000100
+
 section .text
 global switch_task, jump_to_ring_3, return_to_fork_process
 
@@ -37,31 +39,43 @@ switch_task:
 
     ret
 
-;   void jump_to_ring_3(uint64_t ring_3_function_address, void *user_stack, uint64_t argc, const char **argv, const char **envp)
+;   void jump_to_ring_3(uint64_t ring_3_function_address, void *user_stack, uint64_t argc, const char **argv, const char **envp, uint64_t fs_base)
 
 ;   rdi = the address of the ring 3 function
 ;   rsi = the pointer to the user stack
 ;   rdx = argc
 ;   rcx = argv
 ;   r8 = envp
+;   r9 = fs base
 jump_to_ring_3:
+;   Save argc and argv since they are used by WRMSR
+    mov r10, rdx
+    mov r11, rcx
+
 ;   Set ring 3 data segment
-    mov ax, 0x20 + 11b ; Ring 3 data segment
+    mov ax, 0x18 + 11b ; Ring 3 data segment
     mov ds, ax
     mov es, ax
     mov fs, ax
     mov gs, ax
 
+;   Set the FS base of the thread since loading the FS selector resets it
+    mov ecx, MSR_FS_BASE
+    mov rax, r9
+    mov rdx, r9
+    shr rdx, 32
+    wrmsr
+
 ;   Prepare interrupt stack frame
-    push 0x20 + 11b ; Ring 3 data segment as stack segment
+    push 0x18 + 11b ; Ring 3 data segment as stack segment
     push rsi ; The userland stack pointer
     pushf
-    push 0x18 + 11b ; Ring 3 code segment
+    push 0x20 + 11b ; Ring 3 code segment
     push rdi
 
 ;   Set parameters for function
-    mov rdi, rdx
-    mov rsi, rcx
+    mov rdi, r10
+    mov rsi, r11
     mov rdx, r8
 
 ;   Clear registers
@@ -81,15 +95,24 @@ jump_to_ring_3:
 ;   Jump to ring 3 function
     iretq
 
-;   void return_to_fork_process()
+;   void return_to_fork_process(uint64_t fs_base, interrupts::regs old_context)
+
+;   rdi = fs base
 return_to_fork_process:
 ;   Set ring 3 data segment
-    mov ax, 0x20 + 11b ; Ring 3 data segment
+    mov ax, 0x18 + 11b ; Ring 3 data segment
     mov ds, ax
     mov es, ax
     mov fs, ax
     mov gs, ax
 
+;   Set the FS base of the thread since loading the FS selector resets it
+    mov ecx, MSR_FS_BASE
+    mov rax, rdi
+    mov rdx, rdi
+    shr rdx, 32
+    wrmsr
+
 ;   Ignore return address of caller function
     add rsp, 8
 
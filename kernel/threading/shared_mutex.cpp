@@ -0,0 +1,98 @@
+#include <kernel/threading/shared_mutex.h>
+
+#include <kernel/kernel.h>
+#include <kernel/threading/interrupts_lock.h>
+#include <kernel/threading/scheduler.h>
+
+influx::threading::shared_mutex::shared_mutex()
+    : _readers(0), _waiting_writers(0), _writer(false) {}
+
+void influx::threading::shared_mutex::lock() {
+    interrupts_lock int_lk;
+
+    // If the mutex isn't held by anyone, lock it
+    if (!_writer && _readers == 0) {
+        _writer = true;
+        return;
+    }
+
+    // Add the task to the writers wait queue, the mutex will be handed to it when it's released
+    _waiting_writers++;
+    _writers_queue.enqueue(kernel::scheduler()->get_current_task());
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+}
+
+bool influx::threading::shared_mutex::try_lock() {
+    interrupts_lock int_lk;
+
+    // If the mutex isn't held by anyone, lock it
+    if (!_writer && _readers == 0) {
+        _writer = true;
+
+        return true;
+    }
+
+    return false;
+}
+
+void influx::threading::shared_mutex::unlock() {
+    interrupts_lock int_lk;
+
+    // If there is a waiting writer, hand the mutex to it
+    if (_waiting_writers > 0) {
+        _waiting_writers--;
+        _writers_queue.dequeue();
+        return;
+    }
+
+    // Release the mutex and let all waiting readers in
+    _writer = false;
+    if (!_readers_queue.empty()) {
+        _readers += _readers_queue.dequeue_all();
+    }
+}
+
+void influx::threading::shared_mutex::lock_shared() {
+    interrupts_lock int_lk;
+
+    // Readers can enter only if there isn't a writer holding the mutex or waiting for it, so
+    // writers won't starve
+    if (!_writer && _waiting_writers == 0) {
+        _readers++;
+        return;
+    }
+
+    // Add the task to the readers wait queue, it'll be counted as a reader when it's woken up
+    _readers_queue.enqueue(kernel::scheduler()->get_current_task());
+
+    // Reschedule to another task
+    kernel::scheduler()->reschedule();
+}
+
+bool influx::threading::shared_mutex::try_lock_shared() {
+    interrupts_lock int_lk;
+
+    // If there isn't a writer holding the mutex or waiting for it, enter as a reader
+    if (!_writer && _waiting_writers == 0) {
+        _readers++;
+
+        return true;
+    }
+
+    return false;
+}
+
+void influx::threading::shared_mutex::unlock_shared() {
+    interrupts_lock int_lk;
+
+    _readers--;
+
+    // If it was the last reader and there is a waiting writer, hand the mutex to it
+    if (_readers == 0 && _waiting_writers > 0) {
+        _waiting_writers--;
+        _writer = true;
+        _writers_queue.dequeue();
+    }
+}
\ No newline at end of file
@@ -2,18 +2,46 @@
 
 #include <kernel/kernel.h>
 
-influx::threading::spinlock::spinlock() : _value(0) {}
+influx::threading::spinlock::spinlock(const char *name) : _value(0) {
+#ifdef LOCKSTAT
+    _name = name;
+    _lockstat_entry = nullptr;
+    _lockstat_acquire_time = 0;
+#endif
+}
 
 void influx::threading::spinlock::lock() {
+#ifdef LOCKSTAT
+    uint64_t wait_start = lockstat::timestamp();
+    bool contended = _value != 0;
+#endif
+
     while (!__sync_bool_compare_and_swap(&_value, 0, 1))
         ;
     __sync_synchronize();
+
+#ifdef LOCKSTAT
+    // Record the acquisition by the name of the spinlock or by the acquisition site
+    _lockstat_entry =
+        lockstat::get_entry(lock_type::spinlock, _name, __builtin_return_address(0));
+    lockstat::record_acquisition(_lockstat_entry, contended,
+                                 contended ? lockstat::timestamp() - wait_start : 0);
+    _lockstat_acquire_time = lockstat::timestamp();
+#endif
 }
 
 bool influx::threading::spinlock::try_lock() {
     // Try to lock without sync
     if (__sync_bool_compare_and_swap(&_value, 0, 1)) {
         __sync_synchronize();
+
+#ifdef LOCKSTAT
+        _lockstat_entry =
+            lockstat::get_entry(lock_type::spinlock, _name, __builtin_return_address(0));
+        lockstat::record_acquisition(_lockstat_entry, false, 0);
+        _lockstat_acquire_time = lockstat::timestamp();
+#endif
+
         return true;
     }
 
@@ -21,6 +49,10 @@ bool influx::threading::spinlock::try_lock() {
 }
 
 void influx::threading::spinlock::unlock() {
+#ifdef LOCKSTAT
+    lockstat::record_release(_lockstat_entry, lockstat::timestamp() - _lockstat_acquire_time);
+#endif
+
     __sync_synchronize();
     _value = 0;
 }
\ No newline at end of file
@@ -8,18 +8,8 @@
 influx::threading::task_wait_queue::task_wait_queue() : _queue_head(nullptr) {}
 
 void influx::threading::task_wait_queue::enqueue(influx::threading::tcb *task) {
-    lock_guard<spinlock> lk(_queue_lock);
-
-    // If the queue is empty, create the first node
-    if (_queue_head == nullptr) {
-        _queue_head = new structures::node<tcb *>(task);
-        _queue_head->next() = _queue_head;
-        _queue_head->prev() = _queue_head;
-    } else {
-        _queue_head->prev()->next() =
-            new structures::node<tcb *>(task, _queue_head->prev(), _queue_head);
-        _queue_head->prev() = _queue_head->prev()->next();
-    }
+    // Insert the task to the queue by it's priority
+    enqueue_task(task);
 
     // Block the task
     kernel::scheduler()->block_task(task);
@@ -29,95 +19,208 @@ influx::threading::tcb *influx::threading::task_wait_queue::dequeue() {
     lock_guard<spinlock> lk(_queue_lock);
     kassert(_queue_head != nullptr);
 
-    structures::node<tcb *> *current_head = _queue_head;
-    tcb *task = _queue_head->value();
+    tcb *task = _queue_head;
 
-    // Delete and free the node
-    current_head->prev()->next() = current_head->next();
-    current_head->next()->prev() = current_head->prev();
-    _queue_head = current_head->next();
-    delete current_head;
+    // Remove the task from the queue
+    unlink_task(task);
 
-    // If the new queue head is the old queue head, set the queue head as null
-    if (_queue_head == current_head) {
-        _queue_head = nullptr;
+    // Unblock the task
+    kernel::scheduler()->unblock_task(task);
+
+    return task;
+}
+
+influx::threading::tcb *influx::threading::task_wait_queue::dequeue(
+    bool (*filter)(influx::threading::tcb *task, void *data), void *data) {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    tcb *current_task = _queue_head, *task = nullptr;
+
+    // If the queue is empty
+    if (_queue_head == nullptr) {
+        return nullptr;
+    }
+
+    // Find the first task that passes the filter
+    do {
+        if (filter(current_task, data)) {
+            task = current_task;
+            break;
+        }
+
+        // Move to the next task
+        current_task = current_task->value().wait_next;
+    } while (current_task != _queue_head);
+
+    // If no task was found
+    if (task == nullptr) {
+        return nullptr;
     }
 
+    // Remove the task from the queue
+    unlink_task(task);
+
     // Unblock the task
     kernel::scheduler()->unblock_task(task);
 
     return task;
 }
 
-influx::structures::vector<influx::threading::tcb *>
-influx::threading::task_wait_queue::dequeue_all() {
+uint64_t influx::threading::task_wait_queue::dequeue_all() {
     lock_guard<spinlock> lk(_queue_lock);
-    kassert(_queue_head != nullptr);
 
-    structures::vector<tcb *> tasks;
-    structures::node<tcb *> *current_task;
+    tcb *current_task = _queue_head, *next_task = nullptr;
+    uint64_t amount_of_tasks = 0;
+
+    // If the queue is empty
+    if (_queue_head == nullptr) {
+        return 0;
+    }
 
-    // Make the list a flat list
-    _queue_head->prev()->next() = nullptr;
+    // Splice the whole list out of the queue and make it a flat list
+    _queue_head->value().wait_prev->value().wait_next = nullptr;
+    _queue_head = nullptr;
 
     // While we didn't reach the end of the list
-    while (_queue_head != nullptr) {
-        // Add the task to the vector of tasks
-        tasks += _queue_head->value();
+    while (current_task != nullptr) {
+        next_task = current_task->value().wait_next;
+
+        // Detach the task from the queue
+        current_task->value().wait_queue = nullptr;
+        current_task->value().wait_prev = nullptr;
+        current_task->value().wait_next = nullptr;
 
         // Unblock the task
-        kernel::scheduler()->unblock_task(_queue_head->value());
+        kernel::scheduler()->unblock_task(current_task);
+        amount_of_tasks++;
 
         // Move to the next task
-        current_task = _queue_head;
-        _queue_head = _queue_head->next();
+        current_task = next_task;
+    }
+
+    return amount_of_tasks;
+}
+
+influx::structures::vector<influx::threading::tcb *>
+influx::threading::task_wait_queue::requeue(influx::threading::task_wait_queue &other,
+                                            uint64_t count) {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    structures::vector<tcb *> tasks;
+    tcb *task = nullptr;
+
+    // While there are tasks left to move
+    while (_queue_head != nullptr && tasks.size() < count) {
+        task = _queue_head;
 
-        // Free the current task node
-        delete current_task;
+        // Move the task to the other queue without unblocking it
+        unlink_task(task);
+        other.enqueue_task(task);
+        tasks += task;
     }
 
     return tasks;
 }
 
-void influx::threading::task_wait_queue::remove_task(influx::threading::tcb *task) {
+bool influx::threading::task_wait_queue::remove_task(influx::threading::tcb *task) {
     lock_guard<spinlock> lk(_queue_lock);
 
-    structures::node<tcb *> *current_node = _queue_head;
+    // If the task isn't in this queue
+    if (task->value().wait_queue != this) {
+        return false;
+    }
 
-    // If the queue is empty
+    // Remove the task from the queue
+    unlink_task(task);
+
+    return true;
+}
+
+void influx::threading::task_wait_queue::reposition(influx::threading::tcb *task) {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    // Re-insert the task so it'll be placed by it's new priority
+    if (task->value().wait_queue == this) {
+        unlink_task(task);
+        insert_task(task);
+    }
+}
+
+influx::threading::tcb *influx::threading::task_wait_queue::front() {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    return _queue_head;
+}
+
+bool influx::threading::task_wait_queue::empty() {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    return _queue_head == nullptr;
+}
+
+void influx::threading::task_wait_queue::enqueue_task(influx::threading::tcb *task) {
+    lock_guard<spinlock> lk(_queue_lock);
+
+    insert_task(task);
+}
+
+void influx::threading::task_wait_queue::insert_task(influx::threading::tcb *task) {
+    // ** The queue lock should be locked here **
+    kassert(task->value().wait_queue == nullptr);
+
+    tcb *prev_task = nullptr;
+
+    task->value().wait_queue = this;
+
+    // If the queue is empty, set the task as the first task
     if (_queue_head == nullptr) {
+        _queue_head = task;
+        task->value().wait_prev = task;
+        task->value().wait_next = task;
         return;
     }
 
-    // Find the task's node
-    do {
-        // If it's the task's node, exit loop
-        if (current_node->value() == task) {
+    // Search backwards from the tail for the last task with the same or a higher priority, so
+    // tasks with the same priority are kept in FIFO order and appending is O(1)
+    prev_task = _queue_head->value().wait_prev;
+    while (prev_task->value().priority < task->value().priority) {
+        if (prev_task == _queue_head) {
+            prev_task = nullptr;
             break;
         }
 
-        // Move to the next node
-        current_node = current_node->next();
-    } while (current_node != _queue_head);
-
-    // If we found the task's node
-    if (current_node->value() == task) {
-        // If the node is the head, change the head to next node
-        if (_queue_head == current_node && _queue_head->next() != current_node) {
-            _queue_head = _queue_head->next();
-        } else if (_queue_head == current_node) {
-            _queue_head = nullptr;
-        }
+        // Move to the previous task
+        prev_task = prev_task->value().wait_prev;
+    }
 
-        // Delete and free the node
-        current_node->prev()->next() = current_node->next();
-        current_node->next()->prev() = current_node->prev();
-        delete current_node;
+    // If all tasks have a lower priority, insert the task as the new head
+    if (prev_task == nullptr) {
+        prev_task = _queue_head->value().wait_prev;
+        _queue_head = task;
     }
+
+    // Insert the task after the previous task
+    task->value().wait_prev = prev_task;
+    task->value().wait_next = prev_task->value().wait_next;
+    prev_task->value().wait_next->value().wait_prev = task;
+    prev_task->value().wait_next = task;
 }
 
-bool influx::threading::task_wait_queue::empty() {
-    lock_guard<spinlock> lk(_queue_lock);
+void influx::threading::task_wait_queue::unlink_task(influx::threading::tcb *task) {
+    // ** The queue lock should be locked here **
 
-    return _queue_head == nullptr;
+    // If the task is the head, change the head to the next task
+    if (_queue_head == task && task->value().wait_next != task) {
+        _queue_head = task->value().wait_next;
+    } else if (_queue_head == task) {
+        _queue_head = nullptr;
+    }
+
+    // Unlink the task from the queue
+    task->value().wait_prev->value().wait_next = task->value().wait_next;
+    task->value().wait_next->value().wait_prev = task->value().wait_prev;
+
+    task->value().wait_queue = nullptr;
+    task->value().wait_prev = nullptr;
+    task->value().wait_next = nullptr;
 }
\ No newline at end of file
@@ -1,52 +1,145 @@
 #include <kernel/time/time_manager.h>
 
 #include <kernel/assert.h>
+#include <kernel/drivers/time/hpet.h>
 #include <kernel/kernel.h>
+#include <kernel/memory/paging_manager.h>
+#include <kernel/memory/utils.h>
+#include <kernel/memory/virtual_allocator.h>
 #include <kernel/threading/interrupts_lock.h>
+#include <kernel/time/hpet_clocksource.h>
+#include <kernel/time/timer_clocksource.h>
+#include <kernel/time/tsc_clocksource.h>
+
+static_assert(TIME_PAGE_ADDRESS + PAGE_SIZE <= USER_THREAD_STACKS_BOTTOM,
+              "The time page overlaps the user thread stacks");
 
 influx::time::time_manager::time_manager()
-    : _timer_driver((drivers::timer_driver *)kernel::driver_manager()->get_driver("PIT")),
+    : _log("Time Manager", console_color::green),
+      _timer_driver((drivers::timer_driver *)kernel::driver_manager()->get_driver("PIT")),
       _cmos_driver((drivers::cmos *)kernel::driver_manager()->get_driver("CMOS")),
-      _unix_timestamp(0),
-      _tick_handler({nullptr, nullptr}) {
+      _clocksource(nullptr),
+      _tsc_clocksource(nullptr),
+      _start_count(0),
+      _boot_unix_ns(0),
+      _tick_handler({nullptr, nullptr}),
+      _time_page(
+          (time_page_t *)memory::virtual_allocator::allocate(PAGE_SIZE, PROT_READ | PROT_WRITE)) {
     kassert(_timer_driver != nullptr);
     kassert(_cmos_driver != nullptr);
+    kassert(_time_page != nullptr);
+
+    // Select the most precise clocksource available
+    _clocksource = select_clocksource();
+    _start_count = _clocksource->read();
+    _log("Using the %s clocksource (%d Hz, %d ns resolution).\n", _clocksource->name(),
+         _clocksource->frequency(), _clocksource->resolution());
 
     // Get unix timestamp
-    _unix_timestamp = (double)_cmos_driver->get_unix_timestamp();
-}
+    _boot_unix_ns = _cmos_driver->get_unix_timestamp() * NSECONDS_IN_SECOND;
 
-double influx::time::time_manager::seconds() const {
-    kassert(_timer_driver != nullptr);
+    // Publish the clocksource parameters to userland
+    memory::utils::memset(_time_page, 0, PAGE_SIZE);
+    update_time_page();
+}
 
-    return (double)_timer_driver->current_count() / (double)_timer_driver->count_frequency();
+uint64_t influx::time::time_manager::seconds() const {
+    return monotonic_ns() / NSECONDS_IN_SECOND;
 }
 
-double influx::time::time_manager::milliseconds() const {
-    kassert(_timer_driver != nullptr);
+uint64_t influx::time::time_manager::milliseconds() const {
+    return monotonic_ns() / NSECONDS_IN_MILLISECOND;
+}
 
-    return (double)_timer_driver->current_count() /
-           ((double)_timer_driver->count_frequency() / 1000.0);
+uint64_t influx::time::time_manager::monotonic_ns() const {
+    return _clocksource->to_nanoseconds(_clocksource->read() - _start_count);
 }
 
-uint64_t influx::time::time_manager::unix_timestamp() const { return (uint64_t)_unix_timestamp; }
+uint64_t influx::time::time_manager::realtime_ns() const { return _boot_unix_ns + monotonic_ns(); }
+
+uint64_t influx::time::time_manager::unix_timestamp() const {
+    return realtime_ns() / NSECONDS_IN_SECOND;
+}
 
 uint64_t influx::time::time_manager::unix_timestamp_ms() const {
-    return (uint64_t)(_unix_timestamp * 1000);
+    return realtime_ns() / NSECONDS_IN_MILLISECOND;
 }
 
 influx::time::timeval influx::time::time_manager::get_timeval() const {
-    return timeval{.seconds = unix_timestamp(), .useconds = unix_timestamp_ms() * 1000};
+    uint64_t ns = realtime_ns();
+
+    return timeval{.seconds = ns / NSECONDS_IN_SECOND,
+                   .useconds = (ns % NSECONDS_IN_SECOND) / 1000};
+}
+
+bool influx::time::time_manager::get_time(influx::time::clock_id clock,
+                                          influx::time::timespec &ts) const {
+    uint64_t ns = 0;
+
+    switch (clock) {
+        case clock_id::realtime:
+            ns = realtime_ns();
+            break;
+
+        case clock_id::monotonic:
+            ns = monotonic_ns();
+            break;
+
+        default:
+            return false;
+    }
+
+    ts = timespec{.seconds = ns / NSECONDS_IN_SECOND, .nseconds = ns % NSECONDS_IN_SECOND};
+
+    return true;
+}
+
+bool influx::time::time_manager::get_resolution(influx::time::clock_id clock,
+                                                influx::time::timespec &ts) const {
+    // Both clocks are driven by the same clocksource
+    if (clock != clock_id::realtime && clock != clock_id::monotonic) {
+        return false;
+    }
+
+    ts = timespec{.seconds = 0, .nseconds = _clocksource->resolution()};
+
+    return true;
 }
 
 uint64_t influx::time::time_manager::timer_frequency() const {
     return _timer_driver->timer_frequency();
 }
 
-void influx::time::time_manager::tick() {
-    // Update unix timestamp
-    _unix_timestamp += 0.001;
+const influx::time::clocksource *influx::time::time_manager::current_clocksource() const {
+    return _clocksource;
+}
 
+uint64_t influx::time::time_manager::tsc_to_nanoseconds(uint64_t cycles) const {
+    return _tsc_clocksource != nullptr ? _tsc_clocksource->to_nanoseconds(cycles) : 0;
+}
+
+bool influx::time::time_manager::map_time_page() const {
+    // Map the time page read-only in the current address space
+    if (!memory::paging_manager::map_page(
+            TIME_PAGE_ADDRESS,
+            (int64_t)(memory::paging_manager::get_physical_address((uint64_t)_time_page) /
+                      PAGE_SIZE))) {
+        return false;
+    }
+    memory::paging_manager::set_pte_permissions(TIME_PAGE_ADDRESS, PROT_READ, true);
+
+    return true;
+}
+
+void influx::time::time_manager::unmap_time_page() const {
+    // Unmap the page before the process' memory is freed since the page is shared
+    if (memory::paging_manager::get_physical_address(TIME_PAGE_ADDRESS) ==
+        memory::paging_manager::get_physical_address((uint64_t)_time_page)) {
+        memory::paging_manager::unmap_page(TIME_PAGE_ADDRESS);
+    }
+}
+
+void influx::time::time_manager::tick() {
     // Call tick handler
     if (_tick_handler.function != nullptr) {
         _tick_handler.function(_tick_handler.data);
@@ -57,4 +150,52 @@ void influx::time::time_manager::register_tick_handler(void (*handler)(void *),
     threading::interrupts_lock int_lk;
 
     _tick_handler = tick_handler{.function = handler, .data = data};
+}
+
+influx::time::clocksource *influx::time::time_manager::select_clocksource() {
+    drivers::hpet *hpet_driver = (drivers::hpet *)kernel::driver_manager()->get_driver("HPET");
+    clocksource *reference = nullptr;
+    uint64_t tsc_frequency = 0;
+
+    // The HPET is preferred over the timer as the reference since it has a higher resolution
+    reference = hpet_driver != nullptr ? (clocksource *)new hpet_clocksource(hpet_driver)
+                                       : (clocksource *)new timer_clocksource(_timer_driver);
+
+    // Calibrate the TSC against the reference clocksource, it's needed for CPU time accounting
+    // even when it can't be used as the clocksource
+    tsc_frequency = tsc_clocksource::calibrate(*reference);
+    _log("TSC calibrated against the %s clocksource to %d Hz.\n", reference->name(),
+         tsc_frequency);
+    if (tsc_frequency == 0) {
+        return reference;
+    }
+    _tsc_clocksource = new tsc_clocksource(tsc_frequency);
+
+    // The TSC can only be used as the clocksource if its rate is constant
+    if (!tsc_clocksource::invariant()) {
+        _log("TSC isn't invariant.\n");
+        return reference;
+    }
+    delete reference;
+
+    return _tsc_clocksource;
+}
+
+void influx::time::time_manager::update_time_page() {
+    threading::interrupts_lock int_lk;
+
+    // An odd sequence tells the readers that the page is being updated
+    _time_page->sequence++;
+    __asm__ __volatile__("" ::: "memory");
+
+    // Only the TSC can be read from userland
+    _time_page->mode =
+        _clocksource->user_readable() ? TIME_PAGE_MODE_TSC : TIME_PAGE_MODE_SYSCALL;
+    _time_page->base_count = _start_count;
+    _time_page->mult = _clocksource->mult();
+    _time_page->shift = CLOCKSOURCE_SHIFT;
+    _time_page->realtime_offset_ns = _boot_unix_ns;
+
+    __asm__ __volatile__("" ::: "memory");
+    _time_page->sequence++;
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include <kernel/time/tsc_clocksource.h>
+
+bool influx::time::tsc_clocksource::invariant() {
+    uint32_t eax, ebx, ecx, edx;
+
+    // Check if the advanced power management leaf is supported
+    __asm__ __volatile__("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(CPUID_EXTENDED_MAX_LEAF), "c"(0));
+    if (eax < CPUID_ADVANCED_POWER_MANAGEMENT) {
+        return false;
+    }
+
+    // An invariant TSC runs at a constant rate regardless of the CPU's power state
+    __asm__ __volatile__("cpuid"
+                         : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                         : "a"(CPUID_ADVANCED_POWER_MANAGEMENT), "c"(0));
+    return (edx & CPUID_APM_INVARIANT_TSC) != 0;
+}
+
+uint64_t influx::time::tsc_clocksource::calibrate(const influx::time::clocksource &reference) {
+    uint64_t reference_count = (reference.frequency() * TSC_CALIBRATION_MS) / 1000;
+    uint64_t reference_start = 0, reference_end = 0, tsc_start = 0, tsc_end = 0;
+
+    // Wait for the reference to change so the measurement starts on an edge of its count
+    reference_start = reference.read();
+    while (reference.read() == reference_start) {
+        __asm__ __volatile__("pause");
+    }
+
+    // Count TSC cycles over the calibration period of the reference
+    reference_start = reference.read();
+    tsc_start = rdtsc();
+    do {
+        __asm__ __volatile__("pause");
+        reference_end = reference.read();
+    } while (reference_end - reference_start < reference_count);
+    tsc_end = rdtsc();
+
+    return ((tsc_end - tsc_start) * reference.frequency()) / (reference_end - reference_start);
+}
\ No newline at end of file
@@ -82,7 +82,7 @@ void influx::tty::tty::deactivate() {
     _raw_input_mutex.unlock();
 }
 
-uint64_t influx::tty::tty::stdin_read(char *buf, size_t count) {
+uint64_t influx::tty::tty::stdin_read(char *buf, size_t count, bool non_blocking) {
     threading::unique_lock lk(_stdin_mutex);
 
     uint64_t amount = 0;
@@ -95,6 +95,11 @@ uint64_t influx::tty::tty::stdin_read(char *buf, size_t count) {
 
         // If the new line wasn't found
         if (newline_char == _stdin_buffer.end()) {
+            // Non-blocking reads fail instead of waiting for a whole line
+            if (non_blocking) {
+                return TTY_WOULD_BLOCK;
+            }
+
             // Wait for new input
             if (!_stdin_cv.wait_interruptible(lk)) {
                 return 0;
@@ -107,9 +112,11 @@ uint64_t influx::tty::tty::stdin_read(char *buf, size_t count) {
             return 0;
         }
 
-        // Copy the string
+        // Copy the string, the input stays in the buffer if the buffer is invalid
         amount = algorithm::min<uint64_t>(count, newline_char - _stdin_buffer.begin() + 1);
-        memory::utils::memcpy(buf, _stdin_buffer.begin(), amount);
+        if (memory::utils::memcpy_fault_safe(buf, _stdin_buffer.begin(), amount) != 0) {
+            return TTY_BAD_ADDRESS;
+        }
 
         // Resize the vector
         _stdin_buffer =
@@ -122,15 +129,22 @@ uint64_t influx::tty::tty::stdin_read(char *buf, size_t count) {
     } else {
         // If the buffer is empty, wait for new input
         if (_stdin_buffer.empty()) {
+            // Non-blocking reads fail instead of waiting for input
+            if (non_blocking) {
+                return TTY_WOULD_BLOCK;
+            }
+
             // Wait for new input
             if (!_stdin_cv.wait_interruptible(lk)) {
                 return 0;
             }
         }
 
-        // Copy the string
+        // Copy the string, the input stays in the buffer if the buffer is invalid
         amount = algorithm::min<uint64_t>(count, _stdin_buffer.size());
-        memory::utils::memcpy(buf, _stdin_buffer.begin(), amount);
+        if (memory::utils::memcpy_fault_safe(buf, _stdin_buffer.begin(), amount) != 0) {
+            return TTY_BAD_ADDRESS;
+        }
 
         // Resize the vector
         _stdin_buffer =
@@ -145,6 +159,26 @@ uint64_t influx::tty::tty::stdin_read(char *buf, size_t count) {
     return amount;
 }
 
+uint16_t influx::tty::tty::poll(influx::vfs::poll_listener *listener) {
+    threading::lock_guard lk(_stdin_mutex);
+
+    uint16_t events = VFS_POLL_OUT;
+
+    // Listen to new input
+    if (listener != nullptr) {
+        _stdin_notifier.add_listener(listener);
+    }
+
+    // A canonical terminal can only be read when a whole line was entered
+    if ((_canonical && algorithm::find(_stdin_buffer.begin(), _stdin_buffer.end(), '\n') !=
+                           _stdin_buffer.end()) ||
+        (!_canonical && !_stdin_buffer.empty())) {
+        events |= VFS_POLL_IN;
+    }
+
+    return events;
+}
+
 void influx::tty::tty::stdout_write(influx::structures::string &str) {
     threading::lock_guard lk(_stdout_mutex);
 
@@ -218,8 +252,10 @@ void influx::tty::tty::input_thread() {
                 // If the terminal is canonical and the key was a new line
                 if (_canonical && key_evt.code == key_code::ENTER) {
                     _stdin_cv.notify_one();
+                    _stdin_notifier.notify(VFS_POLL_IN);
                 } else if (!_canonical && key) {
                     _stdin_cv.notify_one();
+                    _stdin_notifier.notify(VFS_POLL_IN);
                 }
             }
         }
@@ -1,6 +1,7 @@
 #include <kernel/tty/tty_filesystem.h>
 
 #include <kernel/kernel.h>
+#include <kernel/memory/utils.h>
 #include <kernel/threading/lock_guard.h>
 #include <kernel/tty/tty_manager.h>
 
@@ -14,7 +15,8 @@ influx::tty::tty_filesystem::tty_filesystem()
 }
 
 influx::vfs::error influx::tty::tty_filesystem::read(void *fs_file_info, char *buffer, size_t count,
-                                                     size_t offset, size_t &amount_read) {
+                                                     size_t offset, size_t &amount_read,
+                                                     vfs::open_flags flags) {
     uint64_t *tty = (uint64_t *)fs_file_info;
 
     // Check for invalid tty
@@ -23,9 +25,16 @@ influx::vfs::error influx::tty::tty_filesystem::read(void *fs_file_info, char *b
     }
 
     // Read from the tty
-    amount_read = kernel::tty_manager()->get_tty(*tty).stdin_read(buffer, count);
+    amount_read = kernel::tty_manager()->get_tty(*tty).stdin_read(
+        buffer, count, flags & vfs::open_flags::non_blocking);
     if (amount_read == 0 && kernel::scheduler()->interrupted()) {
         return vfs::error::interrupted;
+    } else if (amount_read == TTY_BAD_ADDRESS) {
+        amount_read = 0;
+        return vfs::error::bad_address;
+    } else if (amount_read == TTY_WOULD_BLOCK) {
+        amount_read = 0;
+        return vfs::error::would_block;
     }
 
     // Update last access time
@@ -37,8 +46,9 @@ influx::vfs::error influx::tty::tty_filesystem::read(void *fs_file_info, char *b
 
 influx::vfs::error influx::tty::tty_filesystem::write(void *fs_file_info, const char *buffer,
                                                       size_t count, size_t offset,
-                                                      size_t &amount_written) {
-    structures::string str(buffer, count);
+                                                      size_t &amount_written,
+                                                      vfs::open_flags flags) {
+    structures::string str(count, '\0');
     uint64_t *tty = (uint64_t *)fs_file_info;
 
     // Check for invalid tty
@@ -46,6 +56,11 @@ influx::vfs::error influx::tty::tty_filesystem::write(void *fs_file_info, const
         return vfs::error::invalid_file;
     }
 
+    // Copy the buffer, which may be an invalid user buffer
+    if (memory::utils::memcpy_fault_safe(str.data(), buffer, count) != 0) {
+        return vfs::error::bad_address;
+    }
+
     // Write to the tty
     kernel::tty_manager()->get_tty(*tty).stdout_write(str);
     amount_written = count;
@@ -87,4 +102,20 @@ influx::vfs::error influx::tty::tty_filesystem::get_file_info(void *fs_file_info
 
 bool influx::tty::tty_filesystem::compare_fs_file_data(void *fs_file_data_1, void *fs_file_data_2) {
     return *(uint64_t *)fs_file_data_1 == *(uint64_t *)fs_file_data_2;
+}
+
+uint64_t influx::tty::tty_filesystem::fs_file_data_key(void *fs_file_data) {
+    return *(uint64_t *)fs_file_data;
+}
+
+uint16_t influx::tty::tty_filesystem::poll(void *fs_file_info,
+                                           influx::vfs::poll_listener *listener) {
+    uint64_t *tty = (uint64_t *)fs_file_info;
+
+    // Check for invalid tty
+    if (*tty < 1 || *tty > AMOUNT_OF_TTYS) {
+        return VFS_POLL_ERROR;
+    }
+
+    return kernel::tty_manager()->get_tty(*tty).poll(listener);
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include <kernel/vfs/dentry_cache.h>
+
+#include <kernel/assert.h>
+#include <kernel/threading/lock_guard.h>
+
+influx::vfs::dentry_cache::dentry_cache()
+    : _mutex("dentry cache"),
+      _dentries(nullptr),
+      _amount_of_dentries(0),
+      _lru_head(nullptr),
+      _lru_tail(nullptr),
+      _generation(0) {}
+
+void *influx::vfs::dentry_cache::lookup(influx::vfs::filesystem *fs,
+                                        const influx::vfs::path &file_path) {
+    threading::lock_guard lk(_mutex);
+
+    dentry *current = nullptr, *child = nullptr;
+    void *fs_data = nullptr;
+
+    // Only absolute paths can be resolved from the root of the filesystem
+    if (file_path.empty() || !file_path.is_absolute()) {
+        return fs->get_fs_file_data(file_path);
+    }
+
+    // Get the root entry of the filesystem
+    if ((current = find_dentry(fs, nullptr, "")) == nullptr) {
+        // Filesystems without lookups are resolved by their full paths
+        if ((fs_data = fs->get_root_fs_file_data()) == nullptr) {
+            return fs->get_fs_file_data(file_path);
+        }
+
+        current = create_dentry(fs, nullptr, "", fs_data);
+    }
+    touch_dentry(current);
+
+    // Resolve each branch in its parent directory
+    for (size_t i = 1; i < file_path.amount_of_branches() && current->fs_data != nullptr; i++) {
+        // Look up the branch in the filesystem only if it isn't cached
+        if ((child = find_dentry(fs, current, file_path.name(i))) == nullptr) {
+            child = create_dentry(fs, current, file_path.name(i),
+                                  fs->lookup_fs_file_data(current->fs_data, file_path.name(i)));
+        }
+        touch_dentry(child);
+
+        current = child;
+    }
+
+    // Give the caller its own copy of the fs data since the cached one may be evicted
+    fs_data = current->fs_data != nullptr ? fs->duplicate_fs_file_data(current->fs_data) : nullptr;
+
+    // Keep the cache in its size limit
+    evict_dentries();
+
+    return fs_data;
+}
+
+void influx::vfs::dentry_cache::invalidate(influx::vfs::filesystem *fs,
+                                           const influx::vfs::path &file_path) {
+    threading::lock_guard lk(_mutex);
+
+    dentry *current = find_path_dentry(fs, file_path);
+
+    // File info that was read from the filesystem before the change can't be cached anymore
+    _generation++;
+
+    // If the entry isn't cached
+    if (current == nullptr) {
+        return;
+    }
+
+    // The entries of the directory changed, so its info may have changed as well
+    if (current->parent != nullptr) {
+        current->parent->file_cached = false;
+    }
+
+    // Remove the entry so the next lookup will read it from the filesystem
+    current->file_cached = false;
+    if (current->children == 0) {
+        remove_dentry(current);
+    }
+}
+
+bool influx::vfs::dentry_cache::get_file_info(influx::vfs::filesystem *fs,
+                                              const influx::vfs::path &file_path,
+                                              influx::vfs::file_info &file,
+                                              uint64_t &generation) {
+    threading::lock_guard lk(_mutex);
+
+    dentry *current = find_path_dentry(fs, file_path);
+
+    // If the info of the file isn't cached, return the generation it should be cached with
+    if (current == nullptr || !current->file_cached) {
+        generation = _generation;
+        return false;
+    }
+
+    file = current->file;
+
+    return true;
+}
+
+void influx::vfs::dentry_cache::set_file_info(influx::vfs::filesystem *fs,
+                                              const influx::vfs::path &file_path,
+                                              const influx::vfs::file_info &file,
+                                              uint64_t generation) {
+    threading::lock_guard lk(_mutex);
+
+    dentry *current = nullptr;
+
+    // If the file may have changed since its info was read
+    if (generation != _generation) {
+        return;
+    }
+
+    // Cache the info in the entry of the file if it's cached
+    current = find_path_dentry(fs, file_path);
+    if (current != nullptr && current->fs_data != nullptr) {
+        current->file = file;
+        current->file_cached = true;
+    }
+}
+
+void influx::vfs::dentry_cache::forget_file_info(influx::vfs::filesystem *fs,
+                                                 const influx::vfs::path &file_path) {
+    threading::lock_guard lk(_mutex);
+
+    dentry *current = find_path_dentry(fs, file_path);
+
+    if (current != nullptr) {
+        current->file_cached = false;
+    }
+}
+
+influx::vfs::dentry *influx::vfs::dentry_cache::find_dentry(
+    influx::vfs::filesystem *fs, influx::vfs::dentry *parent,
+    const influx::structures::string &name) {
+    // ** The cache mutex should be locked here **
+    uint64_t key = dentry_key(fs, parent, name);
+
+    // Search the entry in the chain of its key
+    for (dentry *entry = _dentries.count(key) ? _dentries[key] : nullptr; entry != nullptr;
+         entry = entry->hash_next) {
+        if (entry->fs == fs && entry->parent == parent && entry->name == name) {
+            return entry;
+        }
+    }
+
+    return nullptr;
+}
+
+influx::vfs::dentry *influx::vfs::dentry_cache::find_path_dentry(
+    influx::vfs::filesystem *fs, const influx::vfs::path &file_path) {
+    // ** The cache mutex should be locked here **
+    dentry *current = nullptr;
+
+    // Only absolute paths are cached
+    if (file_path.empty() || !file_path.is_absolute()) {
+        return nullptr;
+    }
+
+    // Find the cached entry of the path without looking up missing branches
+    current = find_dentry(fs, nullptr, "");
+    for (size_t i = 1; i < file_path.amount_of_branches() && current != nullptr; i++) {
+        current = find_dentry(fs, current, file_path.name(i));
+    }
+
+    return current;
+}
+
+influx::vfs::dentry *influx::vfs::dentry_cache::create_dentry(
+    influx::vfs::filesystem *fs, influx::vfs::dentry *parent,
+    const influx::structures::string &name, void *fs_data) {
+    // ** The cache mutex should be locked here **
+    uint64_t key = dentry_key(fs, parent, name);
+    dentry *entry = new dentry{.fs = fs,
+                               .parent = parent,
+                               .name = name,
+                               .fs_data = fs_data,
+                               .file = {},
+                               .file_cached = false,
+                               .key = key,
+                               .children = 0,
+                               .hash_next = _dentries.count(key) ? _dentries[key] : nullptr,
+                               .lru_prev = nullptr,
+                               .lru_next = nullptr};
+
+    // Add the entry to the head of its chain
+    _dentries[key] = entry;
+    _amount_of_dentries++;
+
+    // The parent can't be evicted while it has cached children
+    if (parent != nullptr) {
+        parent->children++;
+    }
+
+    return entry;
+}
+
+void influx::vfs::dentry_cache::remove_dentry(influx::vfs::dentry *entry) {
+    // ** The cache mutex should be locked here **
+    kassert(entry->children == 0);
+
+    dentry *prev = nullptr;
+
+    // Remove the entry from its chain
+    if (_dentries[entry->key] == entry) {
+        if (entry->hash_next != nullptr) {
+            _dentries[entry->key] = entry->hash_next;
+        } else {
+            _dentries.erase(entry->key);
+        }
+    } else {
+        for (prev = _dentries[entry->key]; prev->hash_next != entry; prev = prev->hash_next) {
+        }
+        prev->hash_next = entry->hash_next;
+    }
+
+    // Remove the entry from the LRU list
+    if (entry->lru_prev != nullptr) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        _lru_head = entry->lru_next;
+    }
+    if (entry->lru_next != nullptr) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        _lru_tail = entry->lru_prev;
+    }
+
+    // Release the parent
+    if (entry->parent != nullptr) {
+        entry->parent->children--;
+    }
+
+    // Free the entry
+    delete (uint32_t *)entry->fs_data;
+    delete entry;
+    _amount_of_dentries--;
+}
+
+void influx::vfs::dentry_cache::touch_dentry(influx::vfs::dentry *entry) {
+    // ** The cache mutex should be locked here **
+
+    // The entry is already the most recently used
+    if (_lru_head == entry) {
+        return;
+    }
+
+    // Remove the entry from its current position in the LRU list
+    if (entry->lru_prev != nullptr) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    if (entry->lru_next != nullptr) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else if (_lru_tail == entry) {
+        _lru_tail = entry->lru_prev;
+    }
+
+    // Move it to the head of the LRU list
+    entry->lru_prev = nullptr;
+    entry->lru_next = _lru_head;
+    if (_lru_head != nullptr) {
+        _lru_head->lru_prev = entry;
+    }
+    _lru_head = entry;
+    if (_lru_tail == nullptr) {
+        _lru_tail = entry;
+    }
+}
+
+void influx::vfs::dentry_cache::evict_dentries() {
+    // ** The cache mutex should be locked here **
+    dentry *entry = _lru_tail, *prev = nullptr;
+
+    // Evict the least recently used entries that don't have cached children
+    while (_amount_of_dentries > DENTRY_CACHE_MAX_ENTRIES && entry != nullptr) {
+        prev = entry->lru_prev;
+        if (entry->children == 0) {
+            remove_dentry(entry);
+        }
+
+        entry = prev;
+    }
+}
+
+uint64_t influx::vfs::dentry_cache::dentry_key(influx::vfs::filesystem *fs,
+                                               influx::vfs::dentry *parent,
+                                               const influx::structures::string &name) {
+    uint64_t key = DENTRY_HASH_OFFSET_BASIS;
+
+    // FNV-1a of the name, mixed with the filesystem and the parent
+    for (size_t i = 0; i < name.size(); i++) {
+        key = (key ^ (uint8_t)name.c_str()[i]) * DENTRY_HASH_PRIME;
+    }
+    key = (key ^ (uint64_t)fs) * DENTRY_HASH_PRIME;
+    key = (key ^ (uint64_t)parent) * DENTRY_HASH_PRIME;
+
+    return key;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <kernel/vfs/epoll_filesystem.h>
+
+#include <kernel/vfs/epoll_manager.h>
+
+influx::vfs::epoll_filesystem::epoll_filesystem(influx::vfs::epoll_manager *manager)
+    : filesystem("EPOLL", drivers::ata::drive_slice()), _manager(manager) {}
+
+influx::vfs::error influx::vfs::epoll_filesystem::get_file_info(void *fs_file_info,
+                                                                influx::vfs::file_info &file) {
+    file = file_info{.inode = 0,
+                     .type = file_type::unknown,
+                     .size = 0,
+                     .blocks = 0,
+                     .permissions = file_permissions{.raw = 1},
+                     .owner_user_id = 0,
+                     .owner_group_id = 0,
+                     .fs_block_size = 0,
+                     .hard_links_count = 1,
+                     .created = 0,
+                     .modified = 0,
+                     .accessed = 0};
+
+    return error::success;
+}
+
+bool influx::vfs::epoll_filesystem::compare_fs_file_data(void *fs_file_data_1,
+                                                         void *fs_file_data_2) {
+    return *(uint64_t *)fs_file_data_1 == *(uint64_t *)fs_file_data_2;
+}
+
+uint64_t influx::vfs::epoll_filesystem::fs_file_data_key(void *fs_file_data) {
+    return *(uint64_t *)fs_file_data;
+}
+
+uint16_t influx::vfs::epoll_filesystem::poll(void *fs_file_info,
+                                             influx::vfs::poll_listener *listener) {
+    return _manager->poll(*(uint64_t *)fs_file_info, listener);
+}
+
+void influx::vfs::epoll_filesystem::release_fs_file_data(void *fs_file_data) {
+    // Destroy the instance once no file descriptor refers to it
+    _manager->destroy_instance(*(uint64_t *)fs_file_data);
+    delete (uint64_t *)fs_file_data;
+}
\ No newline at end of file
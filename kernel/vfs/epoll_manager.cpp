@@ -0,0 +1,349 @@
+#include <kernel/vfs/epoll_manager.h>
+
+#include <kernel/kernel.h>
+#include <kernel/threading/lock_guard.h>
+#include <kernel/threading/unique_lock.h>
+#include <kernel/time/time_manager.h>
+
+influx::vfs::epoll_manager::epoll_manager() : _fs(this), _instances_mutex("epoll_instances") {}
+
+bool influx::vfs::epoll_manager::create_instance(uint64_t *fd) {
+    epoll *instance = new epoll();
+    uint64_t instance_index = 0;
+
+    structures::pair<uint64_t, structures::reference_wrapper<vnode>> vn(
+        0, kernel::vfs()->_vnodes.empty_item());
+
+    // Insert the instance
+    threading::unique_lock lk(_instances_mutex);
+    instance_index = _instances.insert_unique(instance);
+    lk.unlock();
+
+    // Create the vnode for the instance
+    threading::unique_lock vnodes_lk(kernel::vfs()->_vnodes_mutex);
+    if (kernel::vfs()->create_vnode_for_file(
+            (filesystem *)&_fs, new uint64_t(instance_index),
+            file_info{.inode = 0,
+                      .type = file_type::unknown,
+                      .size = 0,
+                      .blocks = 0,
+                      .permissions = file_permissions{.raw = 1},
+                      .owner_user_id = 0,
+                      .owner_group_id = 0,
+                      .fs_block_size = 0,
+                      .hard_links_count = 1,
+                      .created = kernel::time_manager()->unix_timestamp(),
+                      .modified = kernel::time_manager()->unix_timestamp(),
+                      .accessed = kernel::time_manager()->unix_timestamp()},
+            vn) != error::success) {
+        return false;
+    }
+
+    // The instance is released when the last file descriptor of the vnode is closed
+    vn.second->amount_of_open_files = 1;
+    vnodes_lk.unlock();
+
+    // Create the file descriptor of the instance
+    *fd = kernel::scheduler()->add_file_descriptor(
+        new open_file(vn.first, &vn.second.get(), open_flags::read));
+
+    return true;
+}
+
+influx::vfs::error influx::vfs::epoll_manager::control(size_t epfd, int op, size_t fd,
+                                                       const influx::vfs::epoll_event &event) {
+    epoll *instance = get_instance(epfd);
+    epoll_item *item = nullptr;
+    int64_t events = 0;
+
+    // Verify that the instance exists
+    if (instance == nullptr) {
+        return error::invalid_file;
+    }
+
+    // Epoll instances can't be watched by other instances
+    if (get_instance(fd) != nullptr) {
+        return error::invalid_flags;
+    }
+
+    threading::lock_guard lk(instance->mutex);
+    item = instance->items.at(fd);
+
+    switch (op) {
+        case EPOLL_CTL_ADD:
+            // Check if the file is already watched
+            if (item != nullptr) {
+                return error::file_already_exists;
+            }
+
+            // Create the item and listen to the file
+            item = new epoll_item{.fd = fd,
+                                  .events = event.events,
+                                  .data = event.data,
+                                  .enabled = true,
+                                  .ready = false,
+                                  .ready_next = nullptr,
+                                  .listener = poll_listener{.callback = item_callback,
+                                                            .data = nullptr,
+                                                            .notifier = nullptr,
+                                                            .next = nullptr},
+                                  .instance = instance};
+            item->listener.data = item;
+            if ((events = kernel::vfs()->poll(fd, &item->listener)) < 0) {
+                poll_notifier::remove_listener(&item->listener);
+                delete item;
+                return (error)events;
+            }
+            instance->items[fd] = item;
+            break;
+
+        case EPOLL_CTL_MOD:
+            // Check if the file is watched
+            if (item == nullptr) {
+                return error::file_not_found;
+            }
+
+            // Update the item and check the file again
+            item->events = event.events;
+            item->data = event.data;
+            item->enabled = true;
+            if ((events = kernel::vfs()->poll(fd, nullptr)) < 0) {
+                return (error)events;
+            }
+            break;
+
+        case EPOLL_CTL_DEL:
+            // Check if the file is watched
+            if (item == nullptr) {
+                return error::file_not_found;
+            }
+
+            // Remove the item from the instance
+            instance->items.erase(fd);
+            remove_item(item);
+            return error::success;
+
+        default:
+            return error::invalid_flags;
+    }
+
+    // If the file is already ready, queue the item
+    if (events & (item->events | VFS_POLL_ERROR | VFS_POLL_HANG_UP)) {
+        enqueue_ready(item);
+        instance->waiter.wake();
+        instance->notifier.notify(VFS_POLL_IN);
+    }
+
+    return error::success;
+}
+
+int64_t influx::vfs::epoll_manager::wait(size_t epfd, influx::vfs::epoll_event *events,
+                                         size_t max_events, int64_t timeout_ms) {
+    epoll *instance = get_instance(epfd);
+    int64_t deadline_ms = timeout_ms < 0 ? POLL_INFINITE_TIMEOUT
+                                         : (int64_t)kernel::time_manager()->milliseconds() +
+                                               timeout_ms;
+    size_t amount = 0;
+
+    // Verify that the instance exists
+    if (instance == nullptr) {
+        return error::invalid_file;
+    }
+
+    while (true) {
+        // Collect the events of the ready items
+        threading::unique_lock lk(instance->mutex);
+        amount = collect(instance, events, max_events);
+        lk.unlock();
+
+        // Stop when events were found or the timeout had passed
+        if (amount > 0 || timeout_ms == 0 ||
+            (deadline_ms != POLL_INFINITE_TIMEOUT &&
+             (int64_t)kernel::time_manager()->milliseconds() >= deadline_ms)) {
+            break;
+        }
+
+        // Wait for one of the items to become ready
+        if (!instance->waiter.wait_until(deadline_ms)) {
+            return error::interrupted;
+        }
+    }
+
+    return (int64_t)amount;
+}
+
+influx::vfs::epoll *influx::vfs::epoll_manager::get_instance(size_t fd) {
+    open_file_ref file;
+    uint64_t instance_index = 0;
+
+    // Get the open file object of the file descriptor
+    if (kernel::vfs()->get_open_file_for_fd((int64_t)fd, file) != error::success) {
+        return nullptr;
+    }
+
+    // Check that the file is an epoll instance
+    if (file->vn->fs != &_fs) {
+        return nullptr;
+    }
+    instance_index = *(uint64_t *)file->vn->fs_data;
+
+    threading::lock_guard lk(_instances_mutex);
+    return _instances.count(instance_index) ? _instances[instance_index] : nullptr;
+}
+
+void influx::vfs::epoll_manager::destroy_instance(uint64_t instance_index) {
+    epoll *instance = nullptr;
+
+    // Remove the instance
+    threading::unique_lock lk(_instances_mutex);
+    if (!_instances.count(instance_index)) {
+        return;
+    }
+    instance = _instances[instance_index];
+    _instances.erase(instance_index);
+    lk.unlock();
+
+    // Detach the items from their files and free them
+    for (auto &item : instance->items) {
+        remove_item(item.second);
+    }
+    delete instance;
+}
+
+uint16_t influx::vfs::epoll_manager::poll(uint64_t instance_index,
+                                          influx::vfs::poll_listener *listener) {
+    epoll *instance = nullptr;
+
+    // Get the instance
+    threading::unique_lock lk(_instances_mutex);
+    if (!_instances.count(instance_index)) {
+        return VFS_POLL_ERROR;
+    }
+    instance = _instances[instance_index];
+    lk.unlock();
+
+    // Listen to the instance before it's checked so an item that becomes ready isn't missed
+    if (listener != nullptr) {
+        instance->notifier.add_listener(listener);
+    }
+
+    threading::lock_guard ready_lk(instance->ready_mutex);
+    return instance->ready_head != nullptr ? VFS_POLL_IN : 0;
+}
+
+size_t influx::vfs::epoll_manager::collect(influx::vfs::epoll *instance,
+                                           influx::vfs::epoll_event *events, size_t max_events) {
+    structures::vector<epoll_item *> level_triggered;
+    epoll_item *item = nullptr;
+    int64_t file_events = 0;
+    size_t amount = 0;
+
+    while (amount < max_events) {
+        // Take the next ready item
+        threading::unique_lock ready_lk(instance->ready_mutex);
+        if ((item = instance->ready_head) == nullptr) {
+            break;
+        }
+        instance->ready_head = item->ready_next;
+        if (instance->ready_head == nullptr) {
+            instance->ready_tail = nullptr;
+        }
+        item->ready = false;
+        ready_lk.unlock();
+
+        // Skip disabled one-shot items
+        if (!item->enabled) {
+            continue;
+        }
+
+        // Check that the file is still ready since the event might have been consumed
+        file_events = kernel::vfs()->poll(item->fd, nullptr);
+        if (file_events < 0 ||
+            !(file_events &= (item->events | VFS_POLL_ERROR | VFS_POLL_HANG_UP))) {
+            continue;
+        }
+
+        // Report the events of the file
+        events[amount++] = epoll_event{.events = (uint32_t)file_events, .data = item->data};
+
+        // One-shot items are disabled until they are modified, level triggered items stay
+        // queued until the file is no longer ready
+        if (item->events & EPOLLONESHOT) {
+            item->enabled = false;
+        } else if (!(item->events & EPOLLET)) {
+            level_triggered.push_back(item);
+        }
+    }
+
+    // Queue the level triggered items after the collection so they aren't reported twice
+    for (auto &level_triggered_item : level_triggered) {
+        enqueue_ready(level_triggered_item);
+    }
+
+    return amount;
+}
+
+void influx::vfs::epoll_manager::remove_item(influx::vfs::epoll_item *item) {
+    epoll *instance = item->instance;
+    epoll_item *prev = nullptr;
+
+    // Stop listening to the file so the callback won't be called again
+    poll_notifier::remove_listener(&item->listener);
+
+    // Remove the item from the ready list
+    threading::unique_lock ready_lk(instance->ready_mutex);
+    if (item->ready) {
+        for (epoll_item *current = instance->ready_head; current != item;
+             current = current->ready_next) {
+            prev = current;
+        }
+
+        if (prev == nullptr) {
+            instance->ready_head = item->ready_next;
+        } else {
+            prev->ready_next = item->ready_next;
+        }
+        if (instance->ready_tail == item) {
+            instance->ready_tail = prev;
+        }
+    }
+    ready_lk.unlock();
+
+    delete item;
+}
+
+void influx::vfs::epoll_manager::enqueue_ready(influx::vfs::epoll_item *item) {
+    epoll *instance = item->instance;
+
+    threading::lock_guard lk(instance->ready_mutex);
+
+    // Check if the item is already queued
+    if (item->ready) {
+        return;
+    }
+
+    // Add the item to the end of the ready list
+    item->ready = true;
+    item->ready_next = nullptr;
+    if (instance->ready_tail == nullptr) {
+        instance->ready_head = item;
+    } else {
+        instance->ready_tail->ready_next = item;
+    }
+    instance->ready_tail = item;
+}
+
+void influx::vfs::epoll_manager::item_callback(influx::vfs::poll_listener *listener,
+                                               uint16_t events) {
+    epoll_item *item = (epoll_item *)listener->data;
+
+    // Ignore events the item isn't interested in
+    if (!item->enabled || !(events & (item->events | VFS_POLL_ERROR | VFS_POLL_HANG_UP))) {
+        return;
+    }
+
+    // Queue the item and wake the waiting threads
+    enqueue_ready(item);
+    item->instance->waiter.wake();
+    item->instance->notifier.notify(VFS_POLL_IN);
+}
\ No newline at end of file
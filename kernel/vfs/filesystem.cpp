@@ -0,0 +1,92 @@
+#include <kernel/vfs/filesystem.h>
+
+#include <kernel/algorithm.h>
+
+influx::vfs::error influx::vfs::filesystem::readv(void* fs_file_info,
+                                                  const influx::vfs::io_vector* vectors,
+                                                  size_t vector_count, size_t count, size_t offset,
+                                                  size_t& amount_read,
+                                                  influx::vfs::open_flags flags) {
+    size_t vector_amount = 0, vector_read = 0;
+
+    error err;
+
+    amount_read = 0;
+
+    // Read each vector separately until the count is reached
+    for (size_t i = 0; i < vector_count && amount_read < count; i++) {
+        vector_amount = algorithm::min<size_t>(vectors[i].length, count - amount_read);
+        if (vector_amount == 0) {
+            continue;
+        }
+
+        // Read the vector
+        vector_read = 0;
+        if ((err = read(fs_file_info, (char*)vectors[i].base, vector_amount, offset + amount_read,
+                        vector_read, flags)) != error::success) {
+            // Return the data that was already read
+            return amount_read > 0 ? error::success : err;
+        }
+        amount_read += vector_read;
+
+        // Stop on a short read so streams won't block for more data
+        if (vector_read < vector_amount) {
+            break;
+        }
+    }
+
+    return error::success;
+}
+
+influx::vfs::error influx::vfs::filesystem::writev(void* fs_file_info,
+                                                   const influx::vfs::io_vector* vectors,
+                                                   size_t vector_count, size_t count,
+                                                   size_t offset, size_t& amount_written,
+                                                   influx::vfs::open_flags flags) {
+    size_t vector_amount = 0, vector_written = 0;
+
+    error err;
+
+    amount_written = 0;
+
+    // Write each vector separately until the count is reached
+    for (size_t i = 0; i < vector_count && amount_written < count; i++) {
+        vector_amount = algorithm::min<size_t>(vectors[i].length, count - amount_written);
+        if (vector_amount == 0) {
+            continue;
+        }
+
+        // Write the vector
+        vector_written = 0;
+        if ((err = write(fs_file_info, (const char*)vectors[i].base, vector_amount,
+                         offset + amount_written, vector_written, flags)) != error::success) {
+            // Return the data that was already written
+            return amount_written > 0 ? error::success : err;
+        }
+        amount_written += vector_written;
+
+        // Stop on a short write
+        if (vector_written < vector_amount) {
+            break;
+        }
+    }
+
+    return error::success;
+}
+
+uint16_t influx::vfs::filesystem::poll(void* fs_file_info, influx::vfs::poll_listener* listener) {
+    // Files that don't wait for data are always ready
+    return VFS_POLL_IN | VFS_POLL_OUT;
+}
+
+void* influx::vfs::filesystem::get_root_fs_file_data() {
+    // Filesystems without lookups are resolved by their full paths
+    return nullptr;
+}
+
+void* influx::vfs::filesystem::lookup_fs_file_data(void* dir_fs_file_data,
+                                                   const influx::structures::string& name) {
+    return nullptr;
+}
+
+void* influx::vfs::filesystem::duplicate_fs_file_data(void* fs_file_data) { return nullptr; }
\ No newline at end of file
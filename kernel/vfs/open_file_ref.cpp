@@ -0,0 +1,14 @@
+#include <kernel/vfs/open_file_ref.h>
+
+#include <kernel/kernel.h>
+
+influx::vfs::open_file_ref::~open_file_ref() { reset(); }
+
+void influx::vfs::open_file_ref::reset(influx::vfs::open_file* file) {
+    // Release the reference of the current open file
+    if (_file != nullptr) {
+        kernel::vfs()->release_open_file(_file);
+    }
+
+    _file = file;
+}
\ No newline at end of file
@@ -0,0 +1,450 @@
+#include <kernel/vfs/page_cache.h>
+
+#include <kernel/algorithm.h>
+#include <kernel/assert.h>
+#include <kernel/memory/utils.h>
+#include <kernel/memory/virtual_allocator.h>
+#include <kernel/threading/lock_guard.h>
+#include <kernel/threading/unique_lock.h>
+#include <memory/paging.h>
+#include <memory/protection_flags.h>
+
+influx::vfs::page_cache::page_cache()
+    : _mutex("page cache"),
+      _amount_of_pages(0),
+      _amount_of_dirty_pages(0),
+      _lru_head(nullptr),
+      _lru_tail(nullptr) {}
+
+influx::vfs::error influx::vfs::page_cache::read(influx::vfs::vnode &vn,
+                                                 const influx::vfs::io_vector *vectors,
+                                                 size_t vector_count, size_t count, size_t offset,
+                                                 size_t &amount_read,
+                                                 influx::vfs::open_flags flags) {
+    cached_page *page = nullptr;
+    uint64_t index = 0, page_offset = 0, chunk = 0;
+
+    error err;
+
+    amount_read = 0;
+
+    while (amount_read < count) {
+        index = (offset + amount_read) / PAGE_SIZE;
+        page_offset = (offset + amount_read) % PAGE_SIZE;
+        chunk = algorithm::min<uint64_t>(PAGE_SIZE - page_offset, count - amount_read);
+
+        // Read the missing page from the file together with the missing pages after it
+        if ((page = get_page(vn, index)) == nullptr &&
+            (err = fill_pages(vn, index, (offset + count - 1) / PAGE_SIZE - index + 1, flags,
+                              page)) != error::success) {
+            return amount_read > 0 ? error::success : err;
+        }
+
+        // Copy the data to the vectors, which may be invalid user buffers
+        if (!copy_to_vectors(vectors, vector_count, amount_read, page->data + page_offset,
+                             chunk)) {
+            put_page(page);
+            return error::bad_address;
+        }
+        put_page(page);
+
+        amount_read += chunk;
+    }
+
+    // Keep the cache in its size limit
+    evict_pages();
+
+    return error::success;
+}
+
+influx::vfs::error influx::vfs::page_cache::write(influx::vfs::vnode &vn,
+                                                  const influx::vfs::io_vector *vectors,
+                                                  size_t vector_count, size_t count,
+                                                  size_t offset, size_t &amount_written,
+                                                  influx::vfs::open_flags flags) {
+    cached_page *page = nullptr;
+    uint64_t index = 0, page_offset = 0, chunk = 0;
+
+    error err;
+
+    amount_written = 0;
+
+    while (amount_written < count) {
+        index = (offset + amount_written) / PAGE_SIZE;
+        page_offset = (offset + amount_written) % PAGE_SIZE;
+        chunk = algorithm::min<uint64_t>(PAGE_SIZE - page_offset, count - amount_written);
+
+        // Get the page, a partially written page needs the data that is already in the file
+        if ((page = get_page(vn, index)) == nullptr) {
+            if ((page_offset != 0 || chunk < PAGE_SIZE) && index * PAGE_SIZE < vn.file.size) {
+                if ((err = fill_pages(vn, index, 1, flags, page)) != error::success) {
+                    return amount_written > 0 ? error::success : err;
+                }
+            } else if ((page = create_page(index)) != nullptr) {
+                threading::lock_guard lk(_mutex);
+                insert_page(vn, page);
+            } else {
+                return amount_written > 0 ? error::success : error::io_error;
+            }
+        }
+
+        // Mark the page as dirty before the copy so a partial copy won't be dropped
+        set_dirty(page, true);
+
+        // Copy the data from the vectors, which may be invalid user buffers
+        if (!copy_from_vectors(page->data + page_offset, vectors, vector_count, amount_written,
+                               chunk)) {
+            put_page(page);
+            return error::bad_address;
+        }
+        put_page(page);
+
+        amount_written += chunk;
+
+        // The file grows in the cache until its pages are written back
+        vn.file.size = algorithm::max<size_t>(vn.file.size, offset + amount_written);
+    }
+
+    // Write back the file if there are too many dirty pages
+    if (_amount_of_dirty_pages > PAGE_CACHE_MAX_DIRTY_PAGES &&
+        (err = flush(vn)) != error::success) {
+        return err;
+    }
+
+    // Keep the cache in its size limit
+    evict_pages();
+
+    return error::success;
+}
+
+influx::vfs::error influx::vfs::page_cache::flush(influx::vfs::vnode &vn) {
+    cached_page *pages[PAGE_CACHE_MAX_RUN_PAGES];
+    io_vector vectors[PAGE_CACHE_MAX_RUN_PAGES];
+    cached_page *page = nullptr;
+    uint64_t index = 0, amount = 0, file_offset = 0;
+    size_t count = 0, amount_written = 0;
+
+    error err = error::success;
+
+    threading::unique_lock lk(_mutex);
+
+    while ((page = vn.pages.find_next(index)) != nullptr) {
+        // Continue after the found page, or after the run that starts at it
+        index = page->index + 1;
+
+        // Collect the run of dirty pages that starts at the page
+        for (amount = 0; page != nullptr && page->dirty && amount < PAGE_CACHE_MAX_RUN_PAGES;
+             amount++) {
+            page->references++;
+            pages[amount] = page;
+            vectors[amount] = io_vector{.base = page->data, .length = PAGE_SIZE};
+
+            page = vn.pages.find(page->index + 1);
+        }
+
+        // Skip clean pages
+        if (amount == 0) {
+            continue;
+        }
+        index = pages[amount - 1]->index + 1;
+
+        // Write the run to the file without holding the cache, the last page is cut at the end
+        file_offset = pages[0]->index * PAGE_SIZE;
+        count = algorithm::min<size_t>(amount * PAGE_SIZE,
+                                       vn.file.size > file_offset ? vn.file.size - file_offset : 0);
+        lk.unlock();
+        if ((err = vn.fs->writev(vn.fs_data, vectors, amount, count, file_offset, amount_written,
+                                 open_flags::write)) == error::success &&
+            amount_written < count) {
+            err = error::io_error;
+        }
+        lk.lock();
+
+        // Release the pages, they are clean only if they were written
+        for (uint64_t i = 0; i < amount; i++) {
+            if (err == error::success) {
+                pages[i]->dirty = false;
+                _amount_of_dirty_pages--;
+            }
+
+            pages[i]->references--;
+        }
+
+        if (err != error::success) {
+            return err;
+        }
+    }
+
+    return error::success;
+}
+
+void influx::vfs::page_cache::release(influx::vfs::vnode &vn) {
+    threading::lock_guard lk(_mutex);
+
+    cached_page *page = nullptr;
+    uint64_t index = 0;
+
+    // Remove every page of the vnode, unwritten data is dropped
+    while ((page = vn.pages.find_next(index)) != nullptr) {
+        kassert(page->references == 0);
+
+        index = page->index + 1;
+        remove_page(page);
+    }
+}
+
+influx::vfs::error influx::vfs::page_cache::fill_pages(influx::vfs::vnode &vn, uint64_t index,
+                                                       uint64_t max_amount,
+                                                       influx::vfs::open_flags flags,
+                                                       influx::vfs::cached_page *&first_page) {
+    // ** The file mutex of the vnode should be locked here **
+    cached_page *pages[PAGE_CACHE_MAX_RUN_PAGES];
+    io_vector vectors[PAGE_CACHE_MAX_RUN_PAGES];
+    uint64_t amount = 0, file_offset = index * PAGE_SIZE;
+    size_t amount_read = 0;
+
+    error err;
+
+    threading::unique_lock lk(_mutex);
+
+    // Find the run of missing pages in the file, the first page is known to be missing
+    max_amount = algorithm::min<uint64_t>(max_amount, PAGE_CACHE_MAX_RUN_PAGES);
+    for (amount = 1; amount < max_amount && (index + amount) * PAGE_SIZE < vn.file.size &&
+                     vn.pages.find(index + amount) == nullptr;
+         amount++) {
+    }
+    lk.unlock();
+
+    // Create the pages of the run
+    for (uint64_t i = 0; i < amount; i++) {
+        if ((pages[i] = create_page(index + i)) == nullptr) {
+            amount = i;
+            break;
+        }
+
+        vectors[i] = io_vector{.base = pages[i]->data, .length = PAGE_SIZE};
+    }
+
+    // Read the run from the file, the parts of the pages after the end of the file stay empty
+    if (amount == 0) {
+        return error::io_error;
+    } else if ((err = vn.fs->readv(
+                    vn.fs_data, vectors, amount,
+                    algorithm::min<size_t>(
+                        amount * PAGE_SIZE,
+                        vn.file.size > file_offset ? vn.file.size - file_offset : 0),
+                    file_offset, amount_read, flags)) != error::success) {
+        for (uint64_t i = 0; i < amount; i++) {
+            memory::virtual_allocator::free(pages[i]->data, PAGE_SIZE);
+            delete pages[i];
+        }
+
+        return err;
+    }
+
+    // Add the pages to the cache, only the first page stays in use
+    lk.lock();
+    for (uint64_t i = 0; i < amount; i++) {
+        insert_page(vn, pages[i]);
+
+        if (i > 0) {
+            pages[i]->references--;
+        }
+    }
+    first_page = pages[0];
+
+    return error::success;
+}
+
+influx::vfs::cached_page *influx::vfs::page_cache::get_page(influx::vfs::vnode &vn,
+                                                            uint64_t index) {
+    threading::lock_guard lk(_mutex);
+
+    cached_page *page = vn.pages.find(index);
+
+    // Mark the page as in use so it won't be evicted
+    if (page != nullptr) {
+        page->references++;
+        touch_page(page);
+    }
+
+    return page;
+}
+
+void influx::vfs::page_cache::put_page(influx::vfs::cached_page *page) {
+    threading::lock_guard lk(_mutex);
+
+    kassert(page->references > 0);
+    page->references--;
+}
+
+void influx::vfs::page_cache::set_dirty(influx::vfs::cached_page *page, bool dirty) {
+    threading::lock_guard lk(_mutex);
+
+    // Update the amount of dirty pages only when the state changes
+    if (page->dirty != dirty) {
+        page->dirty = dirty;
+        _amount_of_dirty_pages = dirty ? _amount_of_dirty_pages + 1 : _amount_of_dirty_pages - 1;
+    }
+}
+
+void influx::vfs::page_cache::insert_page(influx::vfs::vnode &vn, influx::vfs::cached_page *page) {
+    // ** The cache mutex should be locked here **
+    bool inserted = vn.pages.insert(page->index, page);
+
+    kassert(inserted);
+
+    // Add the page to the head of the LRU list
+    page->tree = &vn.pages;
+    touch_page(page);
+    _amount_of_pages++;
+}
+
+void influx::vfs::page_cache::remove_page(influx::vfs::cached_page *page) {
+    // ** The cache mutex should be locked here **
+
+    // Remove the page from the tree of its vnode
+    page->tree->erase(page->index);
+
+    // Remove the page from the LRU list
+    if (page->lru_prev != nullptr) {
+        page->lru_prev->lru_next = page->lru_next;
+    } else {
+        _lru_head = page->lru_next;
+    }
+    if (page->lru_next != nullptr) {
+        page->lru_next->lru_prev = page->lru_prev;
+    } else {
+        _lru_tail = page->lru_prev;
+    }
+
+    // Free the page
+    if (page->dirty) {
+        _amount_of_dirty_pages--;
+    }
+    memory::virtual_allocator::free(page->data, PAGE_SIZE);
+    delete page;
+    _amount_of_pages--;
+}
+
+void influx::vfs::page_cache::touch_page(influx::vfs::cached_page *page) {
+    // ** The cache mutex should be locked here **
+
+    // The page is already the most recently used
+    if (_lru_head == page) {
+        return;
+    }
+
+    // Remove the page from its current position in the LRU list
+    if (page->lru_prev != nullptr) {
+        page->lru_prev->lru_next = page->lru_next;
+    }
+    if (page->lru_next != nullptr) {
+        page->lru_next->lru_prev = page->lru_prev;
+    } else if (_lru_tail == page) {
+        _lru_tail = page->lru_prev;
+    }
+
+    // Move it to the head of the LRU list
+    page->lru_prev = nullptr;
+    page->lru_next = _lru_head;
+    if (_lru_head != nullptr) {
+        _lru_head->lru_prev = page;
+    }
+    _lru_head = page;
+    if (_lru_tail == nullptr) {
+        _lru_tail = page;
+    }
+}
+
+void influx::vfs::page_cache::evict_pages() {
+    threading::lock_guard lk(_mutex);
+
+    cached_page *page = _lru_tail, *prev = nullptr;
+
+    // Evict the least recently used pages that are clean and not in use
+    while (page != nullptr && _amount_of_pages > PAGE_CACHE_MAX_PAGES) {
+        prev = page->lru_prev;
+
+        if (!page->dirty && page->references == 0) {
+            remove_page(page);
+        }
+
+        page = prev;
+    }
+}
+
+influx::vfs::cached_page *influx::vfs::page_cache::create_page(uint64_t index) {
+    uint8_t *data =
+        (uint8_t *)memory::virtual_allocator::allocate(PAGE_SIZE, PROT_READ | PROT_WRITE);
+
+    // Check if the page was allocated
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    // New pages are empty and start in use by their creator
+    memory::utils::memset(data, 0, PAGE_SIZE);
+    return new cached_page{.index = index,
+                           .data = data,
+                           .dirty = false,
+                           .references = 1,
+                           .tree = nullptr,
+                           .lru_prev = nullptr,
+                           .lru_next = nullptr};
+}
+
+bool influx::vfs::page_cache::copy_to_vectors(const influx::vfs::io_vector *vectors,
+                                              size_t vector_count, size_t vectors_offset,
+                                              const uint8_t *data, size_t amount) {
+    size_t vector_amount = 0;
+
+    for (size_t i = 0; i < vector_count && amount > 0; i++) {
+        // Skip the vectors that were already filled
+        if (vectors_offset >= vectors[i].length) {
+            vectors_offset -= vectors[i].length;
+            continue;
+        }
+
+        // Copy the part of the data that fits in the vector
+        vector_amount = algorithm::min<size_t>(vectors[i].length - vectors_offset, amount);
+        if (memory::utils::memcpy_fault_safe((uint8_t *)vectors[i].base + vectors_offset, data,
+                                             vector_amount) != 0) {
+            return false;
+        }
+
+        data += vector_amount;
+        amount -= vector_amount;
+        vectors_offset = 0;
+    }
+
+    return true;
+}
+
+bool influx::vfs::page_cache::copy_from_vectors(uint8_t *data,
+                                                const influx::vfs::io_vector *vectors,
+                                                size_t vector_count, size_t vectors_offset,
+                                                size_t amount) {
+    size_t vector_amount = 0;
+
+    for (size_t i = 0; i < vector_count && amount > 0; i++) {
+        // Skip the vectors that were already written
+        if (vectors_offset >= vectors[i].length) {
+            vectors_offset -= vectors[i].length;
+            continue;
+        }
+
+        // Copy the part of the vector that fits in the data
+        vector_amount = algorithm::min<size_t>(vectors[i].length - vectors_offset, amount);
+        if (memory::utils::memcpy_fault_safe(
+                data, (const uint8_t *)vectors[i].base + vectors_offset, vector_amount) != 0) {
+            return false;
+        }
+
+        data += vector_amount;
+        amount -= vector_amount;
+        vectors_offset = 0;
+    }
+
+    return true;
+}
\ No newline at end of file
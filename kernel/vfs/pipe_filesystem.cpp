@@ -8,7 +8,8 @@ influx::vfs::pipe_filesystem::pipe_filesystem(influx::vfs::pipe_manager *manager
 
 influx::vfs::error influx::vfs::pipe_filesystem::read(void *fs_file_info, char *buffer,
                                                       size_t count, size_t offset,
-                                                      size_t &amount_read) {
+                                                      size_t &amount_read,
+                                                      influx::vfs::open_flags flags) {
     uint64_t pipe_index = *(uint64_t *)fs_file_info;
 
     // Verify that the pipe exists
@@ -17,9 +18,15 @@ influx::vfs::error influx::vfs::pipe_filesystem::read(void *fs_file_info, char *
     }
 
     // Read from the pipe
-    amount_read = _manager->read(pipe_index, buffer, count);
+    amount_read = _manager->read(pipe_index, buffer, count, flags & open_flags::non_blocking);
     if (amount_read == 0 && kernel::scheduler()->interrupted()) {
         return error::interrupted;
+    } else if (amount_read == PIPE_BAD_ADDRESS) {
+        amount_read = 0;
+        return error::bad_address;
+    } else if (amount_read == PIPE_WOULD_BLOCK) {
+        amount_read = 0;
+        return error::would_block;
     }
 
     return error::success;
@@ -27,7 +34,8 @@ influx::vfs::error influx::vfs::pipe_filesystem::read(void *fs_file_info, char *
 
 influx::vfs::error influx::vfs::pipe_filesystem::write(void *fs_file_info, const char *buffer,
                                                        size_t count, size_t offset,
-                                                       size_t &amount_written) {
+                                                       size_t &amount_written,
+                                                       influx::vfs::open_flags flags) {
     uint64_t pipe_index = *(uint64_t *)fs_file_info;
 
     // Verify that the pipe exists
@@ -36,10 +44,16 @@ influx::vfs::error influx::vfs::pipe_filesystem::write(void *fs_file_info, const
     }
 
     // Write to the pipe
-    amount_written = _manager->write(pipe_index, buffer, count);
+    amount_written = _manager->write(pipe_index, buffer, count, flags & open_flags::non_blocking);
     if (amount_written == 0 && kernel::scheduler()->interrupted()) {
         return error::interrupted;
-    } else if (amount_written == (uint64_t)-1) {
+    } else if (amount_written == PIPE_BAD_ADDRESS) {
+        amount_written = 0;
+        return error::bad_address;
+    } else if (amount_written == PIPE_WOULD_BLOCK) {
+        amount_written = 0;
+        return error::would_block;
+    } else if (amount_written == PIPE_CLOSED) {
         // Raise SIGPIPE
         kernel::scheduler()->send_signal(
             kernel::scheduler()->get_current_process_id(), -1,
@@ -80,8 +94,12 @@ bool influx::vfs::pipe_filesystem::compare_fs_file_data(void *fs_file_data_1,
     return *(uint64_t *)fs_file_data_1 == *(uint64_t *)fs_file_data_2;
 }
 
-void influx::vfs::pipe_filesystem::duplicate_open_file(const influx::vfs::open_file &file,
-                                                       void *fs_file_info) {
+uint64_t influx::vfs::pipe_filesystem::fs_file_data_key(void *fs_file_data) {
+    return *(uint64_t *)fs_file_data;
+}
+
+void influx::vfs::pipe_filesystem::close_open_file(const influx::vfs::open_file &file,
+                                                   void *fs_file_info) {
     uint64_t pipe_index = *(uint64_t *)fs_file_info;
 
     pipe *p = nullptr;
@@ -96,32 +114,31 @@ void influx::vfs::pipe_filesystem::duplicate_open_file(const influx::vfs::open_f
     threading::lock_guard lk(p->mutex);
 
     // If the file descriptor is a read file descriptor
-    if (file.flags == open_flags::read) {
-        p->amount_of_read_file_descriptors++;
+    if (file.flags & open_flags::read) {
+        p->amount_of_read_file_descriptors--;
     } else {
-        p->amount_of_write_file_descriptors++;
+        p->amount_of_write_file_descriptors--;
+    }
+
+    // Wake the threads that wait for the other side of the pipe
+    if (p->amount_of_read_file_descriptors == 0) {
+        p->write_cv.notify_all();
+        p->notifier.notify(VFS_POLL_ERROR);
+    }
+    if (p->amount_of_write_file_descriptors == 0) {
+        p->read_cv.notify_all();
+        p->notifier.notify(VFS_POLL_HANG_UP);
     }
 }
 
-void influx::vfs::pipe_filesystem::close_open_file(const influx::vfs::open_file &file,
-                                                   void *fs_file_info) {
+uint16_t influx::vfs::pipe_filesystem::poll(void *fs_file_info,
+                                            influx::vfs::poll_listener *listener) {
     uint64_t pipe_index = *(uint64_t *)fs_file_info;
 
-    pipe *p = nullptr;
-
     // Verify that the pipe exists
     if (!_manager->pipe_exists(pipe_index)) {
-        return;
+        return VFS_POLL_ERROR;
     }
 
-    // Get the pipe and lock it's mutex
-    p = _manager->get_pipe(pipe_index);
-    threading::lock_guard lk(p->mutex);
-
-    // If the file descriptor is a read file descriptor
-    if (file.flags == open_flags::read) {
-        p->amount_of_read_file_descriptors--;
-    } else {
-        p->amount_of_write_file_descriptors--;
-    }
+    return _manager->poll(pipe_index, listener);
 }
\ No newline at end of file
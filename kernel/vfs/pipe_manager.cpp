@@ -5,11 +5,13 @@
 #include <kernel/memory/heap.h>
 #include <kernel/memory/utils.h>
 #include <kernel/threading/lock_guard.h>
+#include <kernel/threading/shared_lock.h>
 #include <kernel/threading/unique_lock.h>
 
 influx::vfs::pipe_manager::pipe_manager() : _fs(this) {}
 
-bool influx::vfs::pipe_manager::create_pipe(uint64_t *read_fd, uint64_t *write_fd) {
+bool influx::vfs::pipe_manager::create_pipe(uint64_t *read_fd, uint64_t *write_fd,
+                                            influx::vfs::open_flags flags) {
     pipe *p = new pipe((uint8_t *)kmalloc(PIPE_BUFFER_SIZE), PIPE_BUFFER_SIZE,
                        file_info{.inode = 0,
                                  .type = file_type::fifo,
@@ -42,15 +44,10 @@ bool influx::vfs::pipe_manager::create_pipe(uint64_t *read_fd, uint64_t *write_f
     vnodes_lk.unlock();
 
     // Create read and write file descriptors
-    *read_fd = kernel::scheduler()->add_file_descriptor(open_file{.vnode_index = vn.first,
-                                                                  .position = 0,
-                                                                  .flags = open_flags::read,
-                                                                  .amount_of_file_descriptors = 1});
-    *write_fd =
-        kernel::scheduler()->add_file_descriptor(open_file{.vnode_index = vn.first,
-                                                           .position = 0,
-                                                           .flags = open_flags::write,
-                                                           .amount_of_file_descriptors = 1});
+    *read_fd = kernel::scheduler()->add_file_descriptor(
+        new open_file(vn.first, &vn.second.get(), (open_flags)(open_flags::read | flags)));
+    *write_fd = kernel::scheduler()->add_file_descriptor(
+        new open_file(vn.first, &vn.second.get(), (open_flags)(open_flags::write | flags)));
 
     return true;
 }
@@ -71,7 +68,8 @@ bool influx::vfs::pipe_manager::close_pipe(uint64_t pipe_index) {
     return true;
 }
 
-uint64_t influx::vfs::pipe_manager::read(uint64_t pipe_index, void *buf, size_t count) {
+uint64_t influx::vfs::pipe_manager::read(uint64_t pipe_index, void *buf, size_t count,
+                                         bool non_blocking) {
     pipe *p = get_pipe(pipe_index);
     threading::unique_lock pipe_lk(p->mutex);
 
@@ -79,19 +77,27 @@ uint64_t influx::vfs::pipe_manager::read(uint64_t pipe_index, void *buf, size_t
 
     // If the pipe is empty
     if (p->buffer.current_size() == 0) {
+        // Non-blocking reads fail instead of waiting for a writer
+        if (non_blocking && p->amount_of_write_file_descriptors > 0) {
+            return PIPE_WOULD_BLOCK;
+        }
+
         // If the read was interrupted
         if (p->amount_of_write_file_descriptors == 0 || !p->read_cv.wait_interruptible(pipe_lk)) {
             return 0;
         }
     }
 
-    // Copy from the buffer
+    // Copy from the buffer, the data stays in the pipe if the buffer is invalid
     amount_read = algorithm::min<uint64_t>(count, p->buffer.current_size());
-    p->buffer.pop((uint8_t *)buf, amount_read);
+    if (!p->buffer.pop((uint8_t *)buf, amount_read)) {
+        return PIPE_BAD_ADDRESS;
+    }
 
     // Notify write threads
     if (amount_read > 0) {
         p->write_cv.notify_one();
+        p->notifier.notify(VFS_POLL_OUT);
     }
 
     // Update last accessed time
@@ -100,7 +106,8 @@ uint64_t influx::vfs::pipe_manager::read(uint64_t pipe_index, void *buf, size_t
     return amount_read;
 }
 
-uint64_t influx::vfs::pipe_manager::write(uint64_t pipe_index, const void *buf, size_t count) {
+uint64_t influx::vfs::pipe_manager::write(uint64_t pipe_index, const void *buf, size_t count,
+                                          bool non_blocking) {
     pipe *p = get_pipe(pipe_index);
     threading::unique_lock pipe_lk(p->mutex);
 
@@ -108,33 +115,50 @@ uint64_t influx::vfs::pipe_manager::write(uint64_t pipe_index, const void *buf,
 
     // Check if the pipe is closed
     if (p->amount_of_read_file_descriptors == 0) {
-        return (uint64_t)-1;
+        return PIPE_CLOSED;
     }
 
     // While we didn't write the wanted amount
     while (amount_write < count) {
         // Check if the pipe is closed
         if (p->amount_of_read_file_descriptors == 0) {
-            return (uint64_t)-1;
+            return PIPE_CLOSED;
         }
 
         // If the pipe is full
         if (p->buffer.current_size() == p->buffer.max_size()) {
+            // Non-blocking writes return what was written instead of waiting for a reader
+            if (non_blocking) {
+                if (amount_write == 0) {
+                    return PIPE_WOULD_BLOCK;
+                }
+
+                break;
+            }
+
             // If the write was interrupted
             if (!p->write_cv.wait_interruptible(pipe_lk)) {
                 break;
             }
         }
 
-        // Copy from the buffer
-        current_write =
-            algorithm::min<uint64_t>(count, p->buffer.max_size() - p->buffer.current_size());
-        p->buffer.push((const uint8_t *)buf, current_write);
+        // Copy the next part of the buffer
+        current_write = algorithm::min<uint64_t>(count - amount_write,
+                                                 p->buffer.max_size() - p->buffer.current_size());
+        if (!p->buffer.push((const uint8_t *)buf + amount_write, current_write)) {
+            // Report the invalid buffer only if nothing was written
+            if (amount_write == 0) {
+                return PIPE_BAD_ADDRESS;
+            }
+
+            break;
+        }
         amount_write += current_write;
 
         // Notify read threads
         if (current_write > 0) {
             p->read_cv.notify_one();
+            p->notifier.notify(VFS_POLL_IN);
         }
     }
 
@@ -145,8 +169,38 @@ uint64_t influx::vfs::pipe_manager::write(uint64_t pipe_index, const void *buf,
     return amount_write;
 }
 
+uint16_t influx::vfs::pipe_manager::poll(uint64_t pipe_index,
+                                         influx::vfs::poll_listener *listener) {
+    pipe *p = get_pipe(pipe_index);
+    threading::lock_guard pipe_lk(p->mutex);
+
+    uint16_t events = 0;
+
+    // Listen to changes in the pipe
+    if (listener != nullptr) {
+        p->notifier.add_listener(listener);
+    }
+
+    // The pipe can be read when it has data, and reads end when all writers were closed
+    if (p->buffer.current_size() > 0) {
+        events |= VFS_POLL_IN;
+    }
+    if (p->amount_of_write_file_descriptors == 0) {
+        events |= VFS_POLL_HANG_UP;
+    }
+
+    // The pipe can be written when it has room, writes fail when all readers were closed
+    if (p->amount_of_read_file_descriptors == 0) {
+        events |= VFS_POLL_ERROR;
+    } else if (p->buffer.current_size() < p->buffer.max_size()) {
+        events |= VFS_POLL_OUT;
+    }
+
+    return events;
+}
+
 bool influx::vfs::pipe_manager::pipe_exists(uint64_t pipe_index) {
-    threading::lock_guard pipes_lk(_pipes_mutex);
+    threading::shared_lock pipes_lk(_pipes_mutex);
     return _pipes.count(pipe_index) != 0;
 }
 
@@ -158,7 +212,7 @@ influx::vfs::file_info influx::vfs::pipe_manager::get_pipe_file_info(uint64_t pi
 }
 
 influx::vfs::pipe *influx::vfs::pipe_manager::get_pipe(uint64_t pipe_index) {
-    threading::lock_guard pipes_lk(_pipes_mutex);
+    threading::shared_lock pipes_lk(_pipes_mutex);
     kassert(_pipes.count(pipe_index));
 
     return _pipes[pipe_index];
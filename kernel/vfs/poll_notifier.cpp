@@ -0,0 +1,56 @@
+#include <kernel/vfs/poll_notifier.h>
+
+#include <kernel/threading/lock_guard.h>
+
+influx::vfs::poll_notifier::poll_notifier() : _mutex("poll_notifier"), _listeners(nullptr) {}
+
+influx::vfs::poll_notifier::~poll_notifier() {
+    threading::lock_guard lk(_mutex);
+
+    // Detach all listeners so they won't try to remove themselves later
+    for (poll_listener *listener = _listeners; listener != nullptr; listener = listener->next) {
+        listener->notifier = nullptr;
+    }
+    _listeners = nullptr;
+}
+
+void influx::vfs::poll_notifier::add_listener(influx::vfs::poll_listener *listener) {
+    threading::lock_guard lk(_mutex);
+
+    // Insert the listener at the start of the list
+    listener->notifier = this;
+    listener->next = _listeners;
+    _listeners = listener;
+}
+
+void influx::vfs::poll_notifier::notify(uint16_t events) {
+    threading::lock_guard lk(_mutex);
+
+    // Call the callback of each listener, the callbacks may only take leaf locks
+    for (poll_listener *listener = _listeners; listener != nullptr; listener = listener->next) {
+        listener->callback(listener, events);
+    }
+}
+
+void influx::vfs::poll_notifier::remove_listener(influx::vfs::poll_listener *listener) {
+    poll_notifier *notifier = listener->notifier;
+
+    // The listener isn't attached to any notifier
+    if (notifier == nullptr) {
+        return;
+    }
+
+    threading::lock_guard lk(notifier->_mutex);
+
+    // Find the listener and unlink it
+    for (poll_listener **current = &notifier->_listeners; *current != nullptr;
+         current = &(*current)->next) {
+        if (*current == listener) {
+            *current = listener->next;
+            break;
+        }
+    }
+
+    listener->notifier = nullptr;
+    listener->next = nullptr;
+}
\ No newline at end of file
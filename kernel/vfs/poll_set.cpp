@@ -0,0 +1,121 @@
+#include <kernel/vfs/poll_set.h>
+
+#include <kernel/kernel.h>
+#include <kernel/threading/lock_guard.h>
+#include <kernel/time/time_manager.h>
+
+influx::vfs::poll_waiter::poll_waiter() : _mutex("poll_waiter"), _triggered(false) {}
+
+void influx::vfs::poll_waiter::wake() {
+    threading::lock_guard lk(_mutex);
+
+    _triggered = true;
+    _cv.notify_all();
+}
+
+bool influx::vfs::poll_waiter::wait_until(int64_t deadline_ms) {
+    threading::unique_lock lk(_mutex);
+
+    // An event might have arrived since the files were checked
+    if (_triggered) {
+        _triggered = false;
+        return true;
+    }
+
+    if (deadline_ms == POLL_INFINITE_TIMEOUT) {
+        // The lock isn't reacquired if the wait was interrupted
+        if (!_cv.wait_interruptible(lk)) {
+            return false;
+        }
+    } else {
+        // Let signals wake the task from the timed wait
+        kernel::scheduler()->get_current_task()->value().signal_interruptible = true;
+        _cv.wait_until(lk, (uint64_t)deadline_ms);
+        kernel::scheduler()->get_current_task()->value().signal_interruptible = false;
+
+        if (kernel::scheduler()->interrupted()) {
+            return false;
+        }
+    }
+
+    _triggered = false;
+
+    return true;
+}
+
+void influx::vfs::poll_waiter::listener_callback(influx::vfs::poll_listener *listener,
+                                                 uint16_t events) {
+    ((poll_waiter *)listener->data)->wake();
+}
+
+influx::vfs::poll_set::poll_set(influx::vfs::poll_request *requests, size_t count)
+    : _requests(requests), _count(count), _listeners(count) {
+    for (auto &listener : _listeners) {
+        listener = poll_listener{.callback = poll_waiter::listener_callback,
+                                 .data = &_waiter,
+                                 .notifier = nullptr,
+                                 .next = nullptr};
+    }
+}
+
+influx::vfs::poll_set::~poll_set() {
+    // Detach the listeners before the waiter is destroyed
+    for (auto &listener : _listeners) {
+        poll_notifier::remove_listener(&listener);
+    }
+}
+
+int64_t influx::vfs::poll_set::wait(int64_t timeout_ms) {
+    int64_t deadline_ms = timeout_ms < 0 ? POLL_INFINITE_TIMEOUT
+                                         : (int64_t)kernel::time_manager()->milliseconds() +
+                                               timeout_ms;
+    size_t ready = 0;
+
+    // Check the files and listen to them so events between the checks aren't missed
+    ready = scan(true);
+
+    while (ready == 0 && timeout_ms != 0) {
+        // Stop when the timeout had passed
+        if (deadline_ms != POLL_INFINITE_TIMEOUT &&
+            (int64_t)kernel::time_manager()->milliseconds() >= deadline_ms) {
+            break;
+        }
+
+        // Wait for an event in one of the files
+        if (!_waiter.wait_until(deadline_ms)) {
+            return error::interrupted;
+        }
+
+        ready = scan(false);
+    }
+
+    return (int64_t)ready;
+}
+
+size_t influx::vfs::poll_set::scan(bool listen) {
+    size_t ready = 0;
+    int64_t events = 0;
+
+    for (size_t i = 0; i < _count; i++) {
+        // Negative file descriptors are ignored
+        if (_requests[i].fd < 0) {
+            _requests[i].revents = 0;
+            continue;
+        }
+
+        // Get the events of the file, errors and hang ups are always reported
+        events = kernel::vfs()->poll((size_t)_requests[i].fd, listen ? &_listeners[i] : nullptr);
+        if (events < 0) {
+            _requests[i].revents = VFS_POLL_INVALID;
+        } else {
+            _requests[i].revents = (uint16_t)(events & (_requests[i].events | VFS_POLL_ERROR |
+                                                        VFS_POLL_HANG_UP));
+        }
+
+        if (_requests[i].revents != 0) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
\ No newline at end of file
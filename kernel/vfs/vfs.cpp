@@ -6,10 +6,16 @@
 #include <kernel/kernel.h>
 #include <kernel/threading/lock_guard.h>
 #include <kernel/threading/scheduler.h>
+#include <kernel/threading/shared_lock.h>
 #include <kernel/threading/unique_lock.h>
 #include <kernel/time/time_manager.h>
+#include <kernel/utils.h>
 
-influx::vfs::vfs::vfs() : _log("VFS", console_color::green) {}
+influx::vfs::vfs::vfs()
+    : _log("VFS", console_color::green),
+      _vnodes_table(DEFAULT_BUCKET_COUNT, VFS_INVALID_VNODE),
+      _vnodes_mutex("vfs vnodes"),
+      _released_vnodes(0) {}
 
 bool influx::vfs::vfs::mount(influx::vfs::fs_type type, influx::vfs::path mount_path,
                              influx::drivers::ata::drive_slice drive) {
@@ -54,6 +60,12 @@ bool influx::vfs::vfs::mount(influx::vfs::fs_type type, influx::vfs::path mount_
     return true;
 }
 
+void influx::vfs::vfs::start_flusher_thread() {
+    // Create the kernel thread that writes back the cached files
+    kernel::scheduler()->create_kernel_thread(
+        utils::method_function_wrapper<vfs, &vfs::flusher_thread>, this);
+}
+
 int64_t influx::vfs::vfs::open(const influx::vfs::path& file_path, influx::vfs::open_flags flags,
                                influx::vfs::file_permissions permissions) {
     filesystem* fs = get_fs_for_file(file_path);
@@ -78,17 +90,20 @@ int64_t influx::vfs::vfs::open(const influx::vfs::path& file_path, influx::vfs::
     }
 
     // If the file wasn't found in the filesystem
-    if ((fs_file_data = fs->get_fs_file_data(file_path)) == nullptr) {
+    if ((fs_file_data = _dentry_cache.lookup(fs, file_path)) == nullptr) {
         if (flags & open_flags::create &&
             (err = fs->create_file(file_path, permissions, &fs_file_data)) != error::success) {
             return err;
         } else if (!(flags & open_flags::create)) {
             return error::file_not_found;
         }
+
+        // Remove the negative entry of the new file
+        _dentry_cache.invalidate(fs, file_path);
     }
 
-    // Read file info from filesystem
-    if ((err = fs->get_file_info(fs_file_data, file)) != error::success) {
+    // Get the file info from its vnode or from the cache before reading it from the filesystem
+    if ((err = get_file_info_for_path(fs, file_path, fs_file_data, file)) != error::success) {
         delete (uint32_t*)fs_file_data;
         return err;
     }
@@ -118,6 +133,9 @@ int64_t influx::vfs::vfs::open(const influx::vfs::path& file_path, influx::vfs::
         return err;
     }
 
+    // The info of the file is kept in its vnode from now on
+    _dentry_cache.forget_file_info(fs, file_path);
+
     // If the file is already deleted
     if (vn.second->deleted) {
         delete (uint32_t*)fs_file_data;
@@ -131,45 +149,36 @@ int64_t influx::vfs::vfs::open(const influx::vfs::path& file_path, influx::vfs::
     vn.second->amount_of_open_files++;
 
     // Create the file descriptor and return it
-    return kernel::scheduler()->add_file_descriptor(open_file{
-        .vnode_index = vn.first, .position = 0, .flags = flags, .amount_of_file_descriptors = 1});
+    return kernel::scheduler()->add_file_descriptor(
+        new open_file(vn.first, &vn.second.get(), flags));
 }
 
 int64_t influx::vfs::vfs::close(size_t fd) {
-    open_file file;
-    error err;
-
-    // Try to get the open file object
-    if ((err = get_open_file_for_fd(fd, file)) != error::success) {
-        return err;
-    }
+    open_file* file = nullptr;
 
-    // Close the file
-    if (file.amount_of_file_descriptors == 1) {
-        close_open_file(file);
+    // Remove the file descriptor
+    if ((file = kernel::scheduler()->remove_file_descriptor(fd)) == nullptr) {
+        return error::invalid_file;
     }
 
-    // Remove the file descriptor
-    kernel::scheduler()->remove_file_descriptor(fd);
+    // Release its reference, the file is closed when nothing else uses it
+    release_open_file(file);
 
     return error::success;
 }
 
 int64_t influx::vfs::vfs::stat(size_t fd, influx::vfs::file_info& info) {
-    open_file file;
+    open_file_ref file;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
-
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return err;
     }
 
     // Get the file info
-    info = _vnodes[file.vnode_index].file;
-    vnodes_lk.unlock();
+    info = file->vn->file;
 
     return 0;
 }
@@ -186,12 +195,12 @@ int64_t influx::vfs::vfs::stat(const influx::vfs::path& file_path, influx::vfs::
     }
 
     // If the file wasn't found in the filesystem
-    if ((fs_file_data = fs->get_fs_file_data(file_path)) == nullptr) {
+    if ((fs_file_data = _dentry_cache.lookup(fs, file_path)) == nullptr) {
         return error::file_not_found;
     }
 
-    // Read file info from filesystem
-    err = fs->get_file_info(fs_file_data, info);
+    // Get the file info from its vnode or from the cache before reading it from the filesystem
+    err = get_file_info_for_path(fs, file_path, fs_file_data, info);
 
     // Delete the fs file data
     delete (uint32_t*)fs_file_data;
@@ -200,68 +209,79 @@ int64_t influx::vfs::vfs::stat(const influx::vfs::path& file_path, influx::vfs::
 }
 
 int64_t influx::vfs::vfs::seek(size_t fd, int64_t offset, influx::vfs::seek_type type) {
-    open_file file;
+    open_file_ref file;
     int64_t new_position = 0;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
-
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return err;
     }
 
     // Create a ref of the vnode
-    vnode& vn = _vnodes[file.vnode_index];
+    vnode& vn = *file->vn;
 
     // If the file is a pipe/FIFO or a socket˝
     if (vn.file.type == file_type::fifo || vn.file.type == file_type::socket) {
         return error::is_pipe;
     }
 
+    // Lock the position of the file
+    threading::lock_guard position_lk(file->position_mutex);
+
     // Offset from beginning of the file
     if (type == seek_type::set) {
         new_position = offset;
     } else if (type == seek_type::current)  // Offset from the current offset
     {
-        new_position = file.position + offset;
+        new_position = file->position + offset;
     } else if (type == seek_type::end) {
         new_position = vn.file.size + offset;
     }
 
-    // Unlock vnodes lock
-    vnodes_lk.unlock();
-
     // Check that the new position is valid
     if (new_position < 0) {
         return error::invalid_position;
     }
 
     // Set the new position
-    file.position = new_position;
-
-    // Save the file
-    kernel::scheduler()->update_file_descriptor(fd, file);
+    file->position = new_position;
 
     return new_position;
 }
 
-int64_t influx::vfs::vfs::read(size_t fd, void* buf, size_t count) {
-    open_file file;
-    size_t amount_read = 0;
+int64_t influx::vfs::vfs::read(size_t fd, void* buf, size_t count, int64_t offset) {
+    io_vector vector{.base = buf, .length = count};
+
+    return readv(fd, &vector, 1, offset);
+}
+
+int64_t influx::vfs::vfs::write(size_t fd, const void* buf, size_t count, int64_t offset) {
+    io_vector vector{.base = (void*)buf, .length = count};
+
+    return writev(fd, &vector, 1, offset);
+}
+
+int64_t influx::vfs::vfs::readv(size_t fd, const influx::vfs::io_vector* vectors,
+                                size_t vector_count, int64_t offset) {
+    open_file_ref file;
+    size_t count = 0, position = 0, amount_read = 0;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
+    // Calculate the total amount of bytes to read
+    for (size_t i = 0; i < vector_count; i++) {
+        count += vectors[i].length;
+    }
 
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return err;
     }
 
-    // Create a ref of the vnode
-    vnode& vn = _vnodes[file.vnode_index];
+    // Create a ref of the vnode, it's pinned while the file is open
+    vnode& vn = *file->vn;
 
     // Check if the file is a directory
     if (vn.file.type == file_type::directory) {
@@ -269,52 +289,74 @@ int64_t influx::vfs::vfs::read(size_t fd, void* buf, size_t count) {
     }
 
     // Check access for the file
-    if (!(file.flags & open_flags::read)) {
+    if (!(file->flags & open_flags::read)) {
         return error::invalid_file_access;
     }
 
-    // Lock the file mutex
-    vnodes_lk.unlock();
+    // Streams don't have a position to read from
+    if (offset != VFS_CURRENT_POSITION &&
+        (vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        return error::is_pipe;
+    }
+
+    // Lock the position of the file if it's used, then the file mutex
+    threading::unique_lock position_lk(file->position_mutex, threading::defer_lock);
+    if (offset == VFS_CURRENT_POSITION &&
+        !(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        position_lk.lock();
+    }
     threading::lock_guard file_lk(vn.file_mutex);
 
-    // Read the file
-    if ((err = vn.fs->read(
-             vn.fs_data, (char*)buf,
-             algorithm::min<size_t>(
-                 count, file.position > vn.file.size ? 0 : vn.file.size - file.position),
-             file.position, amount_read)) != error::success) {
+    // Read from the given offset or from the position of the file
+    position = offset == VFS_CURRENT_POSITION ? file->position : (size_t)offset;
+
+    // Don't read past the end of the file
+    count = algorithm::min<size_t>(count, position > vn.file.size ? 0 : vn.file.size - position);
+
+    // Read the file through the page cache if it can be cached
+    if ((err = vnode_cacheable(vn) ? _page_cache.read(vn, vectors, vector_count, count, position,
+                                                      amount_read, file->flags)
+                                   : vn.fs->readv(vn.fs_data, vectors, vector_count, count,
+                                                  position, amount_read, file->flags)) !=
+        error::success) {
         return err;
     }
 
-    // Update file position
-    if (!(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
-        file.position += amount_read;
-        kernel::scheduler()->update_file_descriptor(fd, file);
+    // Update file position if the file position was used
+    if (offset == VFS_CURRENT_POSITION &&
+        !(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        file->position += amount_read;
     }
 
-    // Update the file object
-    if ((err = vn.fs->get_file_info(vn.fs_data, vn.file)) != error::success) {
+    // Update the file object of files that bypass the cache, the page cache keeps the file object
+    // of cached files up to date
+    if (!vnode_cacheable(vn) &&
+        (err = vn.fs->get_file_info(vn.fs_data, vn.file)) != error::success) {
         return err;
     }
 
     return amount_read;
 }
 
-int64_t influx::vfs::vfs::write(size_t fd, const void* buf, size_t count) {
-    open_file file;
-    size_t amount_written = 0;
+int64_t influx::vfs::vfs::writev(size_t fd, const influx::vfs::io_vector* vectors,
+                                 size_t vector_count, int64_t offset) {
+    open_file_ref file;
+    size_t count = 0, position = 0, amount_written = 0;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
+    // Calculate the total amount of bytes to write
+    for (size_t i = 0; i < vector_count; i++) {
+        count += vectors[i].length;
+    }
 
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return err;
     }
 
-    // Create a ref of the vnode
-    vnode& vn = _vnodes[file.vnode_index];
+    // Create a ref of the vnode, it's pinned while the file is open
+    vnode& vn = *file->vn;
 
     // Check if the file is a directory
     if (vn.file.type == file_type::directory) {
@@ -322,40 +364,168 @@ int64_t influx::vfs::vfs::write(size_t fd, const void* buf, size_t count) {
     }
 
     // Check access for the file
-    if (!(file.flags & open_flags::write)) {
+    if (!(file->flags & open_flags::write)) {
         return error::invalid_file_access;
     }
 
-    // Lock the file mutex
-    vnodes_lk.unlock();
+    // Streams don't have a position to write to
+    if (offset != VFS_CURRENT_POSITION &&
+        (vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        return error::is_pipe;
+    }
+
+    // Lock the position of the file if it's used, then the file mutex
+    threading::unique_lock position_lk(file->position_mutex, threading::defer_lock);
+    if (offset == VFS_CURRENT_POSITION &&
+        !(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        position_lk.lock();
+    }
     threading::lock_guard file_lk(vn.file_mutex);
 
-    // Check append access for the file
-    if (file.flags & open_flags::append) {
+    // Check append access for the file, positional writes ignore it
+    if (offset == VFS_CURRENT_POSITION && file->flags & open_flags::append) {
         // Set position at the end of the file
-        file.position = vn.file.size;
+        file->position = vn.file.size;
     }
 
-    // Write to the file
-    if ((err = vn.fs->write(vn.fs_data, (const char*)buf, count, file.position, amount_written)) !=
+    // Write to the given offset or to the position of the file
+    position = offset == VFS_CURRENT_POSITION ? file->position : (size_t)offset;
+
+    // Write to the file through the page cache if it can be cached
+    if ((err = vnode_cacheable(vn) ? _page_cache.write(vn, vectors, vector_count, count, position,
+                                                       amount_written, file->flags)
+                                   : vn.fs->writev(vn.fs_data, vectors, vector_count, count,
+                                                   position, amount_written, file->flags)) !=
         error::success) {
         return err;
     }
 
-    // Update file position
-    if (!(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
-        file.position += amount_written;
-        kernel::scheduler()->update_file_descriptor(fd, file);
+    // Update file position if the file position was used
+    if (offset == VFS_CURRENT_POSITION &&
+        !(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
+        file->position += amount_written;
     }
 
-    // Update the file object
-    if ((err = vn.fs->get_file_info(vn.fs_data, vn.file)) != error::success) {
+    // Update the file object of files that bypass the cache, the page cache keeps the file object
+    // of cached files up to date
+    if (!vnode_cacheable(vn) &&
+        (err = vn.fs->get_file_info(vn.fs_data, vn.file)) != error::success) {
         return err;
     }
 
     return amount_written;
 }
 
+int64_t influx::vfs::vfs::splice(size_t in_fd, int64_t in_offset, size_t out_fd,
+                                 int64_t out_offset, size_t count) {
+    uint8_t* buffer = nullptr;
+    size_t chunk = 0, transferred = 0;
+    int64_t amount_read = 0, amount_written = 0;
+
+    // Check if there is anything to transfer
+    if (count == 0) {
+        return 0;
+    }
+
+    // The data only passes through a single kernel buffer that is reused for every chunk
+    buffer = new uint8_t[algorithm::min<size_t>(count, VFS_SPLICE_BUFFER_SIZE)];
+
+    while (transferred < count) {
+        chunk = algorithm::min<size_t>(count - transferred, VFS_SPLICE_BUFFER_SIZE);
+
+        // Read the next chunk from the input file
+        if ((amount_read = read(in_fd, buffer, chunk,
+                                in_offset == VFS_CURRENT_POSITION
+                                    ? VFS_CURRENT_POSITION
+                                    : in_offset + (int64_t)transferred)) <= 0) {
+            break;
+        }
+
+        // Write the chunk to the output file
+        amount_written = write(out_fd, buffer, (size_t)amount_read,
+                               out_offset == VFS_CURRENT_POSITION
+                                   ? VFS_CURRENT_POSITION
+                                   : out_offset + (int64_t)transferred);
+        if (amount_written > 0) {
+            transferred += (size_t)amount_written;
+        }
+
+        // Move the position of the input file back over the data that wasn't written so it won't
+        // be lost, the data of pipes can't be given back
+        if (in_offset == VFS_CURRENT_POSITION && amount_written < amount_read) {
+            seek(in_fd, -(amount_read - algorithm::max<int64_t>(amount_written, 0)),
+                 seek_type::current);
+        }
+
+        // Stop on a write error, when the input file has no more data available or when the output
+        // file is full
+        if (amount_written <= 0 || (size_t)amount_read < chunk || amount_written < amount_read) {
+            break;
+        }
+    }
+
+    delete[] buffer;
+
+    // Errors are only returned if nothing was transferred
+    if (transferred == 0 && amount_read < 0) {
+        return amount_read;
+    } else if (transferred == 0 && amount_written < 0) {
+        return amount_written;
+    }
+
+    return (int64_t)transferred;
+}
+
+int64_t influx::vfs::vfs::sync(size_t fd) {
+    open_file_ref file;
+
+    error err;
+
+    // Try to get the open file object
+    if ((err = get_open_file_for_fd(fd, file)) != error::success) {
+        return err;
+    }
+
+    // Create a ref of the vnode, it's pinned while the file is open
+    vnode& vn = *file->vn;
+
+    // Files that aren't cached are written directly to the filesystem
+    if (!vnode_cacheable(vn)) {
+        return error::success;
+    }
+
+    // Lock the file mutex
+    threading::lock_guard file_lk(vn.file_mutex);
+
+    // Write back the cached pages of the file
+    return _page_cache.flush(vn);
+}
+
+int64_t influx::vfs::vfs::poll(size_t fd, influx::vfs::poll_listener* listener) {
+    open_file_ref file;
+    uint16_t events = 0;
+
+    error err;
+
+    // Try to get the open file object
+    if ((err = get_open_file_for_fd(fd, file)) != error::success) {
+        return err;
+    }
+
+    // Get the events of the file, the file mutex isn't locked since blocking reads hold it
+    events = file->vn->fs->poll(file->vn->fs_data, listener);
+
+    // Only report the directions the file was opened for
+    if (!(file->flags & open_flags::read)) {
+        events &= (uint16_t)~VFS_POLL_IN;
+    }
+    if (!(file->flags & open_flags::write)) {
+        events &= (uint16_t)~VFS_POLL_OUT;
+    }
+
+    return events;
+}
+
 int64_t influx::vfs::vfs::mkdir(const path& dir_path, influx::vfs::file_permissions permissions) {
     filesystem* fs = get_fs_for_file(dir_path);
 
@@ -371,26 +541,27 @@ int64_t influx::vfs::vfs::mkdir(const path& dir_path, influx::vfs::file_permissi
         return err;
     }
 
+    // Remove the negative entry of the new directory
+    _dentry_cache.invalidate(fs, dir_path);
+
     return error::success;
 }
 
 int64_t influx::vfs::vfs::get_dir_entries(
     size_t fd, influx::structures::vector<influx::vfs::dir_entry>& entries,
     uint64_t dirent_buffer_size) {
-    open_file file;
+    open_file_ref file;
     size_t amount_read = 0;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
-
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return err;
     }
 
-    // Create a ref of the vnode
-    vnode& vn = _vnodes[file.vnode_index];
+    // Create a ref of the vnode, it's pinned while the file is open
+    vnode& vn = *file->vn;
 
     // Check if the file is a directory
     if (vn.file.type != file_type::directory) {
@@ -398,24 +569,23 @@ int64_t influx::vfs::vfs::get_dir_entries(
     }
 
     // Check access for the file
-    if (!(file.flags & open_flags::read)) {
+    if (!(file->flags & open_flags::read)) {
         return error::invalid_file_access;
     }
 
-    // Lock the file mutex
-    vnodes_lk.unlock();
+    // Lock the position of the file, then the file mutex
+    threading::lock_guard position_lk(file->position_mutex);
     threading::lock_guard file_lk(vn.file_mutex);
 
     // Read the directory's entries
-    if ((err = vn.fs->read_dir_entries(vn.fs_data, file.position, entries, dirent_buffer_size,
+    if ((err = vn.fs->read_dir_entries(vn.fs_data, file->position, entries, dirent_buffer_size,
                                        amount_read)) != error::success) {
         return err;
     }
 
     // Update file position
     if (!(vn.file.type == file_type::fifo || vn.file.type == file_type::socket)) {
-        file.position += amount_read;
-        kernel::scheduler()->update_file_descriptor(fd, file);
+        file->position += amount_read;
     }
 
     // Update the file object
@@ -441,10 +611,16 @@ int64_t influx::vfs::vfs::unlink(const influx::vfs::path& file_path) {
     }
 
     // Try to get the fs file data for the file
-    if ((fs_file_data = fs->get_fs_file_data(file_path)) == nullptr) {
+    if ((fs_file_data = _dentry_cache.lookup(fs, file_path)) == nullptr) {
         return error::file_not_found;
     }
 
+    // A closed file that is only kept for its cached pages can be released
+    if (get_vnode_for_file(fs, fs_file_data, vn) == error::success &&
+        vn.second->amount_of_open_files == 0) {
+        release_vnode(vn.first);
+    }
+
     // Check if the file is already open
     if (get_vnode_for_file(fs, fs_file_data, vn) == error::success) {
         // Verify that the file isn't a directory
@@ -468,31 +644,29 @@ int64_t influx::vfs::vfs::unlink(const influx::vfs::path& file_path) {
         if ((err = fs->unlink_file(file_path)) != error::success) {
             return err;
         }
+
+        // Remove the cached entry of the file
+        _dentry_cache.invalidate(fs, file_path);
     }
 
     return error::success;
 }
 
 influx::vfs::filesystem* influx::vfs::vfs::get_filesystem(size_t fd) {
-    open_file file;
+    open_file_ref file;
 
     error err;
 
-    threading::unique_lock vnodes_lk(_vnodes_mutex);
-
     // Try to get the open file object
     if ((err = get_open_file_for_fd(fd, file)) != error::success) {
         return nullptr;
     }
 
-    // Create a ref of the vnode
-    vnode& vn = _vnodes[file.vnode_index];
-
-    return vn.fs;
+    return file->vn->fs;
 }
 
 int64_t influx::vfs::vfs::get_vnode_index(size_t fd) {
-    open_file file;
+    open_file_ref file;
 
     error err;
 
@@ -501,16 +675,28 @@ int64_t influx::vfs::vfs::get_vnode_index(size_t fd) {
         return -1;
     }
 
-    return file.vnode_index;
+    return file->vnode_index;
 }
 
-void influx::vfs::vfs::fork_file_descriptors(
-    influx::structures::unique_hash_map<influx::vfs::open_file>& file_descriptors) {
-    threading::lock_guard lk(_vnodes_mutex);
+influx::vfs::error influx::vfs::vfs::get_open_file_for_fd(int64_t fd,
+                                                          influx::vfs::open_file_ref& file) {
+    open_file* open_file_ptr = nullptr;
+
+    error err;
+
+    // Take a reference of the open file so it will stay open while it's used
+    if ((err = kernel::scheduler()->get_file_descriptor(fd, open_file_ptr)) == error::success) {
+        file.reset(open_file_ptr);
+    }
 
-    // For each file descriptor, increase it's vnode open count
-    for (auto& file_descriptor_pair : file_descriptors) {
-        _vnodes[file_descriptor_pair.second.vnode_index].amount_of_open_files++;
+    return err;
+}
+
+void influx::vfs::vfs::release_open_file(influx::vfs::open_file* file) {
+    // Close the file when its last reference is released
+    if (__sync_sub_and_fetch(&file->references, 1) == 0) {
+        close_open_file(*file);
+        delete file;
     }
 }
 
@@ -518,24 +704,21 @@ uint64_t influx::vfs::vfs::dirent_size_for_dir_entry(influx::vfs::dir_entry& ent
     return sizeof(dirent) + entry.name.size() + 1;
 }
 
-influx::vfs::error influx::vfs::vfs::get_open_file_for_fd(int64_t fd,
-                                                          influx::vfs::open_file& file) {
-    return kernel::scheduler()->get_file_descriptor(fd, file);
-}
-
 influx::vfs::error influx::vfs::vfs::get_vnode_for_file(
     influx::vfs::filesystem* fs, void* fs_file_data,
     influx::structures::pair<uint64_t, influx::structures::reference_wrapper<influx::vfs::vnode>>&
         vn) {
     // vnodes mutex must be locked here
+    uint64_t key = vnode_key(fs, fs_file_data);
 
-    // For each vnode pair, check if it
-    for (auto& vnode_pair : _vnodes) {
+    // Search the vnodes in the chain of the key of the file
+    for (int64_t vnode_index = _vnodes_table.count(key) ? _vnodes_table[key] : VFS_INVALID_VNODE;
+         vnode_index != VFS_INVALID_VNODE; vnode_index = _vnodes[(uint64_t)vnode_index].hash_next) {
         // If the vnode fs file data matches return it's index
-        if (vnode_pair.second.fs == fs &&
-            fs->compare_fs_file_data(fs_file_data, vnode_pair.second.fs_data)) {
+        vnode& current = _vnodes[(uint64_t)vnode_index];
+        if (current.fs == fs && fs->compare_fs_file_data(fs_file_data, current.fs_data)) {
             vn = structures::pair<uint64_t, structures::reference_wrapper<vnode>>(
-                vnode_pair.first, _vnodes[vnode_pair.first]);
+                (uint64_t)vnode_index, current);
             return error::success;
         }
     }
@@ -551,12 +734,18 @@ influx::vfs::error influx::vfs::vfs::create_vnode_for_file(
 
     structures::pair<structures::unique_hash_map<vnode>::iterator, bool> vnode_pair(_vnodes.end(),
                                                                                     false);
+    uint64_t key = vnode_key(fs, fs_file_data);
 
     // Insert vnode
     if ((vnode_pair = _vnodes.emplace_unique(file, fs, fs_file_data)).second == false) {
         return error::unknown_error;
     }
 
+    // Add the vnode to the head of the chain of its key
+    (*vnode_pair.first).second.hash_next =
+        _vnodes_table.count(key) ? _vnodes_table[key] : VFS_INVALID_VNODE;
+    _vnodes_table[key] = (int64_t)(*vnode_pair.first).first;
+
     // Set return vnode
     vn = structures::pair<uint64_t, structures::reference_wrapper<vnode>>(
         (*vnode_pair.first).first, _vnodes[(*vnode_pair.first).first]);
@@ -565,7 +754,7 @@ influx::vfs::error influx::vfs::vfs::create_vnode_for_file(
 }
 
 influx::vfs::filesystem* influx::vfs::vfs::get_fs_for_file(const influx::vfs::path& file_path) {
-    threading::lock_guard lk(_mounts_mutex);
+    threading::shared_lock lk(_mounts_mutex);
 
     fs_mount best_fs_match{nullptr, ""};
 
@@ -583,27 +772,200 @@ influx::vfs::filesystem* influx::vfs::vfs::get_fs_for_file(const influx::vfs::pa
     return best_fs_match.fs;
 }
 
+influx::vfs::error influx::vfs::vfs::get_file_info_for_path(influx::vfs::filesystem* fs,
+                                                            const influx::vfs::path& file_path,
+                                                            void* fs_file_data,
+                                                            influx::vfs::file_info& file) {
+    structures::pair<uint64_t, structures::reference_wrapper<vnode>> vn(0, _vnodes.empty_item());
+    uint64_t released_vnodes = 0;
+    uint64_t generation = 0;
+
+    error err;
+
+    // Files of filesystems that aren't cached are always read from the filesystem
+    if (!fs->cacheable()) {
+        return fs->get_file_info(fs_file_data, file);
+    }
+
+    threading::unique_lock vnodes_lk(_vnodes_mutex);
+
+    // The vnode of the file has the latest info of the file, including cached writes to it
+    if (get_vnode_for_file(fs, fs_file_data, vn) == error::success) {
+        file = vn.second->file;
+        return error::success;
+    }
+
+    // Try to get the info that was cached with the entry of the file
+    if (_dentry_cache.get_file_info(fs, file_path, file, generation)) {
+        return error::success;
+    }
+
+    // Read the file info from the filesystem without holding the vnodes mutex
+    released_vnodes = _released_vnodes;
+    vnodes_lk.unlock();
+    if ((err = fs->get_file_info(fs_file_data, file)) != error::success) {
+        return err;
+    }
+    vnodes_lk.lock();
+
+    // Cache the info unless a vnode of the file was created or released meanwhile
+    if (get_vnode_for_file(fs, fs_file_data, vn) == error::vnode_not_found &&
+        released_vnodes == _released_vnodes) {
+        _dentry_cache.set_file_info(fs, file_path, file, generation);
+    }
+
+    return error::success;
+}
+
 void influx::vfs::vfs::close_open_file(const influx::vfs::open_file& file) {
     threading::unique_lock vnodes_lk(_vnodes_mutex);
 
     // Create a ref of the vnode
     vnode& vn = _vnodes[file.vnode_index];
+    threading::unique_lock file_lk(vn.file_mutex, threading::defer_lock);
 
     // Call filesystem close function
     vn.fs->close_open_file(file, vn.fs_data);
 
+    // Write back the file when its last open file is closed, the open file keeps the vnode pinned
+    // so the vnodes mutex isn't held during the disk IO
+    if (vn.amount_of_open_files == 1 && !vn.deleted && vnode_cacheable(vn)) {
+        vnodes_lk.unlock();
+        file_lk.lock();
+        if (_page_cache.flush(vn) != error::success) {
+            _log("Failed to write back the cached pages of vnode %d!\n", file.vnode_index);
+        }
+        file_lk.unlock();
+        vnodes_lk.lock();
+    }
+
     // Decrease the amount of open files for the file
-    vn.amount_of_open_files--;
-
-    // If there are no open files for the file, free it
-    if (vn.amount_of_open_files == 0) {
-        // Check if the file need to be deleted, unlink it
-        if (vn.deleted && _deleted_vnodes_paths.count(file.vnode_index) == 1) {
-            vn.fs->unlink_file(_deleted_vnodes_paths[file.vnode_index]);
-            _deleted_vnodes_paths.erase(file.vnode_index);
+    put_vnode(file.vnode_index);
+}
+
+void influx::vfs::vfs::put_vnode(uint64_t vnode_index) {
+    // vnodes mutex must be locked here
+
+    // Create a ref of the vnode
+    vnode& vn = _vnodes[vnode_index];
+
+    // If there are still open files for the file, keep it
+    if (--vn.amount_of_open_files != 0) {
+        return;
+    }
+
+    // Check if the file need to be deleted, unlink it
+    if (vn.deleted && _deleted_vnodes_paths.count(vnode_index) == 1) {
+        vn.fs->unlink_file(_deleted_vnodes_paths[vnode_index]);
+        _dentry_cache.invalidate(vn.fs, _deleted_vnodes_paths[vnode_index]);
+        _deleted_vnodes_paths.erase(vnode_index);
+    } else if (vnode_cacheable(vn) && !vn.pages.empty()) {
+        // The vnode is kept while it has cached pages so opening the file again will be served
+        // from memory
+        return;
+    }
+
+    // Release the vnode and its cached pages
+    release_vnode(vnode_index);
+}
+
+void influx::vfs::vfs::release_vnode(uint64_t vnode_index) {
+    // vnodes mutex must be locked here
+
+    // Create a ref of the vnode
+    vnode& vn = _vnodes[vnode_index];
+    uint64_t key = vnode_key(vn.fs, vn.fs_data);
+    int64_t prev_index = VFS_INVALID_VNODE;
+
+    // Remove the vnode from the chain of its key
+    if (_vnodes_table[key] == (int64_t)vnode_index) {
+        if (vn.hash_next != VFS_INVALID_VNODE) {
+            _vnodes_table[key] = vn.hash_next;
+        } else {
+            _vnodes_table.erase(key);
         }
+    } else {
+        for (prev_index = _vnodes_table[key];
+             _vnodes[(uint64_t)prev_index].hash_next != (int64_t)vnode_index;
+             prev_index = _vnodes[(uint64_t)prev_index].hash_next) {
+        }
+        _vnodes[(uint64_t)prev_index].hash_next = vn.hash_next;
+    }
 
-        // Erase the vnode object
-        _vnodes.erase(file.vnode_index);
+    // Drop the cached pages of the file
+    _page_cache.release(vn);
+
+    // Let the filesystem release it's data of the file
+    vn.fs->release_fs_file_data(vn.fs_data);
+
+    // Erase the vnode object
+    _vnodes.erase(vnode_index);
+    _released_vnodes++;
+}
+
+void influx::vfs::vfs::reap_cached_vnodes() {
+    // vnodes mutex must be locked here
+
+    structures::vector<uint64_t> vnode_indexes;
+
+    // Find the closed files that are kept without any cached pages
+    for (auto& vnode_pair : _vnodes) {
+        if (vnode_pair.second.amount_of_open_files == 0 && vnode_cacheable(vnode_pair.second) &&
+            vnode_pair.second.pages.empty()) {
+            vnode_indexes.push_back(vnode_pair.first);
+        }
+    }
+
+    // Release them
+    for (const auto& vnode_index : vnode_indexes) {
+        release_vnode(vnode_index);
+    }
+}
+
+void influx::vfs::vfs::flusher_thread() {
+    while (true) {
+        // Wait for the next write back
+        kernel::scheduler()->sleep(PAGE_CACHE_FLUSH_INTERVAL);
+
+        structures::vector<structures::pair<uint64_t, vnode*>> vnodes;
+
+        threading::unique_lock vnodes_lk(_vnodes_mutex);
+
+        // Release the closed files that all of their pages were evicted
+        reap_cached_vnodes();
+
+        // Pin every cached file so it won't be released while it's written back
+        for (auto& vnode_pair : _vnodes) {
+            if (vnode_cacheable(vnode_pair.second) && !vnode_pair.second.deleted &&
+                !vnode_pair.second.pages.empty()) {
+                vnode_pair.second.amount_of_open_files++;
+                vnodes.push_back(
+                    structures::pair<uint64_t, vnode*>(vnode_pair.first, &vnode_pair.second));
+            }
+        }
+        vnodes_lk.unlock();
+
+        // Write back the dirty pages of every cached file without blocking other files
+        for (const auto& vnode_pair : vnodes) {
+            threading::lock_guard file_lk(vnode_pair.second->file_mutex);
+            if (_page_cache.flush(*vnode_pair.second) != error::success) {
+                _log("Failed to write back the cached pages of vnode %d!\n", vnode_pair.first);
+            }
+        }
+
+        // Unpin the files
+        vnodes_lk.lock();
+        for (const auto& vnode_pair : vnodes) {
+            put_vnode(vnode_pair.first);
+        }
     }
+}
+
+bool influx::vfs::vfs::vnode_cacheable(const influx::vfs::vnode& vn) {
+    return vn.fs->cacheable() && vn.file.type == file_type::regular;
+}
+
+uint64_t influx::vfs::vfs::vnode_key(influx::vfs::filesystem* fs, void* fs_file_data) {
+    // Mix the filesystem into the key of the file in it
+    return fs->fs_file_data_key(fs_file_data) ^ ((uint64_t)fs * VFS_VNODE_KEY_MULTIPLIER);
 }
\ No newline at end of file